@@ -0,0 +1,76 @@
+#! /usr/bin/env python
+# -*- coding: utf-8 -*-
+
+#
+# This file is part of SPORE.
+#
+# Copyright (C) 2016, the SPORE team (see AUTHORS).
+#
+# SPORE is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# SPORE is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with SPORE.  If not, see <http://www.gnu.org/licenses/>.
+#
+# For more information see: https://github.com/IGITUGraz/spore-nest-module
+#
+
+"""
+Measures the time to create synaptic sampling connections with and without
+deferred registration of connectors at the synapse updater. By default 10^7
+connections are created between 3163 neurons (fixed indegree).
+
+usage: connect_benchmark.py [num_neurons] [indegree] [num_threads]
+"""
+
+import sys
+import time
+
+import nest
+
+
+def build(num_neurons, indegree, num_threads, deferred):
+    nest.ResetKernel()
+    nest.set_verbosity("M_WARNING")
+    nest.SetKernelStatus({"local_num_threads": num_threads})
+    nest.sli_func('InitSynapseUpdater', 100, 100)
+    nest.sli_func('SetSporeStatus', {"deferred_registration": deferred})
+
+    neurons = nest.Create("poisson_dbl_exp_neuron", num_neurons)
+
+    t_start = time.time()
+    nest.Connect(neurons, neurons, {"rule": "fixed_indegree", "indegree": indegree},
+                 {"model": "synaptic_sampling_rewardgradient_synapse"})
+    t_connect = time.time() - t_start
+
+    t_start = time.time()
+    nest.Simulate(1.0)
+    t_prepare = time.time() - t_start
+
+    status = nest.sli_func('GetSporeStatus')
+    return t_connect, t_prepare, status["num_connectors"]
+
+
+def main(argv):
+    num_neurons = int(argv[0]) if len(argv) > 0 else 3163
+    indegree = int(argv[1]) if len(argv) > 1 else 3163
+    num_threads = int(argv[2]) if len(argv) > 2 else 1
+
+    print("creating %d connections on %d threads" % (num_neurons * indegree, num_threads))
+
+    for deferred in (False, True):
+        t_connect, t_prepare, num_connectors = build(num_neurons, indegree, num_threads, deferred)
+        print("deferred_registration=%-5s connect: %8.2f s  first simulate: %8.2f s  connectors: %d" %
+              (deferred, t_connect, t_prepare, num_connectors))
+
+
+if __name__ == '__main__':
+    nest.Install("sporemodule")
+    main(sys.argv[1:])
@@ -0,0 +1,92 @@
+#! /usr/bin/env python
+# -*- coding: utf-8 -*-
+
+#
+# This file is part of SPORE.
+#
+# Copyright (C) 2016, the SPORE team (see AUTHORS).
+#
+# SPORE is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# SPORE is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with SPORE.  If not, see <http://www.gnu.org/licenses/>.
+#
+# For more information see: https://github.com/IGITUGraz/spore-nest-module
+#
+
+"""
+Measures the time to simulate synaptic sampling connections with synapses
+updated connector by connector and in the order of their targets. By default
+10^6 connections are simulated between 1000 neurons (fixed indegree).
+
+The benefit of target-ordered updates and of prefetching the traces of the
+next target depends on whether the traces fit into the last level cache,
+so it should be checked at 10^7 connections or more. Run one order at a
+time under perf to compare the cache misses of both orders, e.g.
+
+    perf stat -e LLC-load-misses,LLC-loads,task-clock \
+        python update_order_benchmark.py 10000 1000 1 1000 connector
+    perf stat -e LLC-load-misses,LLC-loads,task-clock \
+        python update_order_benchmark.py 10000 1000 1 1000 target
+
+The counts include network construction, which is the same for both orders.
+No such measurement has been recorded for this module yet.
+
+usage: update_order_benchmark.py [num_neurons] [indegree] [num_threads] [sim_time] [connector|target|both]
+"""
+
+import sys
+import time
+
+import nest
+
+
+def run(num_neurons, indegree, num_threads, sim_time, target_ordered):
+    nest.ResetKernel()
+    nest.set_verbosity("M_WARNING")
+    nest.SetKernelStatus({"local_num_threads": num_threads})
+    nest.sli_func('InitSynapseUpdater', 100, 100)
+    nest.sli_func('SetSporeStatus', {"target_ordered_updates": target_ordered})
+
+    neurons = nest.Create("poisson_dbl_exp_neuron", num_neurons)
+    nest.SetDefaults("synaptic_sampling_rewardgradient_synapse", {"reward_transmitter": neurons[0]})
+    nest.Connect(neurons, neurons, {"rule": "fixed_indegree", "indegree": indegree},
+                 {"model": "synaptic_sampling_rewardgradient_synapse"})
+
+    nest.Simulate(1.0)
+
+    t_start = time.time()
+    nest.Simulate(sim_time)
+    return time.time() - t_start
+
+
+def main(argv):
+    num_neurons = int(argv[0]) if len(argv) > 0 else 1000
+    indegree = int(argv[1]) if len(argv) > 1 else 1000
+    num_threads = int(argv[2]) if len(argv) > 2 else 1
+    sim_time = float(argv[3]) if len(argv) > 3 else 1000.0
+    order = argv[4] if len(argv) > 4 else "both"
+
+    orders = {"connector": (False,), "target": (True,), "both": (False, True)}
+    if order not in orders:
+        sys.exit("order must be 'connector', 'target' or 'both'")
+
+    print("simulating %d connections on %d threads for %.0f ms" %
+          (num_neurons * indegree, num_threads, sim_time))
+
+    for target_ordered in orders[order]:
+        t_simulate = run(num_neurons, indegree, num_threads, sim_time, target_ordered)
+        print("target_ordered_updates=%-5s simulate: %8.2f s" % (target_ordered, t_simulate))
+
+
+if __name__ == '__main__':
+    nest.Install("sporemodule")
+    main(sys.argv[1:])
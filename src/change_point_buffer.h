@@ -0,0 +1,349 @@
+/*
+ * This file is part of SPORE.
+ *
+ * Copyright (C) 2016, the SPORE team (see AUTHORS).
+ *
+ * SPORE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * SPORE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SPORE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * For more information see: https://github.com/IGITUGraz/spore-nest-module
+ *
+ * File:   change_point_buffer.h
+ * Author: Kappel
+ *
+ * Created on October 18, 2026
+ */
+
+#ifndef CHANGE_POINT_BUFFER_H
+#define CHANGE_POINT_BUFFER_H
+
+#include <cassert>
+#include <limits>
+
+
+namespace spore
+{
+
+/**
+ * @brief A buffer for piecewise constant traces.
+ *
+ * Instead of storing one value per time step, this buffer stores runs of
+ * constant values as (step, value) pairs. A run starts at the given step and
+ * holds until the next run starts. Runs are kept in a ring of fixed capacity.
+ * If the capacity is at least the length of the trace window, the oldest run
+ * that is still inside the window is never overwritten, since every run
+ * covers at least one time step.
+ *
+ * The const_iterator of this class can be used as a drop-in replacement
+ * for CircularBuffer::const_iterator. In addition, get_run_length() allows
+ * readers to process constant stretches of the trace at once.
+ *
+ * The buffer supports a single writer and concurrent readers, as long as
+ * readers only access time steps before the first step that is currently
+ * written. New runs are published only after they have been completely
+ * written.
+ *
+ * @note Values must be written with non-decreasing time steps.
+ */
+template<typename T>
+class ChangePointBuffer
+{
+public:
+
+    /**
+     * @brief Constant iterator class.
+     */
+    class const_iterator
+    {
+    public:
+
+        /**
+         * Copy constructor.
+         */
+        const_iterator(const const_iterator& src)
+        : buffer_(src.buffer_),
+        step_(src.step_),
+        run_(src.run_)
+        {
+        }
+
+        /**
+         * Iterator increment. Moves to the next time step.
+         */
+        inline
+        const_iterator& operator++()
+        {
+            ++step_;
+            if (run_ != buffer_->newest_ && step_ >= buffer_->starts_[buffer_->next(run_)])
+                run_ = buffer_->next(run_);
+            return *this;
+        }
+
+        /**
+         * Iterator decrement. Moves to the previous time step.
+         */
+        inline
+        const_iterator& operator--()
+        {
+            --step_;
+            if (run_ != buffer_->oldest_ && step_ < buffer_->starts_[run_])
+                run_ = buffer_->prev(run_);
+            return *this;
+        }
+
+        /**
+         * Advance the iterator by \a n time steps.
+         */
+        inline
+        void advance(long n)
+        {
+            step_ += n;
+            while (run_ != buffer_->newest_ && step_ >= buffer_->starts_[buffer_->next(run_)])
+                run_ = buffer_->next(run_);
+        }
+
+        /**
+         * Iterator dereferencing operator. Returns a constant reference
+         * to the value of the current run.
+         */
+        inline
+        T const& operator*() const
+        {
+            return buffer_->values_[run_];
+        }
+
+        /**
+         * @return the number of time steps, starting at the current one,
+         * for which the value stays constant. For the most recent run
+         * the largest representable value is returned.
+         */
+        inline
+        long get_run_length() const
+        {
+            if (run_ == buffer_->newest_)
+                return std::numeric_limits<long>::max();
+            return buffer_->starts_[buffer_->next(run_)] - step_;
+        }
+
+    private:
+        friend class ChangePointBuffer;
+
+        /**
+         * Constructor.
+         */
+        const_iterator(const ChangePointBuffer* buffer, long step, size_t run)
+        : buffer_(buffer),
+        step_(step),
+        run_(run)
+        {
+        }
+
+        const ChangePointBuffer* buffer_;
+        long step_;
+        size_t run_;
+    };
+
+    /**
+     * Default constructor.
+     */
+    ChangePointBuffer()
+    : starts_(0),
+    values_(0),
+    capacity_(0),
+    oldest_(0),
+    newest_(0)
+    {
+    }
+
+    /**
+     * Copy constructor.
+     */
+    ChangePointBuffer(const ChangePointBuffer& src)
+    : starts_(0),
+    values_(0),
+    capacity_(0),
+    oldest_(0),
+    newest_(0)
+    {
+        assign(src);
+    }
+
+    /**
+     * Destructor.
+     */
+    ~ChangePointBuffer()
+    {
+        delete[] starts_;
+        delete[] values_;
+    }
+
+    /**
+     * Assignment operator.
+     */
+    ChangePointBuffer& operator=(const ChangePointBuffer& src)
+    {
+        if (this != &src)
+            assign(src);
+        return *this;
+    }
+
+    /**
+     * Change the capacity of the buffer to \a max_runs runs. All its content
+     * gets erased and the whole trace is set to v.
+     */
+    void resize(size_t max_runs, T v)
+    {
+        delete[] starts_;
+        delete[] values_;
+        starts_ = 0;
+        values_ = 0;
+        capacity_ = max_runs;
+        if (max_runs > 0)
+        {
+            starts_ = new long[max_runs];
+            values_ = new T[max_runs];
+        }
+        clear(v);
+    }
+
+    /**
+     * Erase all runs and set the whole trace to v.
+     */
+    void clear(T v)
+    {
+        assert(capacity_ > 0);
+        oldest_ = 0;
+        newest_ = 0;
+        starts_[0] = std::numeric_limits<long>::min();
+        values_[0] = v;
+    }
+
+    /**
+     * Set the trace to value v from time step \a step onwards. A new run is
+     * only created if the value changes.
+     */
+    void set(long step, T v)
+    {
+        assert(step >= starts_[newest_]);
+        if (values_[newest_] == v)
+            return;
+
+        if (step == starts_[newest_])
+        {
+            // overwrite the run that starts at the same step
+            values_[newest_] = v;
+            return;
+        }
+
+        const size_t slot = next(newest_);
+        if (slot == oldest_)
+        {
+            // the ring is full, drop the oldest run first
+            oldest_ = next(oldest_);
+        }
+        starts_[slot] = step;
+        values_[slot] = v;
+
+        // publish the run only after it was written
+        __sync_synchronize();
+        newest_ = slot;
+    }
+
+    /**
+     * Returns a constant iterator to read from the buffer at the given
+     * time step. Time steps before the oldest run read the oldest value.
+     */
+    const_iterator get(long step) const
+    {
+        assert(capacity_ > 0);
+        // read the newest run first, the writer drops old runs before
+        // publishing new ones.
+        const size_t last = newest_;
+        __sync_synchronize();
+        const size_t first = oldest_;
+
+        // binary search for the last run that starts at or before step
+        size_t lo = 0;
+        size_t hi = (last + capacity_ - first) % capacity_;
+        while (lo < hi)
+        {
+            const size_t mid = (lo + hi + 1) / 2;
+            if (starts_[(first + mid) % capacity_] <= step)
+                lo = mid;
+            else
+                hi = mid - 1;
+        }
+        return const_iterator(this, step, (first + lo) % capacity_);
+    }
+
+    /**
+     * Returns the number of runs that are currently stored.
+     */
+    size_t size() const
+    {
+        return (newest_ + capacity_ - oldest_) % capacity_ + 1;
+    }
+
+    /**
+     * Returns the maximum number of runs that can be stored.
+     */
+    size_t capacity() const
+    {
+        return capacity_;
+    }
+
+private:
+
+    inline
+    size_t next(size_t run) const
+    {
+        return (run + 1 == capacity_) ? 0 : run + 1;
+    }
+
+    inline
+    size_t prev(size_t run) const
+    {
+        return (run == 0) ? capacity_ - 1 : run - 1;
+    }
+
+    void assign(const ChangePointBuffer& src)
+    {
+        delete[] starts_;
+        delete[] values_;
+        starts_ = 0;
+        values_ = 0;
+        capacity_ = src.capacity_;
+        oldest_ = src.oldest_;
+        newest_ = src.newest_;
+        if (capacity_ > 0)
+        {
+            starts_ = new long[capacity_];
+            values_ = new T[capacity_];
+            for (size_t i = 0; i < capacity_; i++)
+            {
+                starts_[i] = src.starts_[i];
+                values_[i] = src.values_[i];
+            }
+        }
+    }
+
+    long* starts_;
+    T* values_;
+    size_t capacity_;
+    volatile size_t oldest_;
+    volatile size_t newest_;
+};
+
+}
+
+#endif /* CHANGE_POINT_BUFFER_H */
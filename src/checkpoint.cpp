@@ -0,0 +1,549 @@
+/*
+ * This file is part of SPORE.
+ *
+ * Copyright (C) 2016, the SPORE team (see AUTHORS).
+ *
+ * SPORE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * SPORE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SPORE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * For more information see: https://github.com/IGITUGraz/spore-nest-module
+ *
+ * File:   checkpoint.cpp
+ * Author: Kappel
+ *
+ * Created on October 18, 2026
+ */
+
+#include "checkpoint.h"
+#include "tracing_node.h"
+#include "spore_names.h"
+
+#include "exceptions.h"
+#include "dictutils.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+
+
+namespace spore
+{
+
+static const char checkpoint_magic[8] = { 'S', 'P', 'O', 'R', 'E', 'C', 'K', 'P' };
+
+const uint32_t SporeCheckpoint::version;
+const size_t SporeCheckpoint::page_size;
+
+std::vector<SporeCheckpoint::ConnectionType> SporeCheckpoint::connection_types_;
+
+/**
+ * @brief Memory mapping of a checkpoint file that is released on destruction.
+ */
+class CheckpointMapping
+{
+public:
+    CheckpointMapping()
+    : fd_(-1),
+    mem_(0),
+    size_(0)
+    {
+    }
+
+    ~CheckpointMapping()
+    {
+        if (mem_)
+        {
+            munmap(mem_, size_);
+        }
+        if (fd_ >= 0)
+        {
+            close(fd_);
+        }
+    }
+
+    /**
+     * Create the file \a file_name of \a size bytes and map it for writing.
+     */
+    void create(const std::string& file_name, size_t size)
+    {
+        fd_ = open(file_name.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd_ < 0)
+        {
+            throw nest::BadProperty(String::compose("SaveSporeCheckpoint: can not create file '%1': %2",
+                                                    file_name, strerror(errno)));
+        }
+        if (ftruncate(fd_, size) != 0)
+        {
+            throw nest::BadProperty(String::compose("SaveSporeCheckpoint: can not resize file '%1': %2",
+                                                    file_name, strerror(errno)));
+        }
+        map(file_name, size, PROT_READ | PROT_WRITE);
+    }
+
+    /**
+     * Map the existing file \a file_name for reading.
+     */
+    void open_existing(const std::string& file_name)
+    {
+        fd_ = open(file_name.c_str(), O_RDONLY);
+        struct stat st;
+        if (fd_ < 0 || fstat(fd_, &st) != 0)
+        {
+            throw nest::BadProperty(String::compose("LoadSporeCheckpoint: can not open file '%1': %2",
+                                                    file_name, strerror(errno)));
+        }
+        if (static_cast<size_t>(st.st_size) < sizeof (CheckpointHeader))
+        {
+            throw nest::BadProperty(String::compose("LoadSporeCheckpoint: '%1' is not a SPORE checkpoint.",
+                                                    file_name));
+        }
+        map(file_name, st.st_size, PROT_READ);
+    }
+
+    /**
+     * Write all changes to the file.
+     */
+    void sync()
+    {
+        msync(mem_, size_, MS_SYNC);
+    }
+
+    char* get_memory() const
+    {
+        return mem_;
+    }
+
+    size_t get_size() const
+    {
+        return size_;
+    }
+
+private:
+    void map(const std::string& file_name, size_t size, int protection)
+    {
+        void* mem = mmap(0, size, protection, MAP_SHARED, fd_, 0);
+        if (mem == MAP_FAILED)
+        {
+            throw nest::BadProperty(String::compose("SporeCheckpoint: can not map file '%1': %2",
+                                                    file_name, strerror(errno)));
+        }
+        mem_ = static_cast<char*>(mem);
+        size_ = size;
+    }
+
+    int fd_;
+    char* mem_;
+    size_t size_;
+};
+
+/**
+ * @return the size of a node record.
+ */
+static size_t node_record_size(size_t n_state, size_t n_traces, size_t trace_length)
+{
+    return sizeof (CheckpointNode) + (n_state + n_traces * trace_length) * sizeof (double);
+}
+
+/**
+ * @return \a size rounded up to a multiple of SporeCheckpoint::page_size.
+ */
+static size_t page_align(size_t size)
+{
+    return (size + SporeCheckpoint::page_size - 1) / SporeCheckpoint::page_size * SporeCheckpoint::page_size;
+}
+
+/**
+ * @return the registered connection type of model \a syn_id or 0 if it is not registered.
+ */
+const SporeCheckpoint::ConnectionType* SporeCheckpoint::get_connection_type(nest::synindex syn_id)
+{
+    for (size_t i = 0; i < connection_types_.size(); i++)
+    {
+        if (connection_types_[i].is_model(syn_id))
+        {
+            return &connection_types_[i];
+        }
+    }
+    return 0;
+}
+
+/**
+ * Write the state of all local synapses of registered connection types and
+ * of all local tracing nodes to a checkpoint file. Sections are sized in a
+ * first parallel pass and written in a second one. This function must not
+ * be called while connections are created or simulated. Dormant synapses
+ * are not part of the file format, networks that contain them can not be
+ * saved.
+ *
+ * @param file_name name of the checkpoint file.
+ * @param d dictionary to retrieve the number of written synapses and nodes.
+ */
+void SporeCheckpoint::save(const std::string& file_name, DictionaryDatum& d)
+{
+    const size_t num_dormant = ConnectionUpdateManager::instance()->get_num_dormant();
+    if (num_dormant > 0)
+    {
+        throw nest::BadProperty(String::compose("SaveSporeCheckpoint: the network contains %1 dormant "
+                                                "synapses, which can not be saved.", num_dormant));
+    }
+
+    const size_t num_threads = nest::kernel().vp_manager.get_num_threads();
+    const size_t trace_length = ConnectionUpdateManager::instance()->get_max_latency();
+    const nest::Time horizon = ConnectionUpdateManager::instance()->get_horizon();
+
+    std::vector<nest::synindex> models;
+    std::vector<const ConnectionType*> types;
+    for (size_t syn_id = 0; syn_id < nest::kernel().model_manager.get_num_synapse_prototypes(); syn_id++)
+    {
+        const ConnectionType* type = get_connection_type(syn_id);
+        if (type)
+        {
+            models.push_back(syn_id);
+            types.push_back(type);
+        }
+    }
+
+    // synapse sections of model m at m * num_threads + th, node sections last.
+    const size_t node_sections = models.size() * num_threads;
+    std::vector<CheckpointSection> sections((models.size() + 1) * num_threads);
+    memset(&sections[0], 0, sections.size() * sizeof (CheckpointSection));
+
+    std::vector< std::vector<TracingNode*> > nodes(num_threads);
+    std::vector< std::vector< std::vector<double> > > states(num_threads);
+
+#pragma omp parallel
+    {
+        const nest::thread th = nest::kernel().vp_manager.get_thread_id();
+
+        for (size_t m = 0; m < models.size(); m++)
+        {
+            CheckpointSection& section = sections[m * num_threads + th];
+            section.kind = synapses;
+            section.thread = th;
+            section.count = types[m]->count(models[m], th);
+            section.size = section.count * sizeof (CheckpointSynapse);
+            strncpy(section.name,
+                    nest::kernel().model_manager.get_synapse_prototype(models[m]).get_name().c_str(),
+                    sizeof (section.name) - 1);
+        }
+
+        CheckpointSection& section = sections[node_sections + th];
+        section.kind = SporeCheckpoint::nodes;
+        section.thread = th;
+        for (nest::index gid = 1; gid < nest::kernel().node_manager.size(); gid++)
+        {
+            nest::Node* node = nest::kernel().node_manager.get_node(gid, th);
+            TracingNode* tracing_node = dynamic_cast<TracingNode*>(node);
+            if (tracing_node == 0 || !nest::kernel().node_manager.is_local_node(node) || node->get_thread() != th)
+            {
+                continue;
+            }
+            nodes[th].push_back(tracing_node);
+            states[th].push_back(std::vector<double>());
+            tracing_node->get_checkpoint_state(states[th].back());
+            section.size += node_record_size(states[th].back().size(), tracing_node->get_num_traces(),
+                                             trace_length);
+        }
+        section.count = nodes[th].size();
+    }
+
+    size_t offset = page_align(sizeof (CheckpointHeader) + sections.size() * sizeof (CheckpointSection));
+    for (size_t s = 0; s < sections.size(); s++)
+    {
+        sections[s].offset = offset;
+        offset += page_align(sections[s].size);
+    }
+
+    CheckpointMapping file;
+    file.create(file_name, offset);
+    char* mem = file.get_memory();
+
+#pragma omp parallel
+    {
+        const nest::thread th = nest::kernel().vp_manager.get_thread_id();
+
+        for (size_t m = 0; m < models.size(); m++)
+        {
+            const CheckpointSection& section = sections[m * num_threads + th];
+            types[m]->save(models[m], th, reinterpret_cast<CheckpointSynapse*>(mem + section.offset));
+        }
+
+        char* record = mem + sections[node_sections + th].offset;
+        for (size_t n = 0; n < nodes[th].size(); n++)
+        {
+            const TracingNode& node = *nodes[th][n];
+            const std::vector<double>& state = states[th][n];
+
+            CheckpointNode& header = *reinterpret_cast<CheckpointNode*>(record);
+            header.gid = node.get_gid();
+            header.n_state = state.size();
+            header.n_traces = node.get_num_traces();
+            header.trace_length = trace_length;
+            header.piecewise = node.has_piecewise_constant_traces() ? 1 : 0;
+
+            double* values = reinterpret_cast<double*>(record + sizeof (CheckpointNode));
+            std::copy(state.begin(), state.end(), values);
+            values += state.size();
+            for (size_t trace_id = 0; trace_id < node.get_num_traces(); trace_id++)
+            {
+                node.copy_trace(trace_id, horizon.get_steps(), trace_length, values);
+                values += trace_length;
+            }
+
+            record += node_record_size(header.n_state, header.n_traces, trace_length);
+        }
+    }
+
+    CheckpointHeader& header = *reinterpret_cast<CheckpointHeader*>(mem);
+    memcpy(header.magic, checkpoint_magic, sizeof (checkpoint_magic));
+    header.version = version;
+    header.num_threads = num_threads;
+    header.n_sections = sections.size();
+    header.time = ConnectionUpdateManager::instance()->get_origin().get_ms();
+    header.resolution = nest::Time::get_resolution().get_ms();
+    header.trace_length = trace_length;
+    memcpy(mem + sizeof (CheckpointHeader), &sections[0], sections.size() * sizeof (CheckpointSection));
+    file.sync();
+
+    size_t n_synapses = 0;
+    size_t n_nodes = 0;
+    for (size_t s = 0; s < sections.size(); s++)
+    {
+        (sections[s].kind == synapses ? n_synapses : n_nodes) += sections[s].count;
+    }
+    def<long>(d, names::synapses, n_synapses);
+    def<long>(d, names::nodes, n_nodes);
+}
+
+/**
+ * Restore the state of synapses and tracing nodes from a checkpoint file.
+ * Connections of synapse models that have no local connections are
+ * created. This function must not be called while connections are created
+ * or simulated.
+ *
+ * @param file_name name of the checkpoint file.
+ * @param d dictionary to retrieve the number of restored synapses, created
+ *          synapses, nodes and traces.
+ */
+void SporeCheckpoint::load(const std::string& file_name, DictionaryDatum& d)
+{
+    const size_t num_threads = nest::kernel().vp_manager.get_num_threads();
+    const nest::index max_gid = nest::kernel().node_manager.size();
+
+    CheckpointMapping file;
+    file.open_existing(file_name);
+    const char* mem = file.get_memory();
+
+    const CheckpointHeader& header = *reinterpret_cast<const CheckpointHeader*>(mem);
+    if (memcmp(header.magic, checkpoint_magic, sizeof (checkpoint_magic)) != 0)
+    {
+        throw nest::BadProperty(String::compose("LoadSporeCheckpoint: '%1' is not a SPORE checkpoint.",
+                                                file_name));
+    }
+    if (header.version != version)
+    {
+        throw nest::BadProperty(String::compose("LoadSporeCheckpoint: '%1' has an unsupported format version %2.",
+                                                file_name, header.version));
+    }
+    if (sizeof (CheckpointHeader) + header.n_sections * sizeof (CheckpointSection) > file.get_size())
+    {
+        throw nest::BadProperty(String::compose("LoadSporeCheckpoint: '%1' is truncated.", file_name));
+    }
+
+    const CheckpointSection* sections = reinterpret_cast<const CheckpointSection*>(mem + sizeof (CheckpointHeader));
+
+    // collect the synapse sections by model and the node records.
+    std::vector<std::string> model_names;
+    std::map< std::string, std::vector<SynapseRecords> > model_sections;
+    std::vector<const CheckpointNode*> node_records;
+
+    for (size_t s = 0; s < header.n_sections; s++)
+    {
+        const CheckpointSection& section = sections[s];
+        if (section.offset + section.size > file.get_size())
+        {
+            throw nest::BadProperty(String::compose("LoadSporeCheckpoint: '%1' is truncated.", file_name));
+        }
+
+        if (section.kind == synapses)
+        {
+            if (section.count * sizeof (CheckpointSynapse) != section.size)
+            {
+                throw nest::BadProperty(String::compose("LoadSporeCheckpoint: invalid section %1 in '%2'.",
+                                                        s, file_name));
+            }
+
+            const std::string name(section.name, strnlen(section.name, sizeof (section.name)));
+            if (model_sections.find(name) == model_sections.end())
+            {
+                model_names.push_back(name);
+            }
+
+            SynapseRecords records;
+            records.records_ = reinterpret_cast<const CheckpointSynapse*>(mem + section.offset);
+            records.count_ = section.count;
+            records.thread_ = section.thread;
+            model_sections[name].push_back(records);
+
+            for (size_t k = 0; k < records.count_; k++)
+            {
+                if (records.records_[k].source >= max_gid || records.records_[k].target >= max_gid)
+                {
+                    throw nest::BadProperty(String::compose("LoadSporeCheckpoint: connection from %1 to %2 "
+                                                            "refers to a node that does not exist.",
+                                                            records.records_[k].source,
+                                                            records.records_[k].target));
+                }
+            }
+        }
+        else if (section.kind == nodes)
+        {
+            const char* record = mem + section.offset;
+            const char* end = record + section.size;
+            for (size_t n = 0; n < section.count; n++)
+            {
+                const CheckpointNode& node = *reinterpret_cast<const CheckpointNode*>(record);
+                if (record + sizeof (CheckpointNode) > end ||
+                    record + node_record_size(node.n_state, node.n_traces, node.trace_length) > end)
+                {
+                    throw nest::BadProperty(String::compose("LoadSporeCheckpoint: invalid section %1 in '%2'.",
+                                                            s, file_name));
+                }
+                node_records.push_back(&node);
+                record += node_record_size(node.n_state, node.n_traces, node.trace_length);
+            }
+        }
+    }
+
+    size_t n_synapses = 0;
+    size_t n_created = 0;
+
+    for (size_t m = 0; m < model_names.size(); m++)
+    {
+        const std::string& name = model_names[m];
+        const Token synmodel = nest::kernel().model_manager.get_synapsedict()->lookup(name);
+        const ConnectionType* type = synmodel.empty() ? 0 : get_connection_type(static_cast<size_t>(synmodel));
+        if (type == 0)
+        {
+            throw nest::BadProperty(String::compose("LoadSporeCheckpoint: synapse model '%1' does not exist "
+                                                    "or does not support checkpoints.", name));
+        }
+        const nest::synindex syn_id = static_cast<size_t>(synmodel);
+
+        size_t existing = 0;
+        for (size_t th = 0; th < num_threads; th++)
+        {
+            existing += type->count(syn_id, th);
+        }
+
+        const bool in_place = (existing > 0);
+        if (in_place && header.num_threads != num_threads)
+        {
+            throw nest::BadProperty(String::compose("LoadSporeCheckpoint: connections of '%1' exist, which "
+                                                    "requires the number of threads of the checkpoint (%2).",
+                                                    name, header.num_threads));
+        }
+
+        const std::vector<SynapseRecords>& records = model_sections[name];
+        std::vector<std::string> errors(num_threads);
+        std::vector<size_t> restored(num_threads, 0);
+
+#pragma omp parallel
+        {
+            const nest::thread th = nest::kernel().vp_manager.get_thread_id();
+            restored[th] = type->restore(syn_id, th, records, in_place, errors);
+        }
+
+        for (size_t th = 0; th < num_threads; th++)
+        {
+            if (!errors[th].empty())
+            {
+                throw nest::BadProperty(String::compose("LoadSporeCheckpoint: model '%1': %2", name, errors[th]));
+            }
+            n_synapses += restored[th];
+            if (!in_place)
+            {
+                n_created += restored[th];
+            }
+        }
+    }
+
+    // trace windows can only be restored at the time of the checkpoint.
+    const size_t trace_length = ConnectionUpdateManager::instance()->get_max_latency();
+    const nest::Time horizon = ConnectionUpdateManager::instance()->get_horizon();
+    const bool same_time = std::abs(ConnectionUpdateManager::instance()->get_origin().get_ms() - header.time) <
+                           0.5 * nest::Time::get_resolution().get_ms();
+
+    std::vector<size_t> restored_nodes(num_threads, 0);
+    std::vector<size_t> restored_traces(num_threads, 0);
+
+#pragma omp parallel
+    {
+        const nest::thread th = nest::kernel().vp_manager.get_thread_id();
+
+        for (size_t n = 0; n < node_records.size(); n++)
+        {
+            const CheckpointNode& record = *node_records[n];
+            if (record.gid == 0 || record.gid >= max_gid)
+            {
+                continue;
+            }
+
+            nest::Node* node = nest::kernel().node_manager.get_node(record.gid, th);
+            TracingNode* tracing_node = dynamic_cast<TracingNode*>(node);
+            if (tracing_node == 0 || !nest::kernel().node_manager.is_local_node(node) || node->get_thread() != th)
+            {
+                continue;
+            }
+
+            const double* values = reinterpret_cast<const double*>(reinterpret_cast<const char*>(&record) +
+                                                                   sizeof (CheckpointNode));
+            tracing_node->set_checkpoint_state(std::vector<double>(values, values + record.n_state));
+            values += record.n_state;
+            restored_nodes[th]++;
+
+            if (same_time && record.piecewise == 0 && record.trace_length == trace_length &&
+                !tracing_node->has_piecewise_constant_traces() &&
+                record.n_traces == tracing_node->get_num_traces())
+            {
+                for (size_t trace_id = 0; trace_id < record.n_traces; trace_id++)
+                {
+                    tracing_node->restore_trace(trace_id, horizon.get_steps(), trace_length,
+                                                values + trace_id * trace_length);
+                }
+                restored_traces[th] += record.n_traces;
+            }
+        }
+    }
+
+    size_t n_nodes = 0;
+    size_t n_traces = 0;
+    for (size_t th = 0; th < num_threads; th++)
+    {
+        n_nodes += restored_nodes[th];
+        n_traces += restored_traces[th];
+    }
+
+    def<long>(d, names::synapses, n_synapses);
+    def<long>(d, names::created, n_created);
+    def<long>(d, names::nodes, n_nodes);
+    def<long>(d, names::traces, n_traces);
+}
+
+}
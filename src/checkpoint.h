@@ -0,0 +1,396 @@
+/*
+ * This file is part of SPORE.
+ *
+ * Copyright (C) 2016, the SPORE team (see AUTHORS).
+ *
+ * SPORE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * SPORE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SPORE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * For more information see: https://github.com/IGITUGraz/spore-nest-module
+ *
+ * File:   checkpoint.h
+ * Author: Kappel
+ *
+ * Created on October 18, 2026
+ */
+
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <utility>
+#include <exception>
+
+#include <stdint.h>
+
+#include "nest.h"
+#include "dictdatum.h"
+#include "compose.hpp"
+#include "connector_model_impl.h"
+#include "kernel_manager.h"
+
+#include "connection_updater.h"
+#include "diligent_connector_model.h"
+
+
+namespace spore
+{
+
+/**
+ * @brief Header of a checkpoint file written by SporeCheckpoint.
+ *
+ * The header is followed by a table of \a n_sections entries of type
+ * CheckpointSection. The data sections start at multiples of
+ * SporeCheckpoint::page_size after the table.
+ */
+struct CheckpointHeader
+{
+    char magic[8]; //!< must be "SPORECKP"
+    uint32_t version; //!< layout version, must be SporeCheckpoint::version
+    uint32_t num_threads; //!< number of threads of the kernel that wrote the file
+    uint64_t n_sections; //!< number of entries of the section table
+    double time; //!< slice origin at the time of the checkpoint [ms]
+    double resolution; //!< simulation resolution [ms]
+    uint64_t trace_length; //!< length of the trace windows [steps]
+    uint64_t reserved[2];
+};
+
+/**
+ * @brief Entry of the section table of a checkpoint file.
+ *
+ * Synapse sections hold \a count records of type CheckpointSynapse of the
+ * synapse model \a name, in the order of the connections of \a thread.
+ * Node sections hold \a count node records of variable size (see
+ * CheckpointNode).
+ */
+struct CheckpointSection
+{
+    uint32_t kind; //!< content of the section, see SporeCheckpoint::SectionKind
+    uint32_t thread; //!< thread that wrote the section
+    uint64_t offset; //!< position of the section in the file [bytes]
+    uint64_t size; //!< size of the section [bytes]
+    uint64_t count; //!< number of records
+    char name[96]; //!< name of the synapse model (synapse sections only)
+};
+
+/**
+ * @brief State of a synapse in a checkpoint file.
+ */
+struct CheckpointSynapse
+{
+    uint64_t source; //!< GID of the presynaptic node
+    uint64_t target; //!< GID of the postsynaptic node
+    uint64_t port; //!< index of the connection in its connector
+    double delay; //!< [ms]
+    double weight;
+    double synaptic_parameter;
+    double psp_facilitation;
+    double psp_depression;
+    double eligibility_trace;
+    double reward_gradient;
+    double prior_mean;
+    double prior_precision;
+};
+
+/**
+ * @brief Header of a node record in a checkpoint file.
+ *
+ * The header is followed by \a n_state values of the node state (see
+ * TracingNode::get_checkpoint_state()) and \a n_traces windows of
+ * \a trace_length values each, starting at the horizon of the
+ * ConnectionUpdateManager.
+ */
+struct CheckpointNode
+{
+    uint64_t gid; //!< GID of the node
+    uint32_t n_state; //!< number of state values
+    uint32_t n_traces; //!< number of traces
+    uint64_t trace_length; //!< length of every trace window [steps]
+    uint64_t piecewise; //!< 1 if the traces are piecewise constant
+};
+
+/**
+ * @brief Binary checkpoints of the learning state of a network.
+ *
+ * SporeCheckpoint writes the state of all local synapses of registered
+ * connection types (see register_connection_type()) and the state and
+ * trace windows of all local TracingNode instances to a file, and
+ * restores them from it. Networks with dormant synapses (see
+ * \a dormant_retracted_synapses) can not be saved. The file consists of one section per thread and
+ * synapse model and one node section per thread (see CheckpointHeader).
+ * Sections are written in parallel by the threads that own the data
+ * through a memory mapping of the file, and are mapped again for reading
+ * when the checkpoint is restored.
+ *
+ * When a checkpoint is restored, synapses are matched with existing
+ * connections of the same model by thread, source and target, which
+ * requires the same number of threads. Multiple connections between the
+ * same nodes are matched in the order of their ports. Ports that changed
+ * since the checkpoint was saved, because connections were added out of
+ * the order of their targets, therefore do not matter. If no connections of the model exist, they
+ * are created directly by the threads that own their targets, without
+ * going through \a Connect. All nodes must have been created before
+ * restoring. Node states are restored by GID. Trace windows are only
+ * restored if the kernel is at the time of the checkpoint, as NEST can not
+ * set the simulation time. Piecewise constant traces are not restored.
+ */
+class SporeCheckpoint
+{
+public:
+    static const uint32_t version = 1;
+    static const size_t page_size = 4096;
+
+    enum SectionKind
+    {
+        synapses = 1, //!< synapse records of one synapse model
+        nodes = 2 //!< node records
+    };
+
+    template < typename ConnectionT >
+    static void register_connection_type();
+
+    static void save(const std::string& file_name, DictionaryDatum& d);
+    static void load(const std::string& file_name, DictionaryDatum& d);
+
+private:
+
+    /**
+     * @brief Synapse records of one section.
+     */
+    struct SynapseRecords
+    {
+        const CheckpointSynapse* records_;
+        size_t count_;
+        nest::thread thread_;
+    };
+
+    /**
+     * @brief Functions to save and restore connections of one connection type.
+     */
+    struct ConnectionType
+    {
+        bool (*is_model)(nest::synindex syn_id);
+        size_t (*count)(nest::synindex syn_id, nest::thread th);
+        void (*save)(nest::synindex syn_id, nest::thread th, CheckpointSynapse* records);
+        size_t (*restore)(nest::synindex syn_id, nest::thread th, const std::vector<SynapseRecords>& sections,
+                          bool in_place, std::vector<std::string>& errors);
+    };
+
+    template < typename ConnectionT >
+    static bool is_model(nest::synindex syn_id);
+
+    template < typename ConnectionT >
+    static size_t count_connections(nest::synindex syn_id, nest::thread th);
+
+    template < typename ConnectionT >
+    static void save_connections(nest::synindex syn_id, nest::thread th, CheckpointSynapse* records);
+
+    template < typename ConnectionT >
+    static size_t restore_connections(nest::synindex syn_id, nest::thread th,
+                                      const std::vector<SynapseRecords>& sections,
+                                      bool in_place, std::vector<std::string>& errors);
+
+    static const ConnectionType* get_connection_type(nest::synindex syn_id);
+
+    static std::vector<ConnectionType> connection_types_;
+};
+
+/**
+ * Register a connection type to be included in checkpoints. The connection
+ * type must provide the methods get_checkpoint(CheckpointSynapse&) and
+ * set_checkpoint(const CheckpointSynapse&). Must be called when the module
+ * is initialized.
+ */
+template < typename ConnectionT >
+void SporeCheckpoint::register_connection_type()
+{
+    ConnectionType type;
+    type.is_model = &SporeCheckpoint::is_model<ConnectionT>;
+    type.count = &SporeCheckpoint::count_connections<ConnectionT>;
+    type.save = &SporeCheckpoint::save_connections<ConnectionT>;
+    type.restore = &SporeCheckpoint::restore_connections<ConnectionT>;
+    connection_types_.push_back(type);
+}
+
+/**
+ * @return true if the synapse model \a syn_id is of type ConnectionT.
+ */
+template < typename ConnectionT >
+bool SporeCheckpoint::is_model(nest::synindex syn_id)
+{
+    return dynamic_cast<const nest::GenericConnectorModel<ConnectionT>*>(
+            &nest::kernel().model_manager.get_synapse_prototype(syn_id)) != 0;
+}
+
+/**
+ * @return the number of connections of model \a syn_id on thread \a th.
+ */
+template < typename ConnectionT >
+size_t SporeCheckpoint::count_connections(nest::synindex syn_id, nest::thread th)
+{
+    std::vector< std::pair< nest::index, nest::vector_like<ConnectionT>* > > connectors;
+    ConnectionUpdateManager::instance()->get_connectors(syn_id, th, connectors);
+
+    size_t count = 0;
+    for (size_t c = 0; c < connectors.size(); c++)
+    {
+        count += connectors[c].second->size();
+    }
+    return count;
+}
+
+/**
+ * Write the connections of model \a syn_id on thread \a th to \a records
+ * in the order of their connectors and ports.
+ */
+template < typename ConnectionT >
+void SporeCheckpoint::save_connections(nest::synindex syn_id, nest::thread th, CheckpointSynapse* records)
+{
+    std::vector< std::pair< nest::index, nest::vector_like<ConnectionT>* > > connectors;
+    ConnectionUpdateManager::instance()->get_connectors(syn_id, th, connectors);
+
+    size_t k = 0;
+    for (size_t c = 0; c < connectors.size(); c++)
+    {
+        const nest::vector_like<ConnectionT>& connector = *connectors[c].second;
+        for (size_t i = 0; i < connector.size(); i++, k++)
+        {
+            const ConnectionT& connection = connector.at(i);
+            records[k].source = connectors[c].first;
+            records[k].target = connection.get_target(th)->get_gid();
+            records[k].port = i;
+            connection.get_checkpoint(records[k]);
+        }
+    }
+}
+
+/**
+ * Restore the connections of model \a syn_id on thread \a th. Must be
+ * called by all threads of a parallel region.
+ *
+ * If \a in_place is set, the records of thread \a th are matched with the
+ * existing connections by source and target. Nothing is changed if any of the records of any
+ * thread does not match. Otherwise, the connections of all records whose
+ * targets belong to thread \a th are created. Errors are reported in
+ * \a errors at the entry of the thread.
+ *
+ * @return the number of restored connections.
+ */
+template < typename ConnectionT >
+size_t SporeCheckpoint::restore_connections(nest::synindex syn_id, nest::thread th,
+                                            const std::vector<SynapseRecords>& sections,
+                                            bool in_place, std::vector<std::string>& errors)
+{
+    typedef nest::vector_like<ConnectionT> ConnectorType;
+    typedef std::map< nest::index, ConnectorType* > ConnectorMap;
+
+    std::vector< std::pair< nest::index, ConnectorType* > > connectors;
+    std::vector<const CheckpointSynapse*> records;
+
+    if (!in_place)
+    {
+        try
+        {
+            for (size_t s = 0; s < sections.size(); s++)
+            {
+                for (size_t k = 0; k < sections[s].count_; k++)
+                {
+                    const CheckpointSynapse& record = sections[s].records_[k];
+                    nest::Node* target = nest::kernel().node_manager.get_node(record.target, th);
+                    if (!nest::kernel().node_manager.is_local_node(target) || target->get_thread() != th)
+                    {
+                        continue;
+                    }
+                    nest::kernel().connection_manager.connect(record.source, target, th, syn_id, record.delay);
+                    records.push_back(&record);
+                }
+            }
+        }
+        catch (nest::KernelException& e)
+        {
+            errors[th] = e.message();
+        }
+        catch (std::exception& e)
+        {
+            errors[th] = e.what();
+        }
+    }
+    else
+    {
+        for (size_t s = 0; s < sections.size(); s++)
+        {
+            if (sections[s].thread_ == th)
+            {
+                for (size_t k = 0; k < sections[s].count_; k++)
+                {
+                    records.push_back(sections[s].records_ + k);
+                }
+            }
+        }
+    }
+
+    ConnectionUpdateManager::instance()->get_connectors(syn_id, th, connectors);
+    ConnectorMap source_connectors;
+    for (size_t c = 0; c < connectors.size(); c++)
+    {
+        source_connectors[connectors[c].first] = connectors[c].second;
+    }
+
+    // look up all connections before writing. Connections are matched by
+    // source and target, connections between the same nodes in the order of
+    // the records, such that ports that changed since the checkpoint was
+    // saved do not matter.
+    std::vector<ConnectionT*> connections(records.size(), 0);
+    std::map< std::pair<nest::index, nest::index>, size_t > parallel;
+    for (size_t k = 0; k < records.size() && errors[th].empty(); k++)
+    {
+        const CheckpointSynapse& record = *records[k];
+        typename ConnectorMap::const_iterator it = source_connectors.find(record.source);
+        size_t port = 0;
+        if (it != source_connectors.end())
+        {
+            port = DiligentConnectorModel<ConnectionT>::find_connection(it->second, record.target, th) +
+                   parallel[std::make_pair(record.source, record.target)]++;
+        }
+        if (it == source_connectors.end() || port >= it->second->size() ||
+            it->second->at(port).get_target(th)->get_gid() != record.target)
+        {
+            errors[th] = String::compose("connection from %1 to %2 (thread %3, port %4) does not exist.",
+                                         record.source, record.target, th, record.port);
+            break;
+        }
+        connections[k] = &it->second->at(port);
+    }
+
+#pragma omp barrier
+
+    for (size_t t = 0; t < errors.size(); t++)
+    {
+        if (!errors[t].empty())
+        {
+            return 0;
+        }
+    }
+
+    for (size_t k = 0; k < records.size(); k++)
+    {
+        connections[k]->set_checkpoint(*records[k]);
+    }
+    return records.size();
+}
+
+}
+
+#endif /* CHECKPOINT_H */
@@ -94,6 +94,28 @@ public:
             return *ptr_;
         }
 
+        /**
+         * Advance the iterator by \a n positions. Wraps around at limits
+         * of the buffer.
+         */
+        inline
+        void advance(long n)
+        {
+            assert(n >= 0);
+            ptr_ = begin_ + ((ptr_ - begin_) + n) % (end_ - begin_);
+        }
+
+        /**
+         * Values of the circular buffer may change at every position,
+         * therefore the run length is always 1. This allows to use this
+         * iterator in place of ChangePointBuffer::const_iterator.
+         */
+        inline
+        long get_run_length() const
+        {
+            return 1;
+        }
+
     private:
         friend class CircularBuffer;
 
@@ -25,10 +25,21 @@
  */
 
 #include "connection_data_logger.h"
+#include "shm_export.h"
 #include "spore_names.h"
 
 #include "dictutils.h"
 #include "exceptions.h"
+#include "kernel_manager.h"
+#include "arraydatum.h"
+
+#include <algorithm>
+#include <limits>
+#include <sstream>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 
 namespace spore
@@ -36,9 +47,14 @@ namespace spore
 
 /**
  * Constructor.
+ *
+ * @param label label of the logger, used to name stream files.
  */
-ConnectionDataLoggerBase::ConnectionDataLoggerBase()
+ConnectionDataLoggerBase::ConnectionDataLoggerBase(const std::string& label)
+: label_(label),
+aggregates_(nest::invalid_synindex, 0)
 {
+    instances().push_back(this);
 }
 
 /**
@@ -46,12 +62,16 @@ ConnectionDataLoggerBase::ConnectionDataLoggerBase()
  */
 ConnectionDataLoggerBase::~ConnectionDataLoggerBase()
 {
-    for (std::vector<RecorderData*>::iterator it = recorder_data_.begin();
-            it != recorder_data_.end();
-            ++it)
+    close_own_streams();
+    clear_own_aggregates();
+
+    for (size_t i = 0; i < recorder_data_.size(); i++)
     {
-        delete *it;
+        delete recorder_data_[i];
     }
+
+    std::vector< ConnectionDataLoggerBase* >& loggers = instances();
+    loggers.erase(std::remove(loggers.begin(), loggers.end(), this), loggers.end());
 }
 
 /**
@@ -68,11 +88,32 @@ void ConnectionDataLoggerBase::get_status(DictionaryDatum& d, recorder_port port
     assert(port < recorder_data_.size());
     ConnectionDataLoggerBase::RecorderData& recorder = *recorder_data_[port];
 
-    (*d)[names::recorder_times] = recorder.recorder_times_;
+    (*d)[names::recorder_port] = static_cast<long>(port);
+    (*d)[names::recorder_stream] = recorder.stream_;
+    (*d)[names::recorder_max_samples] = recorder.max_samples_;
+    (*d)[names::recorder_decimation_levels] = static_cast<long>(std::max<size_t>(recorder.levels_.size(), 1));
 
-    for (size_t i = 0; i < recorder_names_.size(); i++)
+    if (recorder.levels_.empty())
     {
-        (*d)[recorder_names_[i]] = recorder.recorder_values_[i];
+        (*d)[names::recorder_times] = recorder.recorder_times_;
+
+        for (size_t i = 0; i < recorder_names_.size(); i++)
+        {
+            (*d)[recorder_names_[i]] = recorder.recorder_values_[i];
+        }
+    }
+    else
+    {
+        std::vector<double> times;
+        std::vector< std::vector<double> > values;
+        recorder.get_samples(times, values);
+
+        (*d)[names::recorder_times] = times;
+
+        for (size_t i = 0; i < recorder_names_.size(); i++)
+        {
+            (*d)[recorder_names_[i]] = values[i];
+        }
     }
 }
 
@@ -96,8 +137,42 @@ void ConnectionDataLoggerBase::set_status(const DictionaryDatum& d, recorder_por
 
     assert(port < recorder_data_.size());
 
+    long max_samples = recorder_data_[port]->max_samples_;
+    long levels = std::max<size_t>(recorder_data_[port]->levels_.size(), 1);
+    const bool new_max_samples = updateValue<long>(d, names::recorder_max_samples, max_samples);
+    const bool new_levels = updateValue<long>(d, names::recorder_decimation_levels, levels);
+
+    if (max_samples < 0)
+        throw nest::BadProperty("recorder_max_samples must be larger or equal to 0.");
+
+    if (levels < 1)
+        throw nest::BadProperty("recorder_decimation_levels must be larger than 0.");
+
+    if (max_samples > 0 && max_samples < levels)
+        throw nest::BadProperty("recorder_max_samples must not be smaller than recorder_decimation_levels.");
+
+    if (new_max_samples || new_levels)
+    {
+        recorder_data_[port]->set_bounds(max_samples, levels);
+    }
+
     recorder_data_[port]->interval_ = interval;
 
+    bool stream = recorder_data_[port]->stream_;
+    if (updateValue<bool>(d, names::recorder_stream, stream) && stream)
+    {
+        // connections may be configured concurrently while they are created.
+#pragma omp critical(spore_recorder_streams)
+        {
+            const size_t num_threads = nest::kernel().vp_manager.get_num_threads();
+            if (streams_.size() < num_threads)
+            {
+                streams_.resize(num_threads, 0);
+            }
+        }
+    }
+    recorder_data_[port]->stream_ = stream;
+
     bool reset_recorder = false;
     updateValue<bool>(d, names::reset_recorder, reset_recorder);
 
@@ -108,17 +183,378 @@ void ConnectionDataLoggerBase::set_status(const DictionaryDatum& d, recorder_por
 }
 
 /**
- * Add new recordable connection to the recorder.
+ * Add new recordable connection to the recorder. This function is
+ * thread-safe and does not lock.
  *
  * @return the port id of the new recorder.
  */
 ConnectionDataLoggerBase::recorder_port ConnectionDataLoggerBase::add_recordable_connection()
 {
-    if (recorder_data_.size() == nest::invalid_index)
+    if (recorder_data_.size() >= recorder_data_.max_size())
         throw nest::BadProperty("Maximum number of recorders reached.");
 
-    recorder_data_.push_back(new RecorderData(recorder_names_.size()));
-    return recorder_data_.size() - 1;
+    return recorder_data_.push_back(new RecorderData(recorder_names_.size()));
+}
+
+/**
+ * Create the stream of the given thread. Stream files are placed in the
+ * data path of the NEST kernel.
+ *
+ * @param thread the thread of the stream.
+ */
+void ConnectionDataLoggerBase::open_stream(nest::thread thread)
+{
+    std::stringstream prefix;
+    const std::string& path = nest::kernel().io_manager.get_data_path();
+    if (!path.empty())
+    {
+        prefix << path << "/";
+    }
+    prefix << nest::kernel().io_manager.get_data_prefix() << label_ << "-" << thread;
+
+    std::vector<std::string> names;
+    for (size_t i = 0; i < recorder_names_.size(); i++)
+    {
+        names.push_back(recorder_names_[i].toString());
+    }
+
+    streams_[thread] = new RecorderStream(prefix.str(), names, nest::kernel().io_manager.overwrite_files());
+}
+
+/**
+ * Close all streams of this logger.
+ */
+void ConnectionDataLoggerBase::close_own_streams()
+{
+    for (size_t i = 0; i < streams_.size(); i++)
+    {
+        delete streams_[i];
+        streams_[i] = 0;
+    }
+}
+
+/**
+ * Open the streams of the given thread of all loggers that have streamed
+ * ports, unless they are open already. Every thread opens its own streams
+ * when a simulation is prepared.
+ *
+ * @param thread the calling thread.
+ */
+void ConnectionDataLoggerBase::open_streams(nest::thread thread)
+{
+    std::vector< ConnectionDataLoggerBase* >& loggers = instances();
+    for (size_t i = 0; i < loggers.size(); i++)
+    {
+        if (static_cast<size_t>(thread) < loggers[i]->streams_.size() && loggers[i]->streams_[thread] == 0)
+        {
+            loggers[i]->open_stream(thread);
+        }
+    }
+}
+
+/**
+ * Flush the streams of the given thread of all loggers.
+ *
+ * @param thread the calling thread.
+ */
+void ConnectionDataLoggerBase::flush_streams(nest::thread thread)
+{
+    std::vector< ConnectionDataLoggerBase* >& loggers = instances();
+    for (size_t i = 0; i < loggers.size(); i++)
+    {
+        if (static_cast<size_t>(thread) < loggers[i]->streams_.size() && loggers[i]->streams_[thread])
+        {
+            loggers[i]->streams_[thread]->flush();
+        }
+    }
+}
+
+/**
+ * Close the streams of all loggers. Streams are opened again when the next
+ * simulation is prepared. This function is not thread-safe.
+ */
+void ConnectionDataLoggerBase::close_streams()
+{
+    std::vector< ConnectionDataLoggerBase* >& loggers = instances();
+    for (size_t i = 0; i < loggers.size(); i++)
+    {
+        loggers[i]->close_own_streams();
+    }
+}
+
+/**
+ * Get the aggregate series of the given synapse model and thread. The series
+ * of all threads are allocated when the synapse model is aggregated for the
+ * first time. This function is thread-safe.
+ *
+ * @param syn_id the synapse model.
+ * @param thread the calling thread.
+ * @return the aggregate series.
+ */
+ConnectionDataLoggerBase::AggregateSeries& ConnectionDataLoggerBase::get_aggregate_series(nest::synindex syn_id,
+                                                                                          nest::thread thread)
+{
+    assert(syn_id < aggregates_.size());
+    std::vector< AggregateSeries >* series = aggregates_[syn_id];
+
+    if (series == 0)
+    {
+#pragma omp critical(spore_aggregate_series)
+        {
+            if (aggregates_[syn_id] == 0)
+            {
+                std::vector< AggregateSeries >* new_series =
+                        new std::vector< AggregateSeries >(nest::kernel().vp_manager.get_num_threads());
+                // publish the series only after it was constructed
+                __sync_synchronize();
+                aggregates_[syn_id] = new_series;
+            }
+        }
+        series = aggregates_[syn_id];
+    }
+
+    assert(static_cast<size_t>(thread) < series->size());
+    return (*series)[thread];
+}
+
+/**
+ * Merge the aggregate series of all threads of the given synapse model up
+ * to the given time and write them to the dictionary. The returned time
+ * points are removed from the series, such that the series only hold time
+ * points that were not read yet. Time points at or after \a horizon may
+ * still receive samples of connections that were not updated yet and are
+ * kept for later calls. This function is not thread-safe.
+ *
+ * @param syn_id the synapse model.
+ * @param horizon time up to which all connections were updated [ms].
+ * @param d dictionary to retrieve data.
+ * @return false if the synapse model was never aggregated.
+ */
+bool ConnectionDataLoggerBase::get_aggregates(nest::synindex syn_id, double horizon, DictionaryDatum& d)
+{
+    std::vector< ConnectionDataLoggerBase* >& loggers = instances();
+    for (size_t l = 0; l < loggers.size(); l++)
+    {
+        ConnectionDataLoggerBase& logger = *loggers[l];
+        if (syn_id >= logger.aggregates_.size() || logger.aggregates_[syn_id] == 0)
+        {
+            continue;
+        }
+
+        std::vector< AggregateSeries >& threads = *logger.aggregates_[syn_id];
+        AggregateSeries merged;
+        for (size_t th = 0; th < threads.size(); th++)
+        {
+            const AggregateSeries::iterator end = threads[th].lower_bound(horizon);
+            for (AggregateSeries::const_iterator it = threads[th].begin(); it != end; ++it)
+            {
+                AggregateSeries::iterator m = merged.find(it->first);
+                if (m == merged.end())
+                {
+                    merged.insert(*it);
+                }
+                else
+                {
+                    m->second.merge(it->second);
+                }
+            }
+            threads[th].erase(threads[th].begin(), end);
+        }
+
+        std::vector<double> times;
+        std::vector<long> counts;
+        std::vector<long> retracted;
+        for (AggregateSeries::const_iterator it = merged.begin(); it != merged.end(); ++it)
+        {
+            times.push_back(it->first);
+            counts.push_back(static_cast<long>(it->second.count_));
+            retracted.push_back(it->second.retracted_);
+        }
+        (*d)[names::aggregate_times] = times;
+        (*d)[names::aggregate_counts] = counts;
+        (*d)[names::retracted_counts] = retracted;
+
+        for (size_t i = 0; i < logger.aggregate_names_.size(); i++)
+        {
+            DictionaryDatum var(new Dictionary);
+            std::vector<double> mean;
+            std::vector<double> variance;
+            std::vector<double> range(2, 0.0);
+            ArrayDatum histograms;
+            for (AggregateSeries::const_iterator it = merged.begin(); it != merged.end(); ++it)
+            {
+                const AggregateData& data = it->second;
+                mean.push_back(data.mean_[i]);
+                variance.push_back(data.m2_[i] / data.count_);
+                std::vector<long> histogram(data.histogram_.begin() + i * data.bins_,
+                                            data.histogram_.begin() + (i + 1) * data.bins_);
+                histograms.push_back(histogram);
+                range[0] = data.ranges_[2 * i];
+                range[1] = data.ranges_[2 * i + 1];
+            }
+            (*var)[names::mean] = mean;
+            (*var)[names::variance] = variance;
+            (*var)[names::histogram] = histograms;
+            (*var)[names::histogram_range] = range;
+            (*d)[logger.aggregate_names_[i]] = var;
+        }
+        return true;
+    }
+    return false;
+}
+
+/**
+ * Delete the aggregates of all loggers. This function is not thread-safe.
+ */
+void ConnectionDataLoggerBase::clear_aggregates()
+{
+    std::vector< ConnectionDataLoggerBase* >& loggers = instances();
+    for (size_t i = 0; i < loggers.size(); i++)
+    {
+        loggers[i]->clear_own_aggregates();
+    }
+}
+
+/**
+ * Shrink the recorder vectors of all ports of all loggers that use less
+ * than the given fraction of their capacity, e.g. after the recorders were
+ * reset. This function is not thread-safe and must not be called while
+ * connections record.
+ *
+ * @param threshold fraction of the capacity below which vectors are shrunk.
+ * @return the number of released bytes.
+ */
+size_t ConnectionDataLoggerBase::compact(double threshold)
+{
+    size_t reclaimed = 0;
+    std::vector< ConnectionDataLoggerBase* >& loggers = instances();
+    for (size_t i = 0; i < loggers.size(); i++)
+    {
+        reclaimed += loggers[i]->compact_own(threshold);
+    }
+    return reclaimed;
+}
+
+/**
+ * @return the memory of the recorders of all ports of all loggers in
+ * bytes. This function is not thread-safe.
+ */
+size_t ConnectionDataLoggerBase::get_recorder_bytes()
+{
+    size_t bytes = 0;
+    std::vector< ConnectionDataLoggerBase* >& loggers = instances();
+    for (size_t i = 0; i < loggers.size(); i++)
+    {
+        for (size_t port = 0; port < loggers[i]->recorder_data_.size(); port++)
+        {
+            bytes += sizeof (RecorderData*) + loggers[i]->recorder_data_[port]->get_bytes();
+        }
+    }
+    return bytes;
+}
+
+/**
+ * Shrink the recorder vectors of all ports of this logger.
+ */
+size_t ConnectionDataLoggerBase::compact_own(double threshold)
+{
+    size_t reclaimed = 0;
+    for (size_t i = 0; i < recorder_data_.size(); i++)
+    {
+        reclaimed += recorder_data_[i]->compact(threshold);
+    }
+    return reclaimed;
+}
+
+/**
+ * Delete the aggregates of this logger.
+ */
+void ConnectionDataLoggerBase::clear_own_aggregates()
+{
+    for (size_t i = 0; i < aggregates_.size(); i++)
+    {
+        delete aggregates_[i];
+        aggregates_[i] = 0;
+    }
+}
+
+/**
+ * Export the in-memory recordings of the logger with the given label to a
+ * shared memory segment. This function is not thread-safe.
+ *
+ * @param label label of the logger.
+ * @param shm_name name of the shared memory segment.
+ * @return false if there is no logger with the given label.
+ */
+bool ConnectionDataLoggerBase::export_data(const std::string& label, const std::string& shm_name)
+{
+    std::vector< ConnectionDataLoggerBase* >& loggers = instances();
+    for (size_t i = 0; i < loggers.size(); i++)
+    {
+        if (loggers[i]->label_ == label)
+        {
+            loggers[i]->export_own_data(shm_name);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Export the in-memory recordings of all recorder ports. The segment holds
+ * one row per port, in the order of the ports, and the columns "time" and
+ * one column per recorded variable. Streamed ports have no samples.
+ *
+ * @param shm_name name of the shared memory segment.
+ */
+void ConnectionDataLoggerBase::export_own_data(const std::string& shm_name) const
+{
+    const size_t n_rows = recorder_data_.size();
+
+    size_t n_samples = 0;
+    for (size_t port = 0; port < n_rows; port++)
+    {
+        n_samples += recorder_data_[port]->get_num_samples();
+    }
+
+    std::vector<std::string> columns(1, "time");
+    for (size_t i = 0; i < recorder_names_.size(); i++)
+    {
+        columns.push_back(recorder_names_[i].toString());
+    }
+
+    ShmExport shm(shm_name, ShmExport::recorder, n_rows, n_samples, columns);
+
+    uint64_t* offsets = shm.offsets();
+    uint64_t* row_ids = shm.row_ids();
+    uint64_t* row_sub = shm.row_sub();
+    std::vector<double*> values(recorder_names_.size());
+
+    offsets[0] = 0;
+    for (size_t port = 0; port < n_rows; port++)
+    {
+        const RecorderData& recorder = *recorder_data_[port];
+        const uint64_t offset = offsets[port];
+
+        for (size_t i = 0; i < values.size(); i++)
+        {
+            values[i] = shm.column(i + 1) + offset;
+        }
+        recorder.copy_samples(shm.column(0) + offset, values);
+
+        offsets[port + 1] = offset + recorder.get_num_samples();
+        row_ids[port] = port;
+        row_sub[port] = 0;
+    }
+}
+
+/**
+ * @return all existing data loggers.
+ */
+std::vector< ConnectionDataLoggerBase* >& ConnectionDataLoggerBase::instances()
+{
+    static std::vector< ConnectionDataLoggerBase* > loggers;
+    return loggers;
 }
 
 /**
@@ -126,11 +562,9 @@ ConnectionDataLoggerBase::recorder_port ConnectionDataLoggerBase::add_recordable
  */
 void ConnectionDataLoggerBase::clear()
 {
-    for (std::vector<RecorderData*>::iterator it = recorder_data_.begin();
-            it != recorder_data_.end();
-            ++it)
+    for (size_t i = 0; i < recorder_data_.size(); i++)
     {
-        (*it)->clear();
+        recorder_data_[i]->clear();
     }
 }
 
@@ -144,11 +578,117 @@ void ConnectionDataLoggerBase::clear()
  * @param size number of variables in the recorder buffer.
  */
 ConnectionDataLoggerBase::RecorderData::RecorderData(size_t size)
-: interval_(0.0)
+: max_samples_(0),
+interval_(0.0),
+last_time_(-std::numeric_limits<double>::infinity()),
+stream_(false)
 {
     recorder_values_.resize(size);
 }
 
+/**
+ * Limit the number of samples that are kept by the recorder. All recorded
+ * data is erased.
+ *
+ * @param max_samples maximum number of samples, 0 means unbounded.
+ * @param levels number of decimation levels the samples are split into.
+ */
+void ConnectionDataLoggerBase::RecorderData::set_bounds(long max_samples, long levels)
+{
+    clear();
+    max_samples_ = max_samples;
+    levels_.clear();
+    sample_.clear();
+
+    if (max_samples > 0)
+    {
+        assert(levels > 0 && max_samples >= levels);
+        sample_.resize(recorder_values_.size(), 0.0);
+        levels_.resize(levels, RecorderLevel(max_samples / levels, recorder_values_.size()));
+    }
+}
+
+/**
+ * Copy all samples in the order of time.
+ *
+ * @param times vector to retrieve the sample times.
+ * @param values vector to retrieve the sample values of all variables.
+ */
+void ConnectionDataLoggerBase::RecorderData::get_samples(std::vector<double>& times,
+                                                          std::vector< std::vector<double> >& values) const
+{
+    const size_t n = get_num_samples();
+    times.assign(n, 0.0);
+    values.assign(recorder_values_.size(), std::vector<double>(n, 0.0));
+
+    if (n > 0)
+    {
+        std::vector<double*> buffers(values.size());
+        for (size_t i = 0; i < values.size(); i++)
+        {
+            buffers[i] = &values[i][0];
+        }
+        copy_samples(&times[0], buffers);
+    }
+}
+
+/**
+ * @return the number of samples that are currently kept in memory.
+ */
+size_t ConnectionDataLoggerBase::RecorderData::get_num_samples() const
+{
+    if (levels_.empty())
+    {
+        return recorder_times_.size();
+    }
+
+    size_t n = 0;
+    for (size_t l = 0; l < levels_.size(); l++)
+    {
+        n += levels_[l].size_;
+    }
+    return n;
+}
+
+/**
+ * Copy all samples in the order of time into the given buffers. All
+ * buffers must hold at least get_num_samples() values.
+ *
+ * @param times buffer to retrieve the sample times.
+ * @param values buffers to retrieve the sample values, one per variable.
+ */
+void ConnectionDataLoggerBase::RecorderData::copy_samples(double* times, const std::vector<double*>& values) const
+{
+    assert(values.size() == recorder_values_.size());
+
+    if (levels_.empty())
+    {
+        std::copy(recorder_times_.begin(), recorder_times_.end(), times);
+        for (size_t i = 0; i < recorder_values_.size(); i++)
+        {
+            std::copy(recorder_values_[i].begin(), recorder_values_[i].end(), values[i]);
+        }
+        return;
+    }
+
+    // higher levels hold older samples
+    size_t n = 0;
+    for (size_t l = levels_.size(); l-- > 0;)
+    {
+        const RecorderLevel& level = levels_[l];
+        const size_t capacity = level.times_.size();
+        for (size_t k = 0; k < level.size_; k++, n++)
+        {
+            const size_t slot = (level.start_ + k) % capacity;
+            times[n] = level.times_[slot];
+            for (size_t i = 0; i < level.num_values_; i++)
+            {
+                values[i][n] = level.values_[slot * level.num_values_ + i];
+            }
+        }
+    }
+}
+
 /**
  * Constructor.
  *
@@ -157,6 +697,14 @@ ConnectionDataLoggerBase::RecorderData::RecorderData(size_t size)
 void ConnectionDataLoggerBase::RecorderData::clear()
 {
     recorder_times_.clear();
+    last_time_ = -std::numeric_limits<double>::infinity();
+
+    for (size_t l = 0; l < levels_.size(); l++)
+    {
+        levels_[l].start_ = 0;
+        levels_[l].size_ = 0;
+        levels_[l].pass_on_ = true;
+    }
 
     for (std::vector< std::vector<double> >::iterator it = recorder_values_.begin();
             it != recorder_values_.end();
@@ -166,5 +714,295 @@ void ConnectionDataLoggerBase::RecorderData::clear()
     }
 }
 
+/**
+ * Shrink the unbounded sample vectors if less than the given fraction of
+ * their capacity is in use. Bounded rings have a fixed size.
+ *
+ * @param threshold fraction of the capacity below which vectors are shrunk.
+ * @return the number of released bytes.
+ */
+size_t ConnectionDataLoggerBase::RecorderData::compact(double threshold)
+{
+    size_t capacity = recorder_times_.capacity();
+    size_t size = recorder_times_.size();
+    for (size_t i = 0; i < recorder_values_.size(); i++)
+    {
+        capacity += recorder_values_[i].capacity();
+        size += recorder_values_[i].size();
+    }
+
+    if (size >= threshold * capacity)
+    {
+        return 0;
+    }
+
+    std::vector<double>(recorder_times_).swap(recorder_times_);
+    size_t new_capacity = recorder_times_.capacity();
+    for (size_t i = 0; i < recorder_values_.size(); i++)
+    {
+        std::vector<double>(recorder_values_[i]).swap(recorder_values_[i]);
+        new_capacity += recorder_values_[i].capacity();
+    }
+
+    return (capacity - new_capacity) * sizeof (double);
+}
+
+/**
+ * @return the memory of the recorder in bytes.
+ */
+size_t ConnectionDataLoggerBase::RecorderData::get_bytes() const
+{
+    size_t doubles = recorder_times_.capacity() + sample_.capacity();
+    for (size_t i = 0; i < recorder_values_.size(); i++)
+    {
+        doubles += recorder_values_[i].capacity();
+    }
+    for (size_t l = 0; l < levels_.size(); l++)
+    {
+        doubles += levels_[l].times_.capacity() + levels_[l].values_.capacity();
+    }
+
+    return sizeof (RecorderData) + recorder_values_.capacity() * sizeof (std::vector<double>) +
+           levels_.capacity() * sizeof (RecorderLevel) + doubles * sizeof (double);
+}
+
+//
+// ConnectionDataLoggerBase::RecorderLevel implementation.
+//
+
+/**
+ * Constructor.
+ *
+ * @param capacity number of samples of the level.
+ * @param size number of variables per sample.
+ */
+ConnectionDataLoggerBase::RecorderLevel::RecorderLevel(size_t capacity, size_t size)
+: times_(capacity, 0.0),
+values_(capacity * size, 0.0),
+num_values_(size),
+start_(0),
+size_(0),
+pass_on_(true)
+{
+}
+
+/**
+ * Add a sample to the level. If the level is full, its oldest sample is
+ * evicted and every second evicted sample is pushed to the next level.
+ *
+ * @param time time of the sample.
+ * @param values values of the sample.
+ * @param levels all levels of the recorder.
+ * @param level index of this level.
+ */
+void ConnectionDataLoggerBase::RecorderLevel::push(double time,
+                                                    const double* values,
+                                                    std::vector<RecorderLevel>& levels,
+                                                    size_t level)
+{
+    const size_t capacity = times_.size();
+    size_t slot;
+
+    if (size_ < capacity)
+    {
+        slot = (start_ + size_) % capacity;
+        size_++;
+    }
+    else
+    {
+        slot = start_;
+        start_ = (start_ + 1) % capacity;
+
+        if (level + 1 < levels.size())
+        {
+            if (pass_on_)
+            {
+                levels[level + 1].push(times_[slot], &values_[slot * num_values_], levels, level + 1);
+            }
+            pass_on_ = !pass_on_;
+        }
+    }
+
+    times_[slot] = time;
+    std::copy(values, values + num_values_, values_.begin() + slot * num_values_);
+}
+
+//
+// ConnectionDataLoggerBase::AggregateData implementation.
+//
+
+/**
+ * Constructor.
+ *
+ * @param size number of aggregate variables.
+ * @param bins number of histogram bins.
+ * @param ranges lower and upper histogram limits of all variables.
+ */
+ConnectionDataLoggerBase::AggregateData::AggregateData(size_t size, size_t bins, const double* ranges)
+: count_(0.0),
+retracted_(0),
+bins_(bins),
+mean_(size, 0.0),
+m2_(size, 0.0),
+ranges_(ranges, ranges + 2 * size),
+histogram_(size * bins, 0)
+{
 }
 
+/**
+ * Merge the statistics of another sample set into this one.
+ *
+ * @param other statistics recorded at the same time point.
+ */
+void ConnectionDataLoggerBase::AggregateData::merge(const AggregateData& other)
+{
+    assert(mean_.size() == other.mean_.size());
+    assert(histogram_.size() == other.histogram_.size());
+
+    const double count = count_ + other.count_;
+    if (count == 0.0)
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < mean_.size(); i++)
+    {
+        const double delta = other.mean_[i] - mean_[i];
+        mean_[i] += delta * other.count_ / count;
+        m2_[i] += other.m2_[i] + delta * delta * count_ * other.count_ / count;
+    }
+
+    for (size_t i = 0; i < histogram_.size(); i++)
+    {
+        histogram_[i] += other.histogram_[i];
+    }
+
+    count_ = count;
+    retracted_ += other.retracted_;
+}
+
+//
+// Implementation of RecorderPortTable
+//
+
+std::vector< RecorderPortTable::PortMap >* RecorderPortTable::tables_ = 0;
+
+/**
+ * Set the recorder port of the connection. An invalid port removes the
+ * connection from the table. Connections may be configured concurrently
+ * while they are created.
+ *
+ * @param port the recorder port.
+ * @param thread the thread that owns the connection, -1 for the calling thread.
+ */
+void RecorderPortTable::set_recorder_port(recorder_port port, nest::thread thread)
+{
+    if (tables_ == 0)
+    {
+        if (port == nest::invalid_index)
+        {
+            return;
+        }
+
+#pragma omp critical(spore_recorder_port_table)
+        {
+            if (tables_ == 0)
+            {
+                std::vector< PortMap >* new_tables =
+                        new std::vector< PortMap >(nest::kernel().vp_manager.get_num_threads());
+                // publish the tables only after they were constructed
+                __sync_synchronize();
+                tables_ = new_tables;
+            }
+        }
+    }
+
+    thread = caller_thread(thread);
+    assert(thread >= 0 && static_cast<size_t>(thread) < tables_->size());
+
+    if (port == nest::invalid_index)
+    {
+        (*tables_)[thread].erase(this);
+    }
+    else
+    {
+        (*tables_)[thread][this] = port;
+    }
+}
+
+/**
+ * Remove all recorder ports. Must not be called concurrently with other
+ * member functions.
+ */
+void RecorderPortTable::clear()
+{
+    delete tables_;
+    tables_ = 0;
+}
+
+/**
+ * @return the recorder port of the connection in the table of \a thread,
+ * or in any table if the thread is unknown.
+ */
+RecorderPortTable::recorder_port RecorderPortTable::lookup(nest::thread thread) const
+{
+    thread = caller_thread(thread);
+
+    for (size_t t = 0; t < tables_->size(); t++)
+    {
+        if (thread < 0 || static_cast<size_t>(thread) == t)
+        {
+            PortMap::const_iterator it = (*tables_)[t].find(this);
+            if (it != (*tables_)[t].end())
+            {
+                return it->second;
+            }
+        }
+    }
+
+    return nest::invalid_index;
+}
+
+/**
+ * Copy the recorder port of \a rhs to this connection, or remove this
+ * connection from the tables if \a rhs is 0 or not recorded. Both
+ * connections must belong to the same thread.
+ */
+void RecorderPortTable::assign(const RecorderPortTable* rhs)
+{
+    const nest::thread thread = caller_thread(-1);
+
+    for (size_t t = 0; t < tables_->size(); t++)
+    {
+        if (thread < 0 || static_cast<size_t>(thread) == t)
+        {
+            PortMap& table = (*tables_)[t];
+            PortMap::const_iterator it = rhs ? table.find(rhs) : table.end();
+            if (it != table.end())
+            {
+                table[this] = it->second;
+            }
+            else
+            {
+                table.erase(this);
+            }
+        }
+    }
+}
+
+/**
+ * Resolve the thread -1 to the calling thread within parallel regions.
+ * Outside of parallel regions it is left at -1, i.e. unknown.
+ */
+nest::thread RecorderPortTable::caller_thread(nest::thread thread)
+{
+#ifdef _OPENMP
+    if (thread < 0 && omp_in_parallel())
+    {
+        return nest::kernel().vp_manager.get_thread_id();
+    }
+#endif
+    return thread;
+}
+
+}
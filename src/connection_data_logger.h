@@ -27,50 +27,311 @@
 #ifndef CONNECTION_DATA_LOGGER_H
 #define CONNECTION_DATA_LOGGER_H
 
+#include <algorithm>
+#include <cmath>
+#include <map>
 #include <string>
 #include <vector>
 
 #include "nest.h"
 #include "dictdatum.h"
 
+#include "segmented_vector.h"
+#include "recorder_stream.h"
+
 
 namespace spore
 {
 
 /**
  * @brief Base class to all data loggers for connections.
+ *
+ * Recorder ports are allocated in a lock-free SegmentedVector, such that
+ * connections on different threads can enable recording concurrently.
+ *
+ * By default, recorded values are kept in memory and can be read through
+ * get_status(). If \a recorder_stream is set for a port, its records are
+ * instead appended to per-thread RecorderStream files in the data path of
+ * the NEST kernel, named "<data_prefix><label>-<thread>-<column>.dat".
+ * Streamed ports cost no memory per record. Use the recorder_port of a
+ * connection to identify its records in the "port" column. Streams are
+ * opened by the ConnectionUpdateManager when a simulation is prepared,
+ * flushed at the end of every simulation run and closed when the kernel
+ * is reset. Ports that enable streaming during a simulation are streamed
+ * from the next simulation on.
+ *
+ * In addition to recording individual connections, the logger can
+ * aggregate statistics over all connections of a synapse model. For every
+ * aggregate time point it accumulates the number of connections, the number
+ * of retracted connections and the running mean, variance and a fixed-bin
+ * histogram of every aggregate variable. Each thread accumulates into its
+ * own series of AggregateData. Threads are merged when the aggregates are
+ * read with get_aggregates(), which is not thread-safe. Reading removes the
+ * returned time points, so the series only grow while they are not read.
+ *
+ * The in-memory recordings of all ports can be exported at once to a
+ * shared memory segment with export_data(), see ShmExport for its layout.
  */
 class ConnectionDataLoggerBase
 {
 public:
     typedef nest::index recorder_port;
 
-    ConnectionDataLoggerBase();
+    ConnectionDataLoggerBase(const std::string& label);
     ~ConnectionDataLoggerBase();
 
     void get_status(DictionaryDatum& d, recorder_port port) const;
     void set_status(const DictionaryDatum& d, recorder_port& port);
     void clear();
 
+    static void open_streams(nest::thread thread);
+    static void flush_streams(nest::thread thread);
+    static void close_streams();
+
+    static bool get_aggregates(nest::synindex syn_id, double horizon, DictionaryDatum& d);
+    static void clear_aggregates();
+
+    static size_t compact(double threshold);
+    static size_t get_recorder_bytes();
+
+    static bool export_data(const std::string& label, const std::string& shm_name);
+
 protected:
 
+    /**
+     * @brief Fixed-size ring of samples of one level of resolution.
+     *
+     * If the ring is full, the oldest sample is evicted. Every second
+     * evicted sample is passed on to the next level, such that the
+     * resolution halves from level to level while each level holds the
+     * same number of samples.
+     */
+    struct RecorderLevel
+    {
+        RecorderLevel(size_t capacity, size_t size);
+        void push(double time, const double* values, std::vector<RecorderLevel>& levels, size_t level);
+
+        std::vector<double> times_;
+        std::vector<double> values_; //!< values of all variables, one row per slot
+        size_t num_values_;
+        size_t start_;
+        size_t size_;
+        bool pass_on_; //!< pass the next evicted sample on to the next level
+    };
+
     /**
      * @brief Data structure that holds the recorded data.
+     *
+     * By default samples are appended to recorder_times_ and
+     * recorder_values_ without limit. If \a recorder_max_samples is set,
+     * samples are kept in a chain of fixed-size RecorderLevel rings instead.
      */
     struct RecorderData
     {
         RecorderData(size_t size);
         void clear();
+        void set_bounds(long max_samples, long levels);
+        void get_samples(std::vector<double>& times, std::vector< std::vector<double> >& values) const;
+        size_t get_num_samples() const;
+        void copy_samples(double* times, const std::vector<double*>& values) const;
+        size_t compact(double threshold);
+        size_t get_bytes() const;
 
         std::vector<double> recorder_times_;
         std::vector< std::vector<double> > recorder_values_;
+        std::vector<RecorderLevel> levels_; //!< bounded storage (empty if unbounded)
+        std::vector<double> sample_; //!< values of the current sample in bounded mode
+        long max_samples_;
         double interval_;
+        double last_time_;
+        bool stream_;
     };
 
+    /**
+     * @brief Statistics of the aggregate variables at one time point.
+     */
+    struct AggregateData
+    {
+        AggregateData(size_t size, size_t bins, const double* ranges);
+        void merge(const AggregateData& other);
+
+        /**
+         * Start adding a new sample. The values of the sample must be added
+         * with add_value() afterwards.
+         */
+        inline
+        void add_sample(bool retracted)
+        {
+            count_ += 1.0;
+            if (retracted)
+            {
+                retracted_++;
+            }
+        }
+
+        /**
+         * Add value \a v of variable \a id of the current sample.
+         */
+        inline
+        void add_value(size_t id, double v)
+        {
+            // Welford's online update of mean and variance
+            const double delta = v - mean_[id];
+            mean_[id] += delta / count_;
+            m2_[id] += delta * (v - mean_[id]);
+
+            const double lower = ranges_[2 * id];
+            const double upper = ranges_[2 * id + 1];
+            long bin = static_cast<long>(std::floor((v - lower) / (upper - lower) * bins_));
+            bin = std::max(0L, std::min(bin, static_cast<long>(bins_) - 1));
+            histogram_[id * bins_ + bin]++;
+        }
+
+        double count_;
+        long retracted_;
+        size_t bins_;
+        std::vector<double> mean_;
+        std::vector<double> m2_; //!< sum of squared differences from the mean
+        std::vector<double> ranges_; //!< lower and upper histogram limits of all variables
+        std::vector<long> histogram_; //!< bins of all variables
+    };
+
+    typedef std::map< double, AggregateData > AggregateSeries;
+
     recorder_port add_recordable_connection();
+    AggregateSeries& get_aggregate_series(nest::synindex syn_id, nest::thread thread);
+
+    /**
+     * @return the stream of \a thread, or 0 if it was not opened by
+     *         open_streams() yet.
+     */
+    inline
+    RecorderStream* get_stream(nest::thread thread)
+    {
+        assert(static_cast<size_t>(thread) < streams_.size());
+        return streams_[thread];
+    }
 
-    std::vector< RecorderData* > recorder_data_;
+    SegmentedVector< RecorderData* > recorder_data_;
     std::vector< Name > recorder_names_;
+    std::vector< Name > aggregate_names_;
+
+private:
+    void open_stream(nest::thread thread);
+    void close_own_streams();
+    void clear_own_aggregates();
+    size_t compact_own(double threshold);
+    void export_own_data(const std::string& shm_name) const;
+
+    static std::vector< ConnectionDataLoggerBase* >& instances();
+
+    std::string label_;
+    std::vector< RecorderStream* > streams_; //!< one stream per thread, see open_streams()
+
+    //! per-thread aggregate series for every synapse model, created on first use
+    std::vector< std::vector< AggregateSeries >* > aggregates_;
+};
+
+/**
+ * @brief Recorder port of a connection, stored in the connection.
+ *
+ * Connections derive from this class to keep their recorder port as a
+ * member. Copies of a connection are not recorded, assignment copies the
+ * port. The thread is ignored.
+ *
+ * @see RecorderPortTable
+ */
+class RecorderPortMember
+{
+public:
+    typedef ConnectionDataLoggerBase::recorder_port recorder_port;
+
+    RecorderPortMember()
+    : recorder_port_(nest::invalid_index)
+    {
+    }
+
+    RecorderPortMember(const RecorderPortMember&)
+    : recorder_port_(nest::invalid_index)
+    {
+    }
+
+    recorder_port get_recorder_port(nest::thread) const
+    {
+        return recorder_port_;
+    }
+
+    void set_recorder_port(recorder_port port, nest::thread)
+    {
+        recorder_port_ = port;
+    }
+
+private:
+    recorder_port recorder_port_;
+};
+
+/**
+ * @brief Recorder port of a connection, stored in a side table.
+ *
+ * Drop-in replacement of RecorderPortMember that takes no memory in the
+ * connection. The ports of recorded connections are kept in one table per
+ * thread, keyed by the address of the connection. Copying, assignment and
+ * destruction keep the table in sync and have the same semantics as
+ * RecorderPortMember. They cost a lookup only once any connection was
+ * recorded.
+ *
+ * Within parallel regions, connections are accessed by the thread that owns
+ * them. Outside of parallel regions all tables are searched, unless the
+ * thread is given. A thread of -1 stands for the calling thread.
+ */
+class RecorderPortTable
+{
+public:
+    typedef ConnectionDataLoggerBase::recorder_port recorder_port;
+
+    RecorderPortTable()
+    {
+    }
+
+    RecorderPortTable(const RecorderPortTable&)
+    {
+    }
+
+    ~RecorderPortTable()
+    {
+        if (tables_)
+        {
+            assign(0);
+        }
+    }
+
+    RecorderPortTable& operator=(const RecorderPortTable& rhs)
+    {
+        if (tables_ && this != &rhs)
+        {
+            assign(&rhs);
+        }
+        return *this;
+    }
+
+    recorder_port get_recorder_port(nest::thread thread) const
+    {
+        return tables_ ? lookup(thread) : nest::invalid_index;
+    }
+
+    void set_recorder_port(recorder_port port, nest::thread thread);
+
+    static void clear();
+
+private:
+    typedef std::map< const RecorderPortTable*, recorder_port > PortMap;
+
+    recorder_port lookup(nest::thread thread) const;
+    void assign(const RecorderPortTable* rhs);
+
+    static nest::thread caller_thread(nest::thread thread);
+
+    static std::vector< PortMap >* tables_; //!< one table per thread, created on first use
 };
 
 /**
@@ -82,11 +343,17 @@ class ConnectionDataLogger : public ConnectionDataLoggerBase
 public:
     typedef double ( ConnectionType::*DataAccessFct )() const;
 
+    ConnectionDataLogger(const std::string& label);
+
     void register_recordable_variable(const Name& name, DataAccessFct data_access_fct);
-    void record(double time, ConnectionType const& host, recorder_port port);
+    void register_aggregate_variable(const Name& name, DataAccessFct data_access_fct);
+    void record(double time, ConnectionType const& host, recorder_port port, nest::thread thread);
+    void aggregate(double time, ConnectionType const& host, bool retracted, nest::synindex syn_id,
+                   nest::thread thread, size_t bins, const double* ranges);
 
 private:
     std::vector< DataAccessFct > data_access_fct_;
+    std::vector< DataAccessFct > aggregate_access_fct_;
 };
 
 
@@ -94,6 +361,17 @@ private:
 // ConnectionDataLogger implementation.
 //
 
+/**
+ * Constructor.
+ *
+ * @param label label of the logger, used to name stream files.
+ */
+template<typename ConnectionType>
+ConnectionDataLogger<ConnectionType>::ConnectionDataLogger(const std::string& label)
+: ConnectionDataLoggerBase(label)
+{
+}
+
 /**
  * Add a new recordable variable to the recorder object.
  *
@@ -108,6 +386,20 @@ void ConnectionDataLogger<ConnectionType>::register_recordable_variable(const Na
     data_access_fct_.push_back(data_access_fct);
 }
 
+/**
+ * Add a new aggregate variable to the recorder object.
+ *
+ * @param name name of the aggregate variable.
+ * @param data_access_fct pointer to the member function to retrieve the variable.
+ */
+template<typename ConnectionType>
+void ConnectionDataLogger<ConnectionType>::register_aggregate_variable(const Name& name,
+                                                                       DataAccessFct data_access_fct)
+{
+    aggregate_names_.push_back(name);
+    aggregate_access_fct_.push_back(data_access_fct);
+}
+
 /**
  * Record current variable values from the given host connection. Values are
  * recorded only if the last recording time is older than the recorder interval.
@@ -115,11 +407,13 @@ void ConnectionDataLogger<ConnectionType>::register_recordable_variable(const Na
  * @param time current time of recording.
  * @param host the host connection.
  * @param port the recorder port of the host connection.
+ * @param thread the thread of the host connection.
  */
 template<typename ConnectionType>
 void ConnectionDataLogger<ConnectionType>::record(double time_step,
                                                   ConnectionType const& host,
-                                                  recorder_port port)
+                                                  recorder_port port,
+                                                  nest::thread thread)
 {
     if (port == nest::invalid_index)
         return;
@@ -127,10 +421,27 @@ void ConnectionDataLogger<ConnectionType>::record(double time_step,
     assert(port < recorder_data_.size());
     ConnectionDataLoggerBase::RecorderData &recorder = *recorder_data_[port];
 
-    if (recorder.interval_ == 0)
+    if (recorder.interval_ == 0 || recorder.last_time_ + recorder.interval_ > time_step)
         return;
 
-    if (recorder.recorder_times_.empty() || (recorder.recorder_times_.back() + recorder.interval_ <= time_step))
+    recorder.last_time_ = time_step;
+
+    if (recorder.stream_)
+    {
+        RecorderStream* stream = get_stream(thread);
+        if (stream == 0)
+        {
+            // streaming was enabled after the simulation was prepared.
+            return;
+        }
+        stream->begin_record(port, time_step);
+        for (size_t i = 0; i < data_access_fct_.size(); i++)
+        {
+            stream->write(i, ((host).*(data_access_fct_[i]))());
+        }
+        stream->end_record();
+    }
+    else if (recorder.levels_.empty())
     {
         recorder.recorder_times_.push_back(time_step);
 
@@ -139,6 +450,58 @@ void ConnectionDataLogger<ConnectionType>::record(double time_step,
             recorder.recorder_values_[i].push_back(((host).*(data_access_fct_[i]))());
         }
     }
+    else
+    {
+        for (size_t i = 0; i < recorder.sample_.size(); i++)
+        {
+            recorder.sample_[i] = ((host).*(data_access_fct_[i]))();
+        }
+        recorder.levels_[0].push(time_step, &recorder.sample_[0], recorder.levels_, 0);
+    }
+}
+
+/**
+ * Add the current values of the aggregate variables of the given host
+ * connection to the aggregate statistics of its synapse model at the given
+ * time. Must be called from the thread of the host connection.
+ *
+ * @param time current time.
+ * @param host the host connection.
+ * @param retracted true if the host connection is retracted.
+ * @param syn_id the synapse model of the host connection.
+ * @param thread the thread of the host connection.
+ * @param bins number of histogram bins.
+ * @param ranges lower and upper histogram limits of all aggregate variables.
+ */
+template<typename ConnectionType>
+void ConnectionDataLogger<ConnectionType>::aggregate(double time,
+                                                     ConnectionType const& host,
+                                                     bool retracted,
+                                                     nest::synindex syn_id,
+                                                     nest::thread thread,
+                                                     size_t bins,
+                                                     const double* ranges)
+{
+    AggregateSeries& series = get_aggregate_series(syn_id, thread);
+
+    // connections of a thread are mostly updated over the same time range,
+    // so the latest time point is checked first.
+    AggregateSeries::iterator it = series.empty() ? series.end() : --series.end();
+    if (it == series.end() || it->first != time)
+    {
+        it = series.find(time);
+    }
+    if (it == series.end())
+    {
+        it = series.insert(std::make_pair(time, AggregateData(aggregate_access_fct_.size(), bins, ranges))).first;
+    }
+
+    AggregateData& data = it->second;
+    data.add_sample(retracted);
+    for (size_t i = 0; i < aggregate_access_fct_.size(); i++)
+    {
+        data.add_value(i, ((host).*(aggregate_access_fct_[i]))());
+    }
 }
 
 }
@@ -25,10 +25,18 @@
  */
 
 #include "connection_updater.h"
+#include "connection_data_logger.h"
+#include "tracing_node.h"
+#include "spore_names.h"
 
 #include "common_synapse_properties.h"
 #include "connector_base.h"
 #include "genericmodel.h"
+#include "dictutils.h"
+#include "arraydatum.h"
+
+#include <algorithm>
+#include <map>
 
 namespace spore
 {
@@ -42,7 +50,12 @@ interval_(-1.0),
 cu_model_id_(nest::invalid_index),
 cu_id_(nest::invalid_index),
 has_connections_(false),
-is_initialized_(false)
+is_initialized_(false),
+deferred_registration_(false),
+target_ordered_(false),
+learning_frozen_(false),
+compaction_interval_(0),
+compaction_threshold_(0.5)
 {
 }
 
@@ -79,6 +92,17 @@ void ConnectionUpdateManager::setup(long interval, long acceptable_latency)
         connectors_.resize(num_threads);
         used_models_.resize(num_threads);
         garbage_pile_.resize(num_threads);
+        deferred_log_.resize(num_threads);
+        is_deferred_.resize(num_threads, 0);
+        schedules_.resize(num_threads);
+        schedule_valid_.resize(num_threads, 0);
+        dormant_.resize(num_threads);
+        promotion_time_.resize(num_threads, -1.0);
+        pruned_.resize(num_threads);
+        collected_pruned_.resize(num_threads, 0);
+        updates_since_compaction_.resize(num_threads, 0);
+        compaction_due_.resize(num_threads, 0);
+        reclaimed_bytes_.resize(num_threads, 0);
     }
     else
     {
@@ -121,6 +145,41 @@ void ConnectionUpdateManager::update(const nest::Time& time, nest::thread th)
 
     const double t_trig = time.get_ms() - nest::Time::delay_steps_to_ms(acceptable_latency_);
 
+    if (target_ordered_)
+    {
+        update_target_ordered(time, t_trig, th);
+    }
+    else
+    {
+        update_connectors(time, t_trig, th);
+    }
+
+    if (compaction_interval_ > 0 && ++updates_since_compaction_[th] >= compaction_interval_)
+    {
+        updates_since_compaction_[th] = 0;
+        compaction_due_[th] = 1;
+    }
+
+    execute_garbage_collector(th);
+    update_dormant(time, th);
+
+    if (compaction_due_[th])
+    {
+        compact(th);
+        compaction_due_[th] = 0;
+    }
+}
+
+/**
+ * Advance all connectors of the given thread that were last updated
+ * before \a t_trig to the given time.
+ *
+ * @param time the time point to advance to.
+ * @param t_trig connectors last updated before this time are advanced.
+ * @param th the thread of the calling node.
+ */
+void ConnectionUpdateManager::update_connectors(const nest::Time& time, double t_trig, nest::thread th)
+{
     SynapseUpdateEvent ev;
     ev.set_stamp(time);
 
@@ -141,8 +200,183 @@ void ConnectionUpdateManager::update(const nest::Time& time, nest::thread th)
             it->get_connector()->send(ev, th, models);
         }
     }
+}
+
+/**
+ * Advance all connectors of the given thread that were last updated
+ * before \a t_trig to the given time, in the order of the targets of
+ * their synapses (see set_target_ordered()).
+ *
+ * @param time the time point to advance to.
+ * @param t_trig connectors last updated before this time are advanced.
+ * @param th the thread of the calling node.
+ */
+void ConnectionUpdateManager::update_target_ordered(const nest::Time& time, double t_trig, nest::thread th)
+{
+    if (!schedule_valid_[th])
+    {
+        build_schedules(th);
+    }
 
-    execute_garbage_collector(th);
+    std::vector<TargetSchedule>& schedules = schedules_[th];
+
+    for (std::vector<TargetSchedule>::iterator it = schedules.begin(); it != schedules.end(); it++)
+    {
+        bool any_due = false;
+        for (size_t c = 0; c < it->connectors_.size(); c++)
+        {
+            it->due_[c] = (t_trig > it->connectors_[c]->get_t_lastspike());
+            any_due = any_due || it->due_[c];
+        }
+
+        if (!any_due)
+        {
+            continue;
+        }
+
+        it->model_->update_schedule(*it, time, th);
+
+        for (size_t c = 0; c < it->connectors_.size(); c++)
+        {
+            if (it->due_[c])
+            {
+                it->connectors_[c]->set_t_lastspike(time.get_ms());
+            }
+        }
+    }
+}
+
+/**
+ * Rebuild the update schedules of the given thread, one for each synapse
+ * model in use. Called lazily after connectors of the thread have changed.
+ *
+ * @param th the thread of the calling node.
+ */
+void ConnectionUpdateManager::build_schedules(nest::thread th)
+{
+    std::vector<nest::ConnectorModel*> models = nest::kernel().model_manager.get_synapse_prototypes(th);
+
+    std::vector<TargetSchedule>& schedules = schedules_[th];
+    schedules.clear();
+
+    std::map<nest::synindex, size_t> index;
+
+    for (std::set<ConnectionEntry>::iterator it = connectors_[th].begin();
+            it != connectors_[th].end();
+            it++)
+    {
+        const nest::synindex syn_id = it->get_connector()->get_syn_id();
+
+        std::map<nest::synindex, size_t>::iterator idx = index.find(syn_id);
+        if (idx == index.end())
+        {
+            DiligentConnectorModelBase* model = dynamic_cast<DiligentConnectorModelBase*> (models[syn_id]);
+            assert(model);
+            idx = index.insert(std::make_pair(syn_id, schedules.size())).first;
+            schedules.push_back(TargetSchedule());
+            schedules.back().model_ = model;
+        }
+
+        TargetSchedule& schedule = schedules[idx->second];
+        schedule.connectors_.push_back(it->get_connector());
+        schedule.senders_.push_back(&it->get_sender());
+    }
+
+    for (std::vector<TargetSchedule>::iterator it = schedules.begin(); it != schedules.end(); it++)
+    {
+        it->due_.resize(it->connectors_.size(), 0);
+        it->model_->build_schedule(*it, th);
+    }
+
+    schedule_valid_[th] = 1;
+}
+
+/**
+ * Advance the dormant synapses of the given thread to the given time. Their
+ * synapse models turn synapses that became active into connections again.
+ *
+ * @param time the time point to advance to.
+ * @param th the thread of the calling node.
+ */
+void ConnectionUpdateManager::update_dormant(const nest::Time& time, nest::thread th)
+{
+    std::map<nest::synindex, DormantPool>& pools = dormant_[th];
+
+    if (pools.empty())
+    {
+        return;
+    }
+
+    std::vector<nest::ConnectorModel*> models = nest::kernel().model_manager.get_synapse_prototypes(th);
+
+    promotion_time_[th] = time.get_ms();
+
+    for (std::map<nest::synindex, DormantPool>::iterator it = pools.begin(); it != pools.end(); it++)
+    {
+        DiligentConnectorModelBase* model = dynamic_cast<DiligentConnectorModelBase*> (models[it->first]);
+        assert(model);
+        model->update_dormant(it->second, time, th, it->first);
+    }
+
+    promotion_time_[th] = -1.0;
+}
+
+/**
+ * Shrink the given vector to fit its content if less than the given
+ * fraction of its capacity is in use.
+ *
+ * @return the number of released bytes.
+ */
+template < typename T >
+static size_t shrink_to_fit(std::vector< T >& v, double threshold)
+{
+    const size_t capacity = v.capacity();
+    if (v.size() >= threshold * capacity)
+    {
+        return 0;
+    }
+
+    std::vector< T >(v).swap(v);
+    return (capacity - v.capacity()) * sizeof (T);
+}
+
+/**
+ * Shrink the garbage pile, the update schedules and the dormant synapses of
+ * the given thread (see set_compaction()). Pools without dormant synapses
+ * are removed.
+ *
+ * @param th the thread of the calling node.
+ */
+void ConnectionUpdateManager::compact(nest::thread th)
+{
+    size_t reclaimed = shrink_to_fit(garbage_pile_[th], compaction_threshold_);
+
+    for (std::vector<TargetSchedule>::iterator it = schedules_[th].begin(); it != schedules_[th].end(); it++)
+    {
+        reclaimed += shrink_to_fit(it->connectors_, compaction_threshold_);
+        reclaimed += shrink_to_fit(it->senders_, compaction_threshold_);
+        reclaimed += shrink_to_fit(it->due_, compaction_threshold_);
+        reclaimed += shrink_to_fit(it->entries_, compaction_threshold_);
+    }
+
+    std::map<nest::synindex, DormantPool>& pools = dormant_[th];
+    for (std::map<nest::synindex, DormantPool>::iterator it = pools.begin(); it != pools.end();)
+    {
+        if (it->second.synapses_.empty() && it->second.pending_.empty())
+        {
+            reclaimed += it->second.synapses_.capacity() * sizeof (DormantSynapse) +
+                         it->second.pending_.capacity() * sizeof (std::pair<DormantSynapse, long>);
+            pools.erase(it++);
+        }
+        else
+        {
+            reclaimed += shrink_to_fit(it->second.synapses_, compaction_threshold_);
+            reclaimed += shrink_to_fit(it->second.pending_, compaction_threshold_);
+            it++;
+        }
+    }
+
+    reclaimed_bytes_[th] += reclaimed;
 }
 
 /**
@@ -150,6 +384,8 @@ void ConnectionUpdateManager::update(const nest::Time& time, nest::thread th)
  * can be 0; in that case only the old one is removed. The old
  * connector can be 0; in that case only the new one is added.
  * If new_conn is not 0 it must be a homogeneous connector model.
+ * Registration is deferred if requested (see set_deferred_registration()),
+ * except while dormant synapses are turned into connections.
  *
  * @param: new_conn the connector object to be added.
  * @param: old_conn the old connector object to be removed.
@@ -166,6 +402,44 @@ void ConnectionUpdateManager::register_connector(nest::ConnectorBase* new_conn,
                                 " to 'Connect'! Maybe you forgot to call 'InitSynapseUpdater'?");
     }
 
+    // dormant synapses are turned into connections during the simulation,
+    // after NEST has already freed the old connector. Such connectors must
+    // be replaced in the update set right away.
+    const bool promoting = promotion_time_[th] >= 0.0;
+    const bool deferred = (deferred_registration_ || is_deferred_[th]) && !promoting;
+
+    schedule_valid_[th] = 0;
+
+    if (promoting && !deferred_log_[th].empty())
+    {
+        collect_deferred_connectors(th);
+    }
+
+    if (deferred && sender_gid == nest::invalid_index)
+    {
+        // a connection is deleted. The sender is only known if the old
+        // connector has been registered.
+        collect_deferred_connectors(th);
+    }
+    else if (deferred)
+    {
+        if (new_conn != old_conn)
+        {
+            if (old_conn)
+            {
+                deferred_log_[th].push_back(DeferredEntry(old_conn, 0, false));
+            }
+            if (new_conn)
+            {
+                assert(new_conn->homogeneous_model());
+                deferred_log_[th].push_back(DeferredEntry(new_conn, nest::kernel().node_manager.get_node(sender_gid),
+                                                          true));
+            }
+        }
+        has_connections_ = true;
+        return;
+    }
+
     used_models_[th].insert(syn_id);
 
     std::set<ConnectionEntry> &conns = connectors_[th];
@@ -205,6 +479,460 @@ void ConnectionUpdateManager::register_connector(nest::ConnectorBase* new_conn,
     has_connections_ = true;
 }
 
+/**
+ * Register all connectors of thread \a th that were created or changed while
+ * registration was deferred. The log is sorted by connector, such that all
+ * changes of a connector are adjacent and in the order of their occurrence.
+ * A connector that was removed first was registered before and is erased,
+ * a connector that was added last is still alive and is registered.
+ */
+void ConnectionUpdateManager::collect_deferred_connectors(nest::thread th)
+{
+    std::vector<DeferredEntry>& log = deferred_log_[th];
+
+    if (log.empty())
+    {
+        return;
+    }
+
+    std::stable_sort(log.begin(), log.end());
+    schedule_valid_[th] = 0;
+
+    std::set<ConnectionEntry>& conns = connectors_[th];
+
+    size_t first = 0;
+    while (first < log.size())
+    {
+        size_t last = first;
+        while (last + 1 < log.size() && log[last + 1].connector_ == log[first].connector_)
+        {
+            last++;
+        }
+
+        if (!log[first].insert_)
+        {
+            conns.erase(ConnectionEntry(log[first].connector_));
+        }
+
+        if (log[last].insert_)
+        {
+            assert(log[last].sender_);
+            conns.insert(ConnectionEntry(log[last].connector_, log[last].sender_));
+            used_models_[th].insert(log[last].connector_->get_syn_id());
+        }
+
+        first = last + 1;
+    }
+
+    std::vector<DeferredEntry>().swap(log);
+}
+
+/**
+ * Defer the registration of connectors of thread \a th until
+ * end_deferred_registration() is called. Connectors of the thread must not
+ * be accessed through the update manager in the meantime. Must be called
+ * by the thread \a th after the update manager was set up (see is_valid()).
+ */
+void ConnectionUpdateManager::begin_deferred_registration(nest::thread th)
+{
+    assert(is_valid());
+    assert(static_cast<size_t>(th) < is_deferred_.size());
+    assert(!is_deferred_[th]);
+    is_deferred_[th] = 1;
+}
+
+/**
+ * Register all connectors of thread \a th that were created or changed
+ * since begin_deferred_registration() was called. Must be called by the
+ * thread \a th.
+ */
+void ConnectionUpdateManager::end_deferred_registration(nest::thread th)
+{
+    assert(is_deferred_[th]);
+
+    is_deferred_[th] = 0;
+
+    if (!deferred_registration_)
+    {
+        collect_deferred_connectors(th);
+    }
+}
+
+/**
+ * Defer the registration of connectors of all threads during network
+ * construction. Switching deferred registration off registers all deferred
+ * connectors. Otherwise they are registered when the simulation is
+ * calibrated. This function is invoked by the \a SetSporeStatus SLI function.
+ *
+ * @note This function may not be thread safe.
+ */
+void ConnectionUpdateManager::set_deferred_registration(bool deferred)
+{
+    deferred_registration_ = deferred;
+
+    if (!deferred_registration_)
+    {
+        for (size_t th = 0; th < deferred_log_.size(); th++)
+        {
+            collect_deferred_connectors(th);
+        }
+    }
+}
+
+/**
+ * Freeze or resume learning. While learning is frozen the update manager
+ * does not update connections and tracing nodes do not write their traces.
+ * Connections are brought up to date to the time when learning was frozen
+ * on the start of the next simulation. Resuming learning records the
+ * current time as the time when learning was resumed. This function is invoked by the \a SetSporeStatus SLI
+ * function.
+ *
+ * @note This function may not be thread safe.
+ */
+void ConnectionUpdateManager::set_learning_frozen(bool frozen)
+{
+    if (!learning_frozen_ && frozen)
+    {
+        learning_frozen_at_ = get_origin();
+    }
+    else if (learning_frozen_ && !frozen)
+    {
+        learning_resumed_ = get_origin();
+    }
+
+    learning_frozen_ = frozen;
+    TracingNode::freeze_traces(frozen);
+}
+
+/**
+ * Update the synapses of each thread in the order of their targets instead
+ * of connector by connector. This function is invoked by the
+ * \a SetSporeStatus SLI function.
+ *
+ * @note This function may not be thread safe.
+ */
+void ConnectionUpdateManager::set_target_ordered(bool target_ordered)
+{
+    target_ordered_ = target_ordered;
+
+    if (!target_ordered_)
+    {
+        // release the memory of the schedules.
+        for (size_t th = 0; th < schedules_.size(); th++)
+        {
+            std::vector<TargetSchedule>().swap(schedules_[th]);
+            schedule_valid_[th] = 0;
+        }
+    }
+}
+
+/**
+ * Compact connectors and buffers every \a interval updates of a thread,
+ * see the class documentation. An interval of 0 disables compaction. This
+ * function is invoked by the \a SetSporeStatus SLI function.
+ *
+ * @param interval number of updates between compaction passes.
+ * @param threshold connectors with a smaller fraction of remaining synapses are compacted.
+ *
+ * @note This function may not be thread safe.
+ */
+void ConnectionUpdateManager::set_compaction(long interval, double threshold)
+{
+    if (interval < 0)
+    {
+        throw nest::BadProperty("compaction_interval must be larger or equal to 0.");
+    }
+
+    if (threshold <= 0.0 || threshold > 1.0)
+    {
+        throw nest::BadProperty("compaction_threshold must be in the interval (0, 1].");
+    }
+
+    compaction_interval_ = interval;
+    compaction_threshold_ = threshold;
+
+    if (interval == 0)
+    {
+        for (size_t th = 0; th < pruned_.size(); th++)
+        {
+            pruned_[th].clear();
+        }
+    }
+}
+
+/**
+ * Notify the update manager that the memory of the connector, which the
+ * garbage collector of thread \a th is removing a synapse from, was
+ * reclaimed by compaction or because the connector was deleted. Called by
+ * the connector models.
+ *
+ * @param th the thread of the connector.
+ * @param reclaimed_bytes the released memory.
+ */
+void ConnectionUpdateManager::connector_reclaimed(nest::thread th, size_t reclaimed_bytes)
+{
+    assert(static_cast<size_t>(th) < collected_pruned_.size());
+    collected_pruned_[th] = 0;
+    reclaimed_bytes_[th] += reclaimed_bytes;
+}
+
+/**
+ * Check if connections are left after connections were deleted. If none
+ * are left, the ConnectionUpdater nodes are frozen in the next simulation.
+ *
+ * @note This function may not be thread safe.
+ */
+void ConnectionUpdateManager::check_connections()
+{
+    has_connections_ = false;
+    for (size_t th = 0; th < connectors_.size(); th++)
+    {
+        has_connections_ = has_connections_ || !connectors_[th].empty() || !deferred_log_[th].empty() ||
+                           !dormant_[th].empty();
+    }
+}
+
+/**
+ * Retrieve the status of the update manager. The number of connectors
+ * includes connectors whose registration is deferred.
+ */
+void ConnectionUpdateManager::get_status(DictionaryDatum& d) const
+{
+    long num_connectors = 0;
+    long reclaimed = 0;
+    for (size_t th = 0; th < connectors_.size(); th++)
+    {
+        reclaimed += reclaimed_bytes_[th];
+
+        num_connectors += connectors_[th].size();
+        for (std::vector<DeferredEntry>::const_iterator it = deferred_log_[th].begin();
+             it != deferred_log_[th].end();
+             it++)
+        {
+            num_connectors += it->insert_ ? 1 : -1;
+        }
+    }
+
+    def<long>(d, names::update_interval, interval_);
+    def<long>(d, names::acceptable_latency, acceptable_latency_);
+    def<bool>(d, names::deferred_registration, deferred_registration_);
+    def<bool>(d, names::learning_frozen, learning_frozen_);
+    def<bool>(d, names::target_ordered_updates, target_ordered_);
+    def<long>(d, names::num_connectors, num_connectors);
+    def<long>(d, names::num_dormant_synapses, get_num_dormant());
+    def<long>(d, names::compaction_interval, compaction_interval_);
+    def<double>(d, names::compaction_threshold, compaction_threshold_);
+    def<long>(d, names::estimated_reclaimed_bytes, reclaimed);
+}
+
+/**
+ * Estimated memory of a node of std::set beyond its value: the color and
+ * the pointers to the parent and both children.
+ */
+static const size_t set_node_overhead = 4 * sizeof (void*);
+
+/**
+ * Add \a bytes to the entry \a name of the dictionary.
+ */
+static void add_bytes(DictionaryDatum& d, const Name& name, long bytes)
+{
+    long value = 0;
+    updateValue<long>(d, name, value);
+    def<long>(d, name, value + bytes);
+}
+
+/**
+ * Add the number and memory of synapses of a synapse model to the
+ * dictionary of synapse models.
+ */
+static void add_synapses(DictionaryDatum& synapses, const std::string& model, long n, long bytes)
+{
+    if (!synapses->known(model))
+    {
+        DictionaryDatum entry(new Dictionary);
+        def<long>(entry, names::num_synapses, 0);
+        def<long>(entry, names::synapse_bytes, 0);
+        def<DictionaryDatum>(synapses, model, entry);
+    }
+
+    DictionaryDatum entry = getValue<DictionaryDatum>(synapses, model);
+    add_bytes(entry, names::num_synapses, n);
+    add_bytes(entry, names::synapse_bytes, bytes);
+}
+
+/**
+ * Retrieve the memory used by SPORE objects, for each thread in the array
+ * \a threads and summed up in \a total. Synapses are counted for each
+ * diligent synapse model in \a synapses, with the size of the synapse as
+ * reported by \a size_of. Traces include the replicas of tracing nodes.
+ * The update schedule includes the set of registered connectors, with the
+ * node overhead of the tree that holds them. Recorders are not assigned to
+ * threads and are only reported in the total. The memory of NEST's
+ * connectors beyond their synapses is not included.
+ *
+ * All figures are estimates computed from the sizes and capacities of the
+ * containers. Allocator overhead, and the overhead of tree nodes that the
+ * C++ library does not expose, can only be approximated. Nodes are visited
+ * once, except for nodes without proxies (devices), which are visited on
+ * every thread. The
+ * total also reports the memory released by compaction so far as
+ * \a estimated_reclaimed_bytes, where the memory of compacted connectors is
+ * estimated from the number of removed synapses.
+ *
+ * @note This function is not thread safe.
+ */
+void ConnectionUpdateManager::get_memory_status(DictionaryDatum& d)
+{
+    DictionaryDatum total(new Dictionary);
+    DictionaryDatum total_synapses(new Dictionary);
+    ArrayDatum threads;
+
+    const Name categories[] = { names::synapse_bytes, names::trace_bytes, names::schedule_bytes,
+                                names::garbage_pile_bytes, names::dormant_bytes };
+    const size_t num_categories = sizeof (categories) / sizeof (categories[0]);
+
+    for (size_t c = 0; c < num_categories; c++)
+    {
+        def<long>(total, categories[c], 0);
+    }
+
+    // visit every node once on the thread that owns it
+    std::vector<long> thread_trace_bytes(connectors_.size(), 0);
+    for (nest::index gid = 1; gid < nest::kernel().node_manager.size(); gid++)
+    {
+        const nest::thread owner = nest::kernel().vp_manager.vp_to_thread(nest::kernel().vp_manager.suggest_vp(gid));
+        nest::Node* node = nest::kernel().node_manager.get_node(gid, owner);
+        const size_t num_visits = node->has_proxies() ? 1 : connectors_.size();
+
+        for (size_t th = 0; th < num_visits; th++)
+        {
+            if (!node->has_proxies())
+            {
+                node = nest::kernel().node_manager.get_node(gid, th);
+            }
+
+            TracingNode* tracing_node = dynamic_cast<TracingNode*>(node);
+            if (tracing_node != 0 && nest::kernel().node_manager.is_local_node(node) &&
+                static_cast<size_t>(node->get_thread()) < thread_trace_bytes.size() &&
+                (node->has_proxies() || node->get_thread() == static_cast<nest::thread>(th)))
+            {
+                thread_trace_bytes[node->get_thread()] += tracing_node->get_trace_bytes();
+            }
+        }
+    }
+
+    for (size_t th = 0; th < connectors_.size(); th++)
+    {
+        collect_deferred_connectors(th);
+
+        std::vector<nest::ConnectorModel*> models = nest::kernel().model_manager.get_synapse_prototypes(th);
+
+        std::map<nest::synindex, long> num_synapses;
+        for (std::set<ConnectionEntry>::const_iterator it = connectors_[th].begin();
+                it != connectors_[th].end();
+                it++)
+        {
+            num_synapses[it->get_connector()->get_syn_id()] += it->get_connector()->get_num_connections();
+        }
+
+        DictionaryDatum synapses(new Dictionary);
+        long synapse_bytes = 0;
+        for (std::map<nest::synindex, long>::const_iterator it = num_synapses.begin(); it != num_synapses.end(); it++)
+        {
+            DiligentConnectorModelBase* model = dynamic_cast<DiligentConnectorModelBase*> (models[it->first]);
+            assert(model);
+            const long bytes = it->second * model->get_synapse_size();
+            add_synapses(synapses, models[it->first]->get_name(), it->second, bytes);
+            add_synapses(total_synapses, models[it->first]->get_name(), it->second, bytes);
+            synapse_bytes += bytes;
+        }
+
+        const long trace_bytes = thread_trace_bytes[th];
+
+        long schedule_bytes = connectors_[th].size() * (sizeof (ConnectionEntry) + set_node_overhead) +
+                              deferred_log_[th].capacity() * sizeof (DeferredEntry) +
+                              schedules_[th].capacity() * sizeof (TargetSchedule);
+        for (std::vector<TargetSchedule>::const_iterator it = schedules_[th].begin(); it != schedules_[th].end(); it++)
+        {
+            schedule_bytes += it->connectors_.capacity() * sizeof (nest::ConnectorBase*) +
+                              it->senders_.capacity() * sizeof (nest::Node*) +
+                              it->due_.capacity() * sizeof (char) +
+                              it->entries_.capacity() * sizeof (TargetSchedule::Entry);
+        }
+
+        long dormant_bytes = 0;
+        for (std::map<nest::synindex, DormantPool>::const_iterator it = dormant_[th].begin();
+             it != dormant_[th].end();
+             it++)
+        {
+            dormant_bytes += sizeof (DormantPool) +
+                             it->second.synapses_.capacity() * sizeof (DormantSynapse) +
+                             it->second.pending_.capacity() * sizeof (std::pair<DormantSynapse, long>);
+        }
+
+        const long bytes[] = { synapse_bytes, trace_bytes, schedule_bytes,
+                               static_cast<long>(garbage_pile_[th].capacity() * sizeof (GarbageCollectorEntry)),
+                               dormant_bytes };
+
+        DictionaryDatum thread_status(new Dictionary);
+        def<DictionaryDatum>(thread_status, names::synapses, synapses);
+        long thread_bytes = 0;
+        for (size_t c = 0; c < num_categories; c++)
+        {
+            def<long>(thread_status, categories[c], bytes[c]);
+            add_bytes(total, categories[c], bytes[c]);
+            thread_bytes += bytes[c];
+        }
+        def<long>(thread_status, names::total_bytes, thread_bytes);
+        threads.push_back(thread_status);
+    }
+
+    const long recorder_bytes = ConnectionDataLoggerBase::get_recorder_bytes();
+    long total_bytes = recorder_bytes;
+    for (size_t c = 0; c < num_categories; c++)
+    {
+        total_bytes += getValue<long>(total, categories[c]);
+    }
+
+    def<DictionaryDatum>(total, names::synapses, total_synapses);
+    def<long>(total, names::recorder_bytes, recorder_bytes);
+    def<long>(total, names::total_bytes, total_bytes);
+
+    long reclaimed = 0;
+    for (size_t th = 0; th < reclaimed_bytes_.size(); th++)
+    {
+        reclaimed += reclaimed_bytes_[th];
+    }
+    def<long>(total, names::estimated_reclaimed_bytes, reclaimed);
+
+    def<ArrayDatum>(d, names::threads, threads);
+    def<DictionaryDatum>(d, names::total, total);
+}
+
+/**
+ * Set the status of the update manager.
+ */
+void ConnectionUpdateManager::set_status(const DictionaryDatum& d)
+{
+    bool deferred = deferred_registration_;
+    updateValue<bool>(d, names::deferred_registration, deferred);
+    set_deferred_registration(deferred);
+
+    bool frozen = learning_frozen_;
+    updateValue<bool>(d, names::learning_frozen, frozen);
+    set_learning_frozen(frozen);
+
+    bool target_ordered = target_ordered_;
+    updateValue<bool>(d, names::target_ordered_updates, target_ordered);
+    set_target_ordered(target_ordered);
+
+    long interval = compaction_interval_;
+    double threshold = compaction_threshold_;
+    updateValue<long>(d, names::compaction_interval, interval);
+    updateValue<double>(d, names::compaction_threshold, threshold);
+    set_compaction(interval, threshold);
+}
+
 /**
  * Trigger garbage collector for given connection.
  */
@@ -216,7 +944,68 @@ void ConnectionUpdateManager::trigger_garbage_collector(nest::index target_gid,
 }
 
 /**
- * Execute the garbage collector for the given thread.
+ * Keep a retracted synapse as dormant synapse. The synapse must also
+ * trigger the garbage collector to remove its connection.
+ *
+ * @param synapse the state of the synapse.
+ * @param step time step at which the state of the synapse is up to date.
+ * @param target_thread the thread of the synapse.
+ * @param syn_id the synapse model.
+ */
+void ConnectionUpdateManager::demote_synapse(const DormantSynapse& synapse, long step,
+                                             nest::thread target_thread, nest::synindex syn_id)
+{
+    assert(nest::thread(dormant_.size()) > target_thread);
+    dormant_[target_thread][syn_id].pending_.push_back(std::make_pair(synapse, step));
+}
+
+/**
+ * Remove the dormant synapses of the given synapse model on all threads,
+ * e.g. when the synapses of the model are replaced by other connections.
+ * Call check_connections() afterwards.
+ *
+ * @note This function is not thread safe.
+ *
+ * @param syn_id the synapse model.
+ * @return the number of removed dormant synapses.
+ */
+size_t ConnectionUpdateManager::drop_dormant(nest::synindex syn_id)
+{
+    size_t dropped = 0;
+    for (size_t th = 0; th < dormant_.size(); th++)
+    {
+        std::map<nest::synindex, DormantPool>::iterator it = dormant_[th].find(syn_id);
+        if (it != dormant_[th].end())
+        {
+            dropped += it->second.synapses_.size() + it->second.pending_.size();
+            dormant_[th].erase(it);
+        }
+    }
+    return dropped;
+}
+
+/**
+ * @return the number of dormant synapses of all threads, including
+ *         synapses that were demoted in the current update interval.
+ */
+size_t ConnectionUpdateManager::get_num_dormant() const
+{
+    size_t num_dormant = 0;
+    for (size_t th = 0; th < dormant_.size(); th++)
+    {
+        for (std::map<nest::synindex, DormantPool>::const_iterator it = dormant_[th].begin();
+             it != dormant_[th].end();
+             it++)
+        {
+            num_dormant += it->second.synapses_.size() + it->second.pending_.size();
+        }
+    }
+    return num_dormant;
+}
+
+/**
+ * Execute the garbage collector for the given thread. If compaction is
+ * enabled, the removed synapses are counted for each connector.
  */
 void ConnectionUpdateManager::execute_garbage_collector(nest::thread th)
 {
@@ -225,13 +1014,33 @@ void ConnectionUpdateManager::execute_garbage_collector(nest::thread th)
         return;
     }
 
+    typedef std::map< std::pair< nest::index, nest::synindex >, size_t > PrunedMap;
+
     for ( std::vector<GarbageCollectorEntry>::const_iterator it = garbage_pile_[th].begin();
           it != garbage_pile_[th].end();
           it++ )
     {
         nest::Node* target = nest::kernel().node_manager.get_node(it->get_target_gid());
         assert(target);
-        nest::kernel().connection_manager.disconnect( *target, it->get_sender_gid(), th, it->get_syn_id() );
+
+        if (compaction_interval_ > 0)
+        {
+            PrunedMap::iterator pruned = pruned_[th].insert(
+                    std::make_pair(std::make_pair(it->get_sender_gid(), it->get_syn_id()), 0)).first;
+            collected_pruned_[th] = ++pruned->second;
+
+            nest::kernel().connection_manager.disconnect( *target, it->get_sender_gid(), th, it->get_syn_id() );
+
+            if (collected_pruned_[th] == 0)
+            {
+                pruned_[th].erase(pruned);
+            }
+            collected_pruned_[th] = 0;
+        }
+        else
+        {
+            nest::kernel().connection_manager.disconnect( *target, it->get_sender_gid(), th, it->get_syn_id() );
+        }
     }
     garbage_pile_[th].clear();
 }
@@ -239,6 +1048,8 @@ void ConnectionUpdateManager::execute_garbage_collector(nest::thread th)
 /**
  * Calibrates all registered connection models. This should be called
  * by the updater nodes when they are calibrated on simulation startup.
+ * The recorder streams of the thread are opened here, such that no file
+ * is opened while connections record.
  *
  * @param: th the thread of the calling node.
  */
@@ -246,6 +1057,13 @@ void ConnectionUpdateManager::calibrate(nest::thread th)
 {
     nest::TimeConverter tc;
 
+    ConnectionDataLoggerBase::open_streams(th);
+
+    if (static_cast<size_t>(th) < deferred_log_.size())
+    {
+        collect_deferred_connectors(th);
+    }
+
     std::vector<nest::ConnectorModel*> models = nest::kernel().model_manager.get_synapse_prototypes( th );
 
     for (std::set<nest::synindex>::const_iterator it = used_models_[th].begin();
@@ -260,18 +1078,32 @@ void ConnectionUpdateManager::calibrate(nest::thread th)
         throw nest::BadProperty("Connection update manager was not set up correctly before the call"
                                 " to 'Simulate'! Maybe you forgot to call 'InitSynapseUpdater'?");
     }
+
+    if (learning_frozen_ && has_connections_ && get_origin() == learning_frozen_at_)
+    {
+        // learning was frozen now, bring all connections up to date first.
+        update_connectors(learning_frozen_at_, learning_frozen_at_.get_ms(), th);
+    }
 }
 
 /**
  * Finalize the connection update manager. This should be called
  * by the updater nodes when they are finalized. This will execute
- * the garbage collector.
+ * the garbage collector and flush the recorder streams of the thread.
+ * If compaction is enabled, thread 0 also compacts the recorder vectors.
  *
  * @param: th the thread of the calling node.
  */
 void ConnectionUpdateManager::finalize(nest::thread th)
 {
     execute_garbage_collector(th);
+    ConnectionDataLoggerBase::flush_streams(th);
+
+    if (compaction_interval_ > 0 && th == 0 && !reclaimed_bytes_.empty())
+    {
+        // no connection records while the nodes are finalized.
+        reclaimed_bytes_[th] += ConnectionDataLoggerBase::compact(compaction_threshold_);
+    }
 }
 
 /**
@@ -292,7 +1124,8 @@ void ConnectionUpdateManager::prepare()
 
 /**
  * Reset the ConnectionUpdateManager. Removes all connectors that have
- * been registered.
+ * been registered and all dormant synapses, closes all recorder streams
+ * and deletes all aggregates and recorder ports. Compaction is disabled.
  *
  * This function may not be thread safe.
  */
@@ -303,7 +1136,29 @@ void ConnectionUpdateManager::reset()
     connectors_.clear();
     used_models_.clear();
     garbage_pile_.clear();
+    deferred_log_.clear();
+    is_deferred_.clear();
+    schedules_.clear();
+    schedule_valid_.clear();
+    dormant_.clear();
+    promotion_time_.clear();
+    pruned_.clear();
+    collected_pruned_.clear();
+    updates_since_compaction_.clear();
+    compaction_due_.clear();
+    reclaimed_bytes_.clear();
+    compaction_interval_ = 0;
+    compaction_threshold_ = 0.5;
+    target_ordered_ = false;
+    deferred_registration_ = false;
+    learning_frozen_ = false;
+    learning_frozen_at_ = nest::Time();
+    learning_resumed_ = nest::Time();
+    TracingNode::freeze_traces(false);
     cu_id_ = nest::invalid_index;
+    ConnectionDataLoggerBase::close_streams();
+    ConnectionDataLoggerBase::clear_aggregates();
+    RecorderPortTable::clear();
 }
 
 /**
@@ -381,14 +1236,16 @@ void ConnectionUpdater::update(nest::Time const& origin, const long from, const
 
 /**
  * Called when a simulation is about to be started. This Will set the node
- * frozen if the ConnectionUpdateManager does not need updates.
+ * frozen if the ConnectionUpdateManager does not need updates or learning
+ * is frozen.
  */
 void ConnectionUpdater::calibrate()
 {
     ConnectionUpdateManager::instance()->calibrate(get_thread());
 
     set_frozen_(!ConnectionUpdateManager::instance()->is_valid() ||
-                !ConnectionUpdateManager::instance()->has_connections());
+                !ConnectionUpdateManager::instance()->has_connections() ||
+                ConnectionUpdateManager::instance()->is_learning_frozen());
 }
 
 /**
@@ -29,6 +29,11 @@
 
 #include <vector>
 #include <set>
+#include <map>
+#include <algorithm>
+#include <utility>
+
+#include <stdint.h>
 
 #include "spore.h"
 
@@ -46,6 +51,107 @@
 namespace spore
 {
 
+class DiligentConnectorModelBase;
+
+/**
+ * @brief Order in which the synapses of one synapse model on one thread are updated.
+ *
+ * Synapses are identified by the index of their connector and their port.
+ * The entries are sorted by the GID of the targets of the synapses, such
+ * that synapses that share a target are updated back to back.
+ */
+struct TargetSchedule
+{
+    /**
+     * @brief Synapse in the schedule.
+     */
+    struct Entry
+    {
+        uint32_t connector_; //!< index in connectors_
+        uint32_t port_; //!< index of the synapse in its connector
+    };
+
+    /**
+     * @return the index of the first entry at or after \a k whose connector
+     * is due in the current sweep, or the number of entries if there is none.
+     */
+    inline
+    size_t next_due(size_t k) const
+    {
+        while (k < entries_.size() && !due_[entries_[k].connector_])
+        {
+            k++;
+        }
+        return std::min(k, entries_.size());
+    }
+
+    DiligentConnectorModelBase* model_; //!< the model of all connectors
+    std::vector< nest::ConnectorBase* > connectors_;
+    std::vector< nest::Node* > senders_;
+    std::vector< char > due_; //!< non-zero for connectors that are updated in the current sweep
+    std::vector< Entry > entries_;
+};
+
+/**
+ * @brief Retracted synapse that is kept outside of NEST's connectors.
+ */
+struct DormantSynapse
+{
+    nest::index source_; //!< GID of the presynaptic node
+    nest::index target_; //!< GID of the postsynaptic node
+    double synaptic_parameter_;
+    int32_t delay_; //!< delay in steps
+    int32_t rport_; //!< receptor port of the target
+};
+
+/**
+ * @brief Dormant synapses of one synapse model on one thread.
+ */
+struct DormantPool
+{
+    DormantPool()
+    : step_(0)
+    {
+    }
+
+    std::vector< DormantSynapse > synapses_; //!< synapses that are up to date at step_
+    std::vector< std::pair< DormantSynapse, long > > pending_; //!< new synapses and the step they are up to date at
+    long step_; //!< time step to which synapses_ are up to date
+};
+
+/**
+ * @brief Interface of DiligentConnectorModel for target-ordered updates and dormant synapses.
+ */
+class DiligentConnectorModelBase
+{
+public:
+    virtual ~DiligentConnectorModelBase()
+    {
+    }
+
+    /**
+     * Fill the entries of \a schedule for its connectors, ordered by target.
+     */
+    virtual void build_schedule(TargetSchedule& schedule, nest::thread th) = 0;
+
+    /**
+     * Update all synapses of the due connectors of \a schedule to \a time.
+     */
+    virtual void update_schedule(const TargetSchedule& schedule, const nest::Time& time, nest::thread th) = 0;
+
+    /**
+     * Advance the synapses of \a pool to \a time and turn synapses that
+     * became active into connections of the model \a syn_id again.
+     */
+    virtual void update_dormant(DormantPool& pool, const nest::Time& time, nest::thread th,
+                                nest::synindex syn_id) = 0;
+
+    /**
+     * @return the size of one synapse of the model in bytes.
+     */
+    virtual size_t get_synapse_size() const = 0;
+};
+
 /**
  * @brief Class that manages updating diligent connections.
  *
@@ -100,6 +206,75 @@ namespace spore
  * again or change its behavior of returning \c true from \a is_degenerated, as
  * this would lead to undefined behavior.
  *
+ * <b>Deferred Registration</b>
+ *
+ * Registering a connector costs a lookup in the set of connectors every time
+ * a connector grows, which dominates the time to build large networks. While
+ * registration is deferred, changes of connectors are only appended to a log
+ * at constant cost per connection. The log of a thread is resolved into the
+ * set of connectors once, before the connectors are used, i.e. when the
+ * simulation is calibrated or get_connectors() is called. Registration is
+ * deferred for all threads during network construction by calling
+ * set_deferred_registration() (SetSporeStatus with \a deferred_registration),
+ * or for one thread by enclosing the calls to \a connect in
+ * begin_deferred_registration() and end_deferred_registration().
+ *
+ * <b>Target-Ordered Updates</b>
+ *
+ * By default connectors are updated one after another, such that consecutive
+ * synapses read the traces of different targets. With
+ * set_target_ordered(true) (SetSporeStatus with \a target_ordered_updates)
+ * the synapses of all connectors of a synapse model that are due are updated
+ * in the order of their targets instead (see TargetSchedule), and the trace
+ * of the next target is prefetched. The schedule is rebuilt lazily whenever
+ * connectors of the thread have changed, which costs memory for one entry
+ * per synapse. Whether this reduces cache misses depends on the network,
+ * see examples/benchmarks/update_order_benchmark.py to measure it.
+ *
+ * <b>Dormant Synapses</b>
+ *
+ * Synapse models may move retracted synapses out of NEST's connectors into
+ * a compact pool of dormant synapses by calling demote_synapse() and
+ * triggering the garbage collector for them (see
+ * SynapticSamplingRewardGradientConnection). Spikes are not delivered to
+ * dormant synapses, and they cost only the memory of a DormantSynapse.
+ * Dormant synapses are advanced by their synapse model together with the
+ * connectors and turned into connections again when they become active.
+ * While this happens, get_promotion_time() returns the time of the update,
+ * and connectors that receive new connections are brought up to that time
+ * first (see DiligentConnectorModel).
+ *
+ * <b>Compaction</b>
+ *
+ * Removing synapses does not release the memory of NEST's connectors, and
+ * buffers of the update manager keep the size of their peak usage. If
+ * set_compaction() is called with a positive interval (SetSporeStatus with
+ * \a compaction_interval and \a compaction_threshold), every
+ * \a compaction_interval updates of a thread are a compaction pass. The
+ * garbage collector counts the synapses it removes from each connector.
+ * During a compaction pass, the connector model copies a connector into a
+ * new one of fitting size if the fraction of its remaining synapses drops
+ * below \a compaction_threshold (see DiligentConnectorModel), which
+ * registers the new connector once. The garbage pile, the update schedules
+ * and the dormant synapses of the thread are shrunk in the same pass, and
+ * the recorder vectors of all ports at the end of a simulation run (see
+ * ConnectionDataLoggerBase::compact()). Connectors are only compacted when
+ * the garbage collector removes a synapse from them in a compaction pass.
+ * The released memory is reported as \a estimated_reclaimed_bytes by
+ * get_status() and get_memory_status(). It is an estimate, since the memory
+ * of connectors is estimated from the number of removed synapses.
+ *
+ * <b>Frozen Learning</b>
+ *
+ * Learning can be frozen for evaluation runs with set_learning_frozen()
+ * (SetSporeStatus with \a learning_frozen). All connections are brought up
+ * to date to the time when learning was frozen at the start of the next
+ * simulation. Afterwards, the ConnectionUpdater nodes are frozen, tracing
+ * nodes do not write their traces and synapses only deliver spikes with
+ * their current weight (see SynapticSamplingRewardGradientConnection).
+ * When learning is resumed, synapses continue from the state they had when
+ * learning was frozen and skip the frozen period (see get_learning_resumed()).
+ *
  * @node The garbage collection feature should not be used together with structural
  * plasticity mechanisms of NEST which \em delete synapses of the same synapse
  * type, since these may interfere with the garbage collector. Using structural
@@ -122,6 +297,27 @@ public:
     void trigger_garbage_collector(nest::index target_gid, nest::index sender_gid,
                                    nest::thread target_thread, nest::synindex syn_id);
 
+    void demote_synapse(const DormantSynapse& synapse, long step, nest::thread target_thread, nest::synindex syn_id);
+    size_t drop_dormant(nest::synindex syn_id);
+    size_t get_num_dormant() const;
+
+    void begin_deferred_registration(nest::thread th);
+    void end_deferred_registration(nest::thread th);
+    void set_deferred_registration(bool deferred);
+    void set_learning_frozen(bool frozen);
+    void set_target_ordered(bool target_ordered);
+    void set_compaction(long interval, double threshold);
+    void connector_reclaimed(nest::thread th, size_t reclaimed_bytes);
+    void check_connections();
+
+    void get_status(DictionaryDatum& d) const;
+    void set_status(const DictionaryDatum& d);
+    void get_memory_status(DictionaryDatum& d);
+
+    template < typename ConnectionT >
+    void get_connectors(nest::synindex syn_id, nest::thread th,
+                        std::vector< std::pair< nest::index, nest::vector_like< ConnectionT >* > >& connectors);
+
     /**
      * @return the update interval.
      */
@@ -170,6 +366,74 @@ public:
         return (interval_ > 0) && (acceptable_latency_ >= 0) && (cu_id_ != nest::invalid_index);
     }
 
+    /**
+     * @return true if registration of connectors is deferred for all threads.
+     */
+    inline bool get_deferred_registration() const
+    {
+        return deferred_registration_;
+    }
+
+    /**
+     * @return true if learning is frozen.
+     */
+    inline bool is_learning_frozen() const
+    {
+        return learning_frozen_;
+    }
+
+    /**
+     * @return the time at which learning was frozen last.
+     */
+    inline const nest::Time& get_learning_frozen_at() const
+    {
+        return learning_frozen_at_;
+    }
+
+    /**
+     * @return the time at which learning was resumed last. Synapses must
+     * not read traces before this time.
+     */
+    inline const nest::Time& get_learning_resumed() const
+    {
+        return learning_resumed_;
+    }
+
+    /**
+     * @return the time [ms] of the update while dormant synapses of thread
+     * \a th are turned into connections, or a negative value.
+     */
+    inline double get_promotion_time(nest::thread th) const
+    {
+        return (static_cast<size_t>(th) < promotion_time_.size()) ? promotion_time_[th] : -1.0;
+    }
+
+    /**
+     * @return true if the updates of thread \a th are a compaction pass.
+     */
+    inline bool is_compaction_due(nest::thread th) const
+    {
+        return (static_cast<size_t>(th) < compaction_due_.size()) && compaction_due_[th];
+    }
+
+    /**
+     * @return the number of synapses that were removed from the connector
+     * which the garbage collector of thread \a th is removing a synapse
+     * from, since its memory was last reclaimed, or 0.
+     */
+    inline size_t get_pruned(nest::thread th) const
+    {
+        return (static_cast<size_t>(th) < collected_pruned_.size()) ? collected_pruned_[th] : 0;
+    }
+
+    /**
+     * @return fraction of remaining synapses below which connectors are compacted.
+     */
+    inline double get_compaction_threshold() const
+    {
+        return compaction_threshold_;
+    }
+
     /**
      * @return true if at least one connection has been registered.
      */
@@ -197,7 +461,13 @@ private:
     ConnectionUpdateManager(const ConnectionUpdateManager&);
 
     void execute_garbage_collector(nest::thread th);
+    void collect_deferred_connectors(nest::thread th);
     void update(const nest::Time& time, nest::thread th);
+    void update_connectors(const nest::Time& time, double t_trig, nest::thread th);
+    void update_target_ordered(const nest::Time& time, double t_trig, nest::thread th);
+    void build_schedules(nest::thread th);
+    void update_dormant(const nest::Time& time, nest::thread th);
+    void compact(nest::thread th);
     void calibrate(nest::thread th);
     void finalize(nest::thread th);
     void prepare();
@@ -331,6 +601,48 @@ private:
      */
     std::vector< std::set< ConnectionEntry > > connectors_;
 
+    /**
+     * @brief Change of a connector recorded while registration is deferred.
+     */
+    struct DeferredEntry
+    {
+        DeferredEntry( nest::ConnectorBase* connector, nest::Node* sender, bool insert )
+        : connector_(connector),
+          sender_(sender),
+          insert_(insert)
+        {
+        }
+
+        bool operator<(const DeferredEntry& entry) const
+        {
+            return connector_ < entry.connector_;
+        }
+
+        nest::ConnectorBase* connector_;
+        nest::Node* sender_;
+        bool insert_; //!< true if the connector was added, false if it was removed
+    };
+
+    /**
+     * @brief changes of connectors that were not yet registered, in the order of their occurrence.
+     */
+    std::vector< std::vector< DeferredEntry > > deferred_log_;
+
+    /**
+     * @brief non-zero for threads that defer registration.
+     */
+    std::vector< char > is_deferred_;
+
+    /**
+     * @brief update schedules of the synapse models of each thread (see set_target_ordered()).
+     */
+    std::vector< std::vector< TargetSchedule > > schedules_;
+
+    /**
+     * @brief non-zero for threads whose schedules are up to date.
+     */
+    std::vector< char > schedule_valid_;
+
     /**
      * @brief set of connection models that are in use by the manager.
      */
@@ -341,12 +653,54 @@ private:
      */
     std::vector< std::vector< GarbageCollectorEntry > > garbage_pile_;
 
+    /**
+     * @brief dormant synapses of each thread by synapse model.
+     */
+    std::vector< std::map< nest::synindex, DormantPool > > dormant_;
+
+    /**
+     * @brief time of the update while dormant synapses are turned into connections, negative otherwise.
+     */
+    std::vector< double > promotion_time_;
+
+    /**
+     * @brief number of synapses removed from the connector of each sender and synapse model since its last compaction.
+     */
+    std::vector< std::map< std::pair< nest::index, nest::synindex >, size_t > > pruned_;
+
+    /**
+     * @brief entry of pruned_ of the connector that is garbage collected, 0 otherwise.
+     */
+    std::vector< size_t > collected_pruned_;
+
+    /**
+     * @brief number of updates of each thread since the last compaction pass.
+     */
+    std::vector< long > updates_since_compaction_;
+
+    /**
+     * @brief non-zero for threads that are in a compaction pass.
+     */
+    std::vector< char > compaction_due_;
+
+    /**
+     * @brief memory released by compaction on each thread [bytes].
+     */
+    std::vector< size_t > reclaimed_bytes_;
+
     long acceptable_latency_;
     long interval_;
     nest::index cu_model_id_;
     nest::index cu_id_;
     bool has_connections_;
     bool is_initialized_;
+    bool deferred_registration_;
+    bool target_ordered_;
+    bool learning_frozen_;
+    long compaction_interval_;
+    double compaction_threshold_;
+    nest::Time learning_frozen_at_;
+    nest::Time learning_resumed_;
 
     static ConnectionUpdateManager* instance_;
 };
@@ -422,6 +776,42 @@ public:
     }
 };
 
+/**
+ * Collect all registered connectors of the given synapse model on the given
+ * thread. Connectors of different threads can be collected concurrently,
+ * but not while connections are created or deleted. Deferred connectors of
+ * the thread are registered first.
+ *
+ * @param syn_id the synapse model, must be instantiated from \a ConnectionT.
+ * @param th the thread of the connectors.
+ * @param connectors vector to retrieve pairs of sender GID and connector.
+ */
+template < typename ConnectionT >
+void ConnectionUpdateManager::get_connectors(nest::synindex syn_id, nest::thread th,
+                                             std::vector< std::pair< nest::index,
+                                                                     nest::vector_like< ConnectionT >* > >& connectors)
+{
+    connectors.clear();
+
+    if (static_cast<size_t>(th) >= connectors_.size())
+    {
+        return;
+    }
+
+    collect_deferred_connectors(th);
+
+    for (std::set<ConnectionEntry>::const_iterator it = connectors_[th].begin();
+            it != connectors_[th].end();
+            it++)
+    {
+        if (it->get_connector()->get_syn_id() == syn_id)
+        {
+            connectors.push_back(std::make_pair(it->get_sender().get_gid(),
+                                                static_cast< nest::vector_like< ConnectionT >* >(it->get_connector())));
+        }
+    }
+}
+
 }
 
 #endif
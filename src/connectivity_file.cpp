@@ -0,0 +1,269 @@
+/*
+ * This file is part of SPORE.
+ *
+ * Copyright (C) 2016, the SPORE team (see AUTHORS).
+ *
+ * SPORE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * SPORE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SPORE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * For more information see: https://github.com/IGITUGraz/spore-nest-module
+ *
+ * File:   connectivity_file.cpp
+ * Author: Kappel
+ *
+ * Created on October 18, 2026
+ */
+
+#include "connectivity_file.h"
+#include "connection_updater.h"
+#include "spore_names.h"
+
+#include "compose.hpp"
+#include "dictutils.h"
+#include "exceptions.h"
+#include "kernel_manager.h"
+#include "vp_manager_impl.h"
+
+#include <algorithm>
+#include <exception>
+#include <vector>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+
+
+namespace spore
+{
+
+static const char connectivity_magic[8] = { 'S', 'P', 'O', 'R', 'E', 'C', 'O', 'N' };
+
+const uint32_t ConnectivityFile::version;
+
+/**
+ * @brief Read-only memory mapping of a file that is released on destruction.
+ */
+class ConnectivityMapping
+{
+public:
+    explicit ConnectivityMapping(const std::string& file_name)
+    : mem_(0),
+    size_(0)
+    {
+        const int fd = open(file_name.c_str(), O_RDONLY);
+        struct stat st;
+        if (fd < 0 || fstat(fd, &st) != 0)
+        {
+            if (fd >= 0)
+            {
+                close(fd);
+            }
+            throw nest::BadProperty(String::compose("LoadConnectivity: can not open file '%1': %2",
+                                                    file_name, strerror(errno)));
+        }
+
+        size_ = st.st_size;
+        void* mem = (size_ > 0) ? mmap(0, size_, PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
+        close(fd);
+
+        if (mem == MAP_FAILED || size_ < sizeof (ConnectivityHeader))
+        {
+            if (mem != MAP_FAILED)
+            {
+                munmap(mem, size_);
+            }
+            throw nest::BadProperty(String::compose("LoadConnectivity: '%1' is not a SPORE connectivity file.",
+                                                    file_name));
+        }
+        mem_ = static_cast<const char*>(mem);
+    }
+
+    ~ConnectivityMapping()
+    {
+        munmap(const_cast<char*>(mem_), size_);
+    }
+
+    const ConnectivityHeader& header() const
+    {
+        return *reinterpret_cast<const ConnectivityHeader*>(mem_);
+    }
+
+    const ConnectivityEdge* edges() const
+    {
+        return reinterpret_cast<const ConnectivityEdge*>(mem_ + sizeof (ConnectivityHeader));
+    }
+
+    size_t get_size() const
+    {
+        return size_;
+    }
+
+private:
+    const char* mem_;
+    size_t size_;
+};
+
+/**
+ * @brief Orders edges by their source and target.
+ */
+class EdgeOrder
+{
+public:
+    explicit EdgeOrder(const ConnectivityEdge* edges)
+    : edges_(edges)
+    {
+    }
+
+    bool operator()(size_t a, size_t b) const
+    {
+        return (edges_[a].source < edges_[b].source) ||
+               (edges_[a].source == edges_[b].source && edges_[a].target < edges_[b].target);
+    }
+
+private:
+    const ConnectivityEdge* edges_;
+};
+
+/**
+ * Create all connections of a connectivity file with the given synapse
+ * model. This function must not be called while connections are created
+ * or simulated.
+ *
+ * @param file_name name of the connectivity file.
+ * @param syn_id the synapse model of the connections.
+ * @param d dictionary to retrieve the number of created connections.
+ */
+void ConnectivityFile::load(const std::string& file_name, nest::synindex syn_id, DictionaryDatum& d)
+{
+    const size_t num_threads = nest::kernel().vp_manager.get_num_threads();
+    const nest::index max_gid = nest::kernel().node_manager.size();
+
+    if (!ConnectionUpdateManager::instance()->is_valid())
+    {
+        throw nest::BadProperty("LoadConnectivity: Connection update manager was not set up correctly! "
+                                "Maybe you forgot to call 'InitSynapseUpdater'?");
+    }
+
+    ConnectivityMapping file(file_name);
+    const ConnectivityHeader& header = file.header();
+
+    if (memcmp(header.magic, connectivity_magic, sizeof (connectivity_magic)) != 0)
+    {
+        throw nest::BadProperty(String::compose("LoadConnectivity: '%1' is not a SPORE connectivity file.",
+                                                file_name));
+    }
+    if (header.version != version || header.record_size != sizeof (ConnectivityEdge))
+    {
+        throw nest::BadProperty(String::compose("LoadConnectivity: '%1' has an unsupported format version %2.",
+                                                file_name, header.version));
+    }
+    if (sizeof (ConnectivityHeader) + header.count * sizeof (ConnectivityEdge) > file.get_size())
+    {
+        throw nest::BadProperty(String::compose("LoadConnectivity: '%1' is truncated.", file_name));
+    }
+
+    const ConnectivityEdge* edges = file.edges();
+    const size_t count = header.count;
+
+    // distribute the edges to the threads of their targets, in file order.
+    std::vector<nest::thread> threads(count);
+    std::vector<size_t> offsets(num_threads + 1, 0);
+    for (size_t k = 0; k < count; k++)
+    {
+        if (edges[k].source == 0 || edges[k].source >= max_gid ||
+            edges[k].target == 0 || edges[k].target >= max_gid)
+        {
+            throw nest::BadProperty(String::compose("LoadConnectivity: connection %1 from %2 to %3 refers to "
+                                                    "a node that does not exist.",
+                                                    k, edges[k].source, edges[k].target));
+        }
+        const nest::thread vp = nest::kernel().vp_manager.suggest_vp(edges[k].target);
+        threads[k] = nest::kernel().vp_manager.vp_to_thread(vp);
+        offsets[threads[k] + 1]++;
+    }
+
+    for (size_t t = 0; t < num_threads; t++)
+    {
+        offsets[t + 1] += offsets[t];
+    }
+
+    std::vector<size_t> order(count);
+    std::vector<size_t> next(offsets.begin(), offsets.end() - 1);
+    for (size_t k = 0; k < count; k++)
+    {
+        order[next[threads[k]]++] = k;
+    }
+
+    std::vector<std::string> errors(num_threads);
+    std::vector<size_t> created(num_threads, 0);
+
+#pragma omp parallel
+    {
+        const nest::thread th = nest::kernel().vp_manager.get_thread_id();
+
+        std::vector<size_t>::iterator begin = order.begin() + offsets[th];
+        std::vector<size_t>::iterator end = order.begin() + offsets[th + 1];
+
+        // create the connections of each source consecutively, in ascending
+        // order of their targets (see DiligentConnectorModel).
+        std::stable_sort(begin, end, EdgeOrder(edges));
+
+        ConnectionUpdateManager::instance()->begin_deferred_registration(th);
+
+        try
+        {
+            for (std::vector<size_t>::const_iterator it = begin; it != end; it++)
+            {
+                const ConnectivityEdge& edge = edges[*it];
+                nest::Node* target = nest::kernel().node_manager.get_node(edge.target, th);
+                if (!nest::kernel().node_manager.is_local_node(target) || target->get_thread() != th)
+                {
+                    continue;
+                }
+                nest::kernel().connection_manager.connect(edge.source, target, th, syn_id,
+                                                          edge.delay, edge.synaptic_parameter);
+                created[th]++;
+            }
+        }
+        catch (nest::KernelException& e)
+        {
+            errors[th] = e.message();
+        }
+        catch (std::exception& e)
+        {
+            errors[th] = e.what();
+        }
+
+        ConnectionUpdateManager::instance()->end_deferred_registration(th);
+    }
+
+    for (size_t t = 0; t < num_threads; t++)
+    {
+        if (!errors[t].empty())
+        {
+            throw nest::BadProperty(String::compose("LoadConnectivity: %1", errors[t]));
+        }
+    }
+
+    size_t n_created = 0;
+    for (size_t t = 0; t < num_threads; t++)
+    {
+        n_created += created[t];
+    }
+    def<long>(d, names::created, n_created);
+}
+
+}
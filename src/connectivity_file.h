@@ -0,0 +1,89 @@
+/*
+ * This file is part of SPORE.
+ *
+ * Copyright (C) 2016, the SPORE team (see AUTHORS).
+ *
+ * SPORE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * SPORE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SPORE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * For more information see: https://github.com/IGITUGraz/spore-nest-module
+ *
+ * File:   connectivity_file.h
+ * Author: Kappel
+ *
+ * Created on October 18, 2026
+ */
+
+#ifndef CONNECTIVITY_FILE_H
+#define CONNECTIVITY_FILE_H
+
+#include <string>
+
+#include <stdint.h>
+
+#include "nest.h"
+#include "dictdatum.h"
+
+
+namespace spore
+{
+
+/**
+ * @brief Header of a connectivity file.
+ *
+ * The header is followed by \a count records of type ConnectivityEdge.
+ */
+struct ConnectivityHeader
+{
+    char magic[8]; //!< must be "SPORECON"
+    uint32_t version; //!< layout version, must be ConnectivityFile::version
+    uint32_t record_size; //!< size of a record, must be sizeof(ConnectivityEdge)
+    uint64_t count; //!< number of records
+    uint64_t reserved[5];
+};
+
+/**
+ * @brief Connection in a connectivity file.
+ */
+struct ConnectivityEdge
+{
+    uint64_t source; //!< GID of the presynaptic node
+    uint64_t target; //!< GID of the postsynaptic node
+    double synaptic_parameter; //!< initial synaptic parameter, NaN for the default
+    double delay; //!< delay [ms], NaN for the default
+};
+
+/**
+ * @brief Bulk creation of connections from a binary edge list.
+ *
+ * ConnectivityFile creates all connections listed in a connectivity file
+ * (see ConnectivityHeader). The file is mapped into memory and the edges
+ * are distributed to the threads that own their targets. Every thread then
+ * creates its connections ordered by source and target, with deferred
+ * registration at the ConnectionUpdateManager, such that each connector is
+ * registered once. Connections of the same source and target are created in
+ * the order of the file. The synaptic parameter is passed to the synapse model
+ * as weight (see SynapticSamplingRewardGradientConnection::set_weight()).
+ * Files can be written with utils/spore_connectivity.py.
+ */
+class ConnectivityFile
+{
+public:
+    static const uint32_t version = 1;
+
+    static void load(const std::string& file_name, nest::synindex syn_id, DictionaryDatum& d);
+};
+
+}
+
+#endif /* CONNECTIVITY_FILE_H */
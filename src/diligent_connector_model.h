@@ -31,6 +31,8 @@
 
 #include "connector_model_impl.h"
 
+#include <algorithm>
+
 #include "spore.h"
 #include "connection_updater.h"
 
@@ -74,11 +76,42 @@ namespace spore
  * the calibrate function of their \a CommonSynapseProperties object is called
  * additionally on simulation startup (such as nest::Node objects).
  *
+ * Connections of a connector are kept sorted by the GID of their targets,
+ * such that connections can be found by binary search when they are deleted.
+ * New connections are moved to their position when they are created. This is
+ * at constant cost if the connections of a source are created in ascending
+ * order of their targets, as done by NEST's connection rules. A connection
+ * that is created out of this order, e.g. by a later Connect call or when a
+ * dormant synapse is turned into a connection during the simulation,
+ * changes the ports of the connections behind it. Ports (e.g. as returned by
+ * GetConnections) are therefore only stable as long as no connections are
+ * added to the connector. Connections can always be found by their source
+ * and target with find_connection().
+ *
+ * The model also implements target-ordered updates (see
+ * ConnectionUpdateManager::set_target_ordered()). Synapses used with this
+ * mode must implement a method \a prefetch that takes the thread, the time
+ * of the last update and the common properties. It is called for the next
+ * synapse in the schedule and should prefetch the data read by its next
+ * update.
+ *
+ * Dormant synapses (see ConnectionUpdateManager) are advanced by a static
+ * method \a update_dormant of the synapse that takes the pool of dormant
+ * synapses, the time, the thread, the synapse model and the common
+ * properties. Connectors that receive connections while dormant synapses
+ * are turned into connections are brought up to the time of the update
+ * first, and the time of their last update is set to it afterwards.
+ *
+ * During compaction passes of the ConnectionUpdateManager, connectors from
+ * which the garbage collector removed a large fraction of synapses are
+ * copied into new connectors that only hold the remaining synapses (see
+ * compact_connector()).
+ *
  * @see ConnectionUpdateManager, SynapseUpdateEvent, SynapticSamplingRewardGradientConnection
  *
  */
 template < typename ConnectionT >
-class DiligentConnectorModel : public nest::GenericConnectorModel<ConnectionT>
+class DiligentConnectorModel : public nest::GenericConnectorModel<ConnectionT>, public DiligentConnectorModelBase
 {
 public:
     /**
@@ -111,14 +144,44 @@ public:
 
     virtual nest::ConnectorModel* clone(std::string name) const;
 
+    virtual void build_schedule(TargetSchedule& schedule, nest::thread th);
+
+    virtual void update_schedule(const TargetSchedule& schedule, const nest::Time& time, nest::thread th);
+
+    virtual void update_dormant(DormantPool& pool, const nest::Time& time, nest::thread th, nest::synindex syn_id);
+
+    /**
+     * @return the size of one synapse in bytes.
+     */
+    virtual size_t get_synapse_size() const
+    {
+        return sizeof (ConnectionT);
+    }
+
+    static size_t find_connection(nest::vector_like< ConnectionT >* vc, nest::index target_gid,
+                                  nest::thread target_thread);
+
 protected:
 
+    typedef std::pair< nest::index, TargetSchedule::Entry > ScheduleItem;
+
+    static bool target_less(const ScheduleItem& a, const ScheduleItem& b)
+    {
+        return a.first < b.first;
+    }
+
     nest::ConnectorBase* cleanup_delete_connection(nest::Node& tgt, const size_t target_thread,
                                                    nest::ConnectorBase* const conn, const nest::synindex syn_id);
 
     void register_connector(nest::ConnectorBase* new_conn, nest::ConnectorBase* old_conn, nest::index sender_gid,
                             size_t target_thread, nest::synindex syn_id);
 
+    void sort_new_connection(nest::ConnectorBase* conn, nest::thread target_thread);
+
+    void update_connector(nest::ConnectorBase* conn, nest::Node& src, nest::thread target_thread);
+
+    nest::ConnectorBase* compact_connector(nest::ConnectorBase* conn, nest::thread target_thread);
+
     nest::ConnectorBase* get_hom_connector(nest::ConnectorBase* conn, nest::synindex syn_id);
 
 }; // DiligentConnectorModel
@@ -150,9 +213,12 @@ DiligentConnectorModel< ConnectionT >::add_connection(nest::Node& src,
                                                       double weight)
 {
     nest::ConnectorBase* old_hom_conn = get_hom_connector(nest::validate_pointer(conn), syn_id);
+    update_connector(old_hom_conn, src, tgt.get_thread());
     nest::ConnectorBase* new_conn = nest::GenericConnectorModel< ConnectionT >::add_connection(src, tgt, conn,
                                                                                                syn_id, delay, weight);
     nest::ConnectorBase* new_hom_conn = get_hom_connector(nest::validate_pointer(new_conn), syn_id);
+    sort_new_connection(new_hom_conn, tgt.get_thread());
+    update_connector(new_hom_conn, src, tgt.get_thread());
     register_connector(new_hom_conn, old_hom_conn, src.get_gid(), tgt.get_thread(), syn_id);
     return new_conn;
 }
@@ -186,9 +252,12 @@ DiligentConnectorModel< ConnectionT >::add_connection(nest::Node& src,
                                                       double weight)
 {
     nest::ConnectorBase* old_hom_conn = get_hom_connector(nest::validate_pointer(conn), syn_id);
+    update_connector(old_hom_conn, src, tgt.get_thread());
     nest::ConnectorBase* new_conn = nest::GenericConnectorModel< ConnectionT >::add_connection(src, tgt, conn, syn_id,
                                                                                                p, delay, weight);
     nest::ConnectorBase* new_hom_conn = get_hom_connector(nest::validate_pointer(new_conn), syn_id);
+    sort_new_connection(new_hom_conn, tgt.get_thread());
+    update_connector(new_hom_conn, src, tgt.get_thread());
     register_connector(new_hom_conn, old_hom_conn, src.get_gid(), tgt.get_thread(), syn_id);
     return new_conn;
 }
@@ -227,6 +296,121 @@ DiligentConnectorModel< ConnectionT >::clone(std::string name) const
     return new DiligentConnectorModel< ConnectionT >(*this, name); // calls copy construtor
 }
 
+/**
+ * Fill the entries of the given schedule with all synapses of its
+ * connectors, ordered by the GIDs of their targets. Synapses that share a
+ * target keep the order of their connectors.
+ *
+ * @param schedule the schedule, whose connectors are of this model.
+ * @param th the thread of the connectors.
+ */
+template < typename ConnectionT >
+void DiligentConnectorModel< ConnectionT >::build_schedule(TargetSchedule& schedule, nest::thread th)
+{
+    std::vector< ScheduleItem > items;
+
+    for (uint32_t c = 0; c < schedule.connectors_.size(); c++)
+    {
+        nest::vector_like< ConnectionT >* vc = static_cast< nest::vector_like< ConnectionT >* >(
+                schedule.connectors_[c]);
+
+        for (uint32_t p = 0; p < vc->size(); p++)
+        {
+            TargetSchedule::Entry entry = { c, p };
+            items.push_back(ScheduleItem(vc->at(p).get_target(th)->get_gid(), entry));
+        }
+    }
+
+    std::stable_sort(items.begin(), items.end(), target_less);
+
+    schedule.entries_.resize(items.size());
+    for (size_t k = 0; k < items.size(); k++)
+    {
+        schedule.entries_[k] = items[k].second;
+    }
+}
+
+/**
+ * Send a SynapseUpdateEvent to all synapses of the due connectors of the
+ * schedule in the order of the schedule. The due synapse after the next one
+ * is loaded ahead and the next due synapse prefetches the data of its
+ * update. The
+ * caller updates the time of the last spike of the connectors afterwards.
+ *
+ * @param schedule the schedule of the thread.
+ * @param time the time point to advance to.
+ * @param th the thread of the connectors.
+ */
+template < typename ConnectionT >
+void DiligentConnectorModel< ConnectionT >::update_schedule(const TargetSchedule& schedule,
+                                                            const nest::Time& time,
+                                                            nest::thread th)
+{
+    const typename ConnectionT::CommonPropertiesType& cp = this->get_common_properties();
+
+    SynapseUpdateEvent ev;
+    ev.set_stamp(time);
+
+    const size_t n = schedule.entries_.size();
+
+    // only synapses of due connectors are prefetched, such that sparse
+    // sweeps over large schedules do not load synapses that are skipped.
+    size_t k = schedule.next_due(0);
+    size_t next = schedule.next_due(k + 1);
+    size_t ahead = schedule.next_due(next + 1);
+
+    while (k < n)
+    {
+        if (ahead < n)
+        {
+            const TargetSchedule::Entry& entry = schedule.entries_[ahead];
+            SPORE_PREFETCH(&static_cast< nest::vector_like< ConnectionT >* >(
+                    schedule.connectors_[entry.connector_])->at(entry.port_));
+        }
+
+        if (next < n)
+        {
+            const TargetSchedule::Entry& entry = schedule.entries_[next];
+            nest::vector_like< ConnectionT >* vc = static_cast< nest::vector_like< ConnectionT >* >(
+                    schedule.connectors_[entry.connector_]);
+            vc->at(entry.port_).prefetch(th, vc->get_t_lastspike(), cp);
+        }
+
+        const TargetSchedule::Entry& entry = schedule.entries_[k];
+        nest::vector_like< ConnectionT >* vc = static_cast< nest::vector_like< ConnectionT >* >(
+                schedule.connectors_[entry.connector_]);
+        nest::Node* sender = schedule.senders_[entry.connector_];
+
+        ev.set_sender(*sender);
+        ev.set_sender_gid(sender->get_gid());
+        ev.set_port(entry.port_);
+
+        vc->at(entry.port_).send(ev, th, vc->get_t_lastspike(), cp);
+
+        k = next;
+        next = ahead;
+        ahead = schedule.next_due(ahead + 1);
+    }
+}
+
+/**
+ * Advance the dormant synapses of the given pool (see
+ * ConnectionUpdateManager::update_dormant()).
+ *
+ * @param pool the dormant synapses of this model on the thread.
+ * @param time the time point to advance to.
+ * @param th the thread of the pool.
+ * @param syn_id the id of this synapse model.
+ */
+template < typename ConnectionT >
+void DiligentConnectorModel< ConnectionT >::update_dormant(DormantPool& pool,
+                                                           const nest::Time& time,
+                                                           nest::thread th,
+                                                           nest::synindex syn_id)
+{
+    ConnectionT::update_dormant(pool, time, th, syn_id, this->get_common_properties());
+}
+
 /**
  * Registers the connector at the ConnectionUpdateManager.
  */
@@ -250,7 +434,8 @@ void DiligentConnectorModel< ConnectionT >::register_connector(nest::ConnectorBa
  * indicate that they are marked for deletion by returning \c true from
  * their \a is_degenerated method. If no connection is found that
  * is marked for deletion this function behaves the same way as
- * \a delete_connection of NEST's generic connector model.
+ * \a delete_connection of NEST's generic connector model. Connectors
+ * are compacted after the synapse was removed (see compact_connector()).
  *
  * @param tgt Target node
  * @param target_thread Thread of the target
@@ -286,19 +471,21 @@ nest::ConnectorBase* DiligentConnectorModel< ConnectionT >::cleanup_delete_conne
         assert(conn_vp->get_syn_id() == syn_id);
         vc = static_cast<vector_like< ConnectionT >*> (conn_vp);
         // delete the first Connection corresponding to the target
-        for (size_t i = 0; i < vc->size(); i++)
+        for (size_t i = find_connection(vc, tgt.get_gid(), target_thread);
+             i < vc->size() && vc->at(i).get_target(target_thread)->get_gid() == tgt.get_gid();
+             i++)
         {
             ConnectionT* connection = &vc->at(i);
 
             // only remove synapse if marked for deletion.
-            if ((connection->get_target(target_thread)->get_gid() == tgt.get_gid()) && connection->is_degenerated())
+            if (connection->is_degenerated())
             {
                 if (vc->get_num_connections() > 1)
-                    conn_vp = &vc->erase(i);
+                    conn_vp = compact_connector(&vc->erase(i), target_thread);
                 else
                 {
                     delete vc;
-                    conn_vp = 0;
+                    conn_vp = compact_connector(0, target_thread);
                 }
                 const bool is_primary = DiligentConnectorModel< ConnectionT >::is_primary_;
                 if (conn_vp != 0)
@@ -328,18 +515,20 @@ nest::ConnectorBase* DiligentConnectorModel< ConnectionT >::cleanup_delete_conne
                 vector_like< ConnectionT >* vc =
                         static_cast< vector_like< ConnectionT >* > ((*hc)[ i ]);
                 // Find and delete the first Connection corresponding to the target
-                for (size_t j = 0; j < vc->size(); j++)
+                for (size_t j = find_connection(vc, tgt.get_gid(), target_thread);
+                     j < vc->size() && vc->at(j).get_target(target_thread)->get_gid() == tgt.get_gid();
+                     j++)
                 {
                     ConnectionT* connection = &vc->at(j);
 
-                    if ((connection->get_target(target_thread)->get_gid() == tgt.get_gid()) &&
-                        connection->is_degenerated()) // only remove synapse if marked for deletion.
+                    if (connection->is_degenerated()) // only remove synapse if marked for deletion.
                     {
                         // Get rid of the ConnectionBase for this type of synapse if there
                         // is only this element left
                         if (vc->size() == 1)
                         {
                             (*hc).erase((*hc).begin() + i);
+                            compact_connector(0, target_thread);
                             // Test if the homogeneous vector of connections went back to only
                             // 1 type of synapse... then go back to the simple vector_like
                             // case.
@@ -357,7 +546,7 @@ nest::ConnectorBase* DiligentConnectorModel< ConnectionT >::cleanup_delete_conne
                         } // Otherwise, just remove the desired connection
                         else
                         {
-                            (*hc)[ i ] = &vc->erase(j);
+                            (*hc)[ i ] = compact_connector(&vc->erase(j), target_thread);
                             conn_vp = pack_pointer(hc, b_has_primary, b_has_secondary);
                         }
                         found = true;
@@ -378,6 +567,174 @@ nest::ConnectorBase* DiligentConnectorModel< ConnectionT >::cleanup_delete_conne
     }
 }
 
+/**
+ * Copy the given homogeneous connector into a new connector that only holds
+ * its remaining synapses if the garbage collector of the ConnectionUpdateManager is in a compaction
+ * pass and the connector holds less than the compaction threshold of its
+ * synapses since its last compaction. The original connector is deleted.
+ * The connections keep their order, their state including their recorder
+ * ports and the time of the last update of the connector. The new connector
+ * is grown by NEST's push_back and may keep spare capacity. The released
+ * memory is estimated from the number of removed synapses.
+ *
+ * @param conn the connector after a synapse was removed, or 0 if the
+ * connector was deleted.
+ * @param target_thread thread of the target.
+ * @return the compacted connector, or \a conn.
+ */
+template < typename ConnectionT >
+nest::ConnectorBase* DiligentConnectorModel< ConnectionT >::compact_connector(nest::ConnectorBase* conn,
+                                                                              nest::thread target_thread)
+{
+    ConnectionUpdateManager* manager = ConnectionUpdateManager::instance();
+    const size_t pruned = manager->get_pruned(target_thread);
+
+    if (pruned == 0)
+    {
+        return conn;
+    }
+
+    if (conn == 0)
+    {
+        manager->connector_reclaimed(target_thread, 0);
+        return conn;
+    }
+
+    nest::vector_like< ConnectionT >* vc = static_cast< nest::vector_like< ConnectionT >* >(conn);
+    const size_t n = vc->size();
+
+    if (!manager->is_compaction_due(target_thread) || n >= manager->get_compaction_threshold() * (n + pruned))
+    {
+        return conn;
+    }
+
+    nest::vector_like< ConnectionT >* compacted = new nest::Connector< 1, ConnectionT >(vc->at(0));
+    for (size_t i = 1; i < n; i++)
+    {
+        compacted = static_cast< nest::vector_like< ConnectionT >* >(&compacted->push_back(vc->at(i)));
+    }
+
+    // copies of connections are not recorded, assignment moves the recorder ports
+    for (size_t i = 0; i < n; i++)
+    {
+        compacted->at(i) = vc->at(i);
+    }
+    compacted->set_t_lastspike(vc->get_t_lastspike());
+    delete vc;
+
+    manager->connector_reclaimed(target_thread, pruned * sizeof (ConnectionT));
+    return compacted;
+}
+
+/**
+ * Move the last connection of the given homogeneous connector to its
+ * position in the order of target GIDs. Returns immediately if the
+ * connection was created in ascending order of targets. Otherwise, the
+ * ports of all connections behind the new position are shifted by one, so
+ * ports that were retrieved before the connection was added (e.g. by
+ * GetConnections) no longer refer to the same connections. Connections
+ * between the same nodes keep the order in which they were created.
+ *
+ * @param conn the homogeneous connector of the new connection.
+ * @param target_thread thread of the target.
+ */
+template < typename ConnectionT >
+void DiligentConnectorModel< ConnectionT >::sort_new_connection(nest::ConnectorBase* conn,
+                                                                nest::thread target_thread)
+{
+    nest::vector_like< ConnectionT >* vc = static_cast< nest::vector_like< ConnectionT >* >(conn);
+
+    size_t i = vc->size() - 1;
+    const nest::index target_gid = vc->at(i).get_target(target_thread)->get_gid();
+
+    if (i == 0 || vc->at(i - 1).get_target(target_thread)->get_gid() <= target_gid)
+    {
+        return;
+    }
+
+    // copies of connections are not recorded, so connections are moved by
+    // assignment, which keeps their recorder ports.
+    ConnectionT connection;
+    connection = vc->at(i);
+
+    while (i > 0 && vc->at(i - 1).get_target(target_thread)->get_gid() > target_gid)
+    {
+        vc->at(i) = vc->at(i - 1);
+        i--;
+    }
+    vc->at(i) = connection;
+}
+
+/**
+ * Bring the given homogeneous connector up to the time of the update while
+ * dormant synapses are turned into connections. Connectors of new
+ * connections do not keep the time of their last update, so all synapses
+ * of the connector must be up to date before a connection is added. Does
+ * nothing if no dormant synapses are turned into connections.
+ *
+ * @param conn the homogeneous connector, can be 0.
+ * @param src the source of the connector.
+ * @param target_thread thread of the target.
+ */
+template < typename ConnectionT >
+void DiligentConnectorModel< ConnectionT >::update_connector(nest::ConnectorBase* conn,
+                                                             nest::Node& src,
+                                                             nest::thread target_thread)
+{
+    const double t_promotion = ConnectionUpdateManager::instance()->get_promotion_time(target_thread);
+
+    if (!conn || t_promotion < 0.0 || conn->get_t_lastspike() >= t_promotion)
+    {
+        return;
+    }
+
+    if (conn->get_t_lastspike() > 0.0)
+    {
+        SynapseUpdateEvent ev;
+        ev.set_stamp(nest::Time::ms(t_promotion));
+        ev.set_sender(src);
+        ev.set_sender_gid(src.get_gid());
+        conn->send(ev, target_thread, nest::kernel().model_manager.get_synapse_prototypes(target_thread));
+    }
+
+    conn->set_t_lastspike(t_promotion);
+}
+
+/**
+ * Binary search for the first connection of a connector that targets the
+ * node with the given GID.
+ *
+ * @param vc the homogeneous connector, sorted by target GIDs.
+ * @param target_gid the GID of the target.
+ * @param target_thread thread of the target.
+ * @return index of the first connection to the target, or of the first
+ * connection with larger target GID if there is none.
+ */
+template < typename ConnectionT >
+size_t DiligentConnectorModel< ConnectionT >::find_connection(nest::vector_like< ConnectionT >* vc,
+                                                              nest::index target_gid,
+                                                              nest::thread target_thread)
+{
+    size_t first = 0;
+    size_t count = vc->size();
+
+    while (count > 0)
+    {
+        const size_t step = count / 2;
+        if (vc->at(first + step).get_target(target_thread)->get_gid() < target_gid)
+        {
+            first += step + 1;
+            count -= step + 1;
+        }
+        else
+        {
+            count = step;
+        }
+    }
+
+    return first;
+}
+
 /**
  * Helper function to extract the homogeneous connector with given type
  * from a given connector. If the given connector is homogeneous the
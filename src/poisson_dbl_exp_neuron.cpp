@@ -445,4 +445,42 @@ void PoissonDblExpNeuron::handle(nest::DataLoggingRequest& e)
     B_.logger_.handle(e);
 }
 
+/**
+ * Store the state variables of the neuron for checkpoints.
+ * @param state vector to retrieve the state.
+ */
+void PoissonDblExpNeuron::get_checkpoint_state(std::vector<double>& state) const
+{
+    state.resize(8);
+    state[0] = S_.u_rise_exc_;
+    state[1] = S_.u_fall_exc_;
+    state[2] = S_.u_rise_inh_;
+    state[3] = S_.u_fall_inh_;
+    state[4] = S_.u_membrane_;
+    state[5] = S_.input_current_;
+    state[6] = S_.adaptive_threshold_;
+    state[7] = S_.r_;
+}
+
+/**
+ * Restore the state variables of the neuron from a checkpoint. States of
+ * other node types are ignored.
+ * @param state the state stored by get_checkpoint_state().
+ */
+void PoissonDblExpNeuron::set_checkpoint_state(const std::vector<double>& state)
+{
+    if (state.size() != 8)
+    {
+        return;
+    }
+    S_.u_rise_exc_ = state[0];
+    S_.u_fall_exc_ = state[1];
+    S_.u_rise_inh_ = state[2];
+    S_.u_fall_inh_ = state[3];
+    S_.u_membrane_ = state[4];
+    S_.input_current_ = state[5];
+    S_.adaptive_threshold_ = state[6];
+    S_.r_ = static_cast<int>(state[7]);
+}
+
 }
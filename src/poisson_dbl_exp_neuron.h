@@ -185,6 +185,9 @@ public:
     void get_status(DictionaryDatum &) const;
     void set_status(const DictionaryDatum &);
 
+    void get_checkpoint_state(std::vector<double>& state) const;
+    void set_checkpoint_state(const std::vector<double>& state);
+
 private:
 
     void init_state_(const nest::Node& proto);
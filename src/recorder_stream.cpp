@@ -0,0 +1,248 @@
+/*
+ * This file is part of SPORE.
+ *
+ * Copyright (C) 2016, the SPORE team (see AUTHORS).
+ *
+ * SPORE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * SPORE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SPORE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * For more information see: https://github.com/IGITUGraz/spore-nest-module
+ *
+ * File:   recorder_stream.cpp
+ * Author: Kappel
+ *
+ * Created on October 18, 2026
+ */
+
+#include "recorder_stream.h"
+
+#include "exceptions.h"
+#include "compose.hpp"
+
+#include <algorithm>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+
+
+namespace spore
+{
+
+static const char recorder_stream_magic[8] = { 'S', 'P', 'O', 'R', 'E', 'R', 'E', 'C' };
+static const uint32_t recorder_stream_version = 1;
+static const size_t recorder_stream_name_size = 96;
+
+const size_t RecorderStream::header_size;
+const size_t RecorderStream::flush_interval;
+const size_t RecorderStream::initial_capacity;
+
+/**
+ * Constructor. Creates the column files "<file_prefix>-port.dat",
+ * "<file_prefix>-time.dat" and one file "<file_prefix>-<name>.dat" for every
+ * entry of \a value_names.
+ *
+ * @param file_prefix path and prefix of the column files.
+ * @param value_names names of the recorded variables.
+ * @param overwrite if false, existing files are not overwritten.
+ */
+RecorderStream::RecorderStream(const std::string& file_prefix,
+                               const std::vector<std::string>& value_names,
+                               bool overwrite)
+: size_(0),
+capacity_(0),
+unflushed_(0)
+{
+    columns_.resize(value_names.size() + 2);
+
+    for (size_t i = 0; i < columns_.size(); i++)
+    {
+        Column& column = columns_[i];
+        column.name_ = (i == 0) ? "port" : (i == 1) ? "time" : value_names[i - 2];
+        column.file_name_ = file_prefix + "-" + column.name_ + ".dat";
+        column.type_ = (i == 0) ? "<u8" : "<f8";
+        column.item_size_ = 8;
+        column.fd_ = -1;
+        column.mem_ = 0;
+        column.mapped_size_ = 0;
+    }
+
+    try
+    {
+        for (size_t i = 0; i < columns_.size(); i++)
+        {
+            open_column(columns_[i], overwrite);
+        }
+        grow();
+    }
+    catch (...)
+    {
+        for (size_t i = 0; i < columns_.size(); i++)
+        {
+            close_column(columns_[i]);
+        }
+        throw;
+    }
+}
+
+/**
+ * Destructor. Flushes all records and truncates the files to their content.
+ */
+RecorderStream::~RecorderStream()
+{
+    for (size_t i = 0; i < columns_.size(); i++)
+    {
+        close_column(columns_[i]);
+    }
+}
+
+/**
+ * Complete the current record. Makes the record visible to readers and
+ * triggers a flush every flush_interval records.
+ */
+void RecorderStream::end_record()
+{
+    // all values of the record must be in memory before it gets counted.
+    __sync_synchronize();
+    size_++;
+
+    const uint64_t count = size_;
+    for (size_t i = 0; i < columns_.size(); i++)
+    {
+        memcpy(columns_[i].mem_ + 24, &count, sizeof (count));
+    }
+
+    if (++unflushed_ >= flush_interval)
+    {
+        flush();
+    }
+}
+
+/**
+ * Schedule all dirty pages to be written to the files.
+ */
+void RecorderStream::flush()
+{
+    for (size_t i = 0; i < columns_.size(); i++)
+    {
+        const Column& column = columns_[i];
+        const size_t used = header_size + size_ * column.item_size_;
+        msync(column.mem_, std::min(used, column.mapped_size_), MS_ASYNC);
+    }
+    unflushed_ = 0;
+}
+
+/**
+ * Create the file of a column and write its header.
+ */
+void RecorderStream::open_column(Column& column, bool overwrite)
+{
+    const int flags = O_RDWR | O_CREAT | O_TRUNC | (overwrite ? 0 : O_EXCL);
+    column.fd_ = open(column.file_name_.c_str(), flags, 0644);
+
+    if (column.fd_ < 0)
+    {
+        throw nest::BadProperty(String::compose("RecorderStream: can not create file '%1': %2",
+                                                column.file_name_, strerror(errno)));
+    }
+
+    char header[header_size];
+    memset(header, 0, header_size);
+    memcpy(header, recorder_stream_magic, sizeof (recorder_stream_magic));
+    memcpy(header + 8, &recorder_stream_version, sizeof (recorder_stream_version));
+    memcpy(header + 12, &column.item_size_, sizeof (column.item_size_));
+    strncpy(header + 16, column.type_.c_str(), 8);
+    strncpy(header + 32, column.name_.c_str(), recorder_stream_name_size - 1);
+
+    if (pwrite(column.fd_, header, header_size, 0) != static_cast<ssize_t>(header_size))
+    {
+        throw nest::BadProperty(String::compose("RecorderStream: can not write file '%1': %2",
+                                                column.file_name_, strerror(errno)));
+    }
+}
+
+/**
+ * Resize the file of a column to hold \a capacity items and map it into memory.
+ */
+void RecorderStream::map_column(Column& column, size_t capacity)
+{
+    const size_t size = header_size + capacity * column.item_size_;
+
+    if (ftruncate(column.fd_, size) != 0)
+    {
+        throw nest::BadProperty(String::compose("RecorderStream: can not resize file '%1': %2",
+                                                column.file_name_, strerror(errno)));
+    }
+
+    if (column.mem_)
+    {
+        munmap(column.mem_, column.mapped_size_);
+        column.mem_ = 0;
+        column.mapped_size_ = 0;
+    }
+
+    void* mem = mmap(0, size, PROT_READ | PROT_WRITE, MAP_SHARED, column.fd_, 0);
+
+    if (mem == MAP_FAILED)
+    {
+        throw nest::BadProperty(String::compose("RecorderStream: can not map file '%1': %2",
+                                                column.file_name_, strerror(errno)));
+    }
+
+    column.mem_ = static_cast<char*>(mem);
+    column.mapped_size_ = size;
+}
+
+/**
+ * Flush, unmap and close the file of a column. The file is truncated to
+ * the records that have been written.
+ */
+void RecorderStream::close_column(Column& column)
+{
+    if (column.mem_)
+    {
+        msync(column.mem_, column.mapped_size_, MS_SYNC);
+        munmap(column.mem_, column.mapped_size_);
+        column.mem_ = 0;
+        column.mapped_size_ = 0;
+    }
+
+    if (column.fd_ >= 0)
+    {
+        if (ftruncate(column.fd_, header_size + size_ * column.item_size_) != 0)
+        {
+            // keep the file as it is, the header holds the number of valid records.
+        }
+        close(column.fd_);
+        column.fd_ = -1;
+    }
+}
+
+/**
+ * Double the capacity of all columns.
+ */
+void RecorderStream::grow()
+{
+    const size_t capacity = std::max(initial_capacity, 2 * capacity_);
+
+    for (size_t i = 0; i < columns_.size(); i++)
+    {
+        map_column(columns_[i], capacity);
+    }
+    capacity_ = capacity;
+}
+
+}
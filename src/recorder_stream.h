@@ -0,0 +1,167 @@
+/*
+ * This file is part of SPORE.
+ *
+ * Copyright (C) 2016, the SPORE team (see AUTHORS).
+ *
+ * SPORE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * SPORE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SPORE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * For more information see: https://github.com/IGITUGraz/spore-nest-module
+ *
+ * File:   recorder_stream.h
+ * Author: Kappel
+ *
+ * Created on October 18, 2026
+ */
+
+#ifndef RECORDER_STREAM_H
+#define RECORDER_STREAM_H
+
+#include <cassert>
+#include <string>
+#include <vector>
+
+#include <stdint.h>
+
+
+namespace spore
+{
+
+/**
+ * @brief Append-only columnar binary file writer for recorded data.
+ *
+ * A RecorderStream writes records of the form (port, time, v_1, ..., v_n)
+ * into one file per column. Each file starts with a header of
+ * RecorderStream::header_size bytes followed by the packed column data,
+ * such that the data is page-aligned and can be mapped directly, e.g. by
+ * numpy.memmap. The header layout is (all values in native byte order):
+ *
+ * <table>
+ * <tr><th>offset</th><th>type</th>     <th>content</th></tr>
+ * <tr><td>0</td>     <td>char[8]</td>  <td>magic string "SPOREREC"</td></tr>
+ * <tr><td>8</td>     <td>uint32</td>   <td>format version</td></tr>
+ * <tr><td>12</td>    <td>uint32</td>   <td>size of one item in bytes</td></tr>
+ * <tr><td>16</td>    <td>char[8]</td>  <td>numpy type string of the items, e.g. "<f8"</td></tr>
+ * <tr><td>24</td>    <td>uint64</td>   <td>number of complete records</td></tr>
+ * <tr><td>32</td>    <td>char[96]</td> <td>name of the column</td></tr>
+ * </table>
+ *
+ * Files are memory-mapped and grown geometrically, so appending a record
+ * costs O(1) and no recorded data is held in the process memory beyond the
+ * pages that are currently dirty. The record counter in the header is
+ * updated after the record was written, so readers always see complete
+ * records. Dirty pages are handed to the operating system every
+ * flush_interval records.
+ *
+ * A stream is not thread-safe. ConnectionDataLogger keeps one stream per
+ * thread.
+ */
+class RecorderStream
+{
+public:
+    static const size_t header_size = 4096;
+    static const size_t flush_interval = 65536;
+    static const size_t initial_capacity = 4096;
+
+    RecorderStream(const std::string& file_prefix, const std::vector<std::string>& value_names, bool overwrite);
+    ~RecorderStream();
+
+    /**
+     * Start a new record. Values of the record must be written using
+     * write() before end_record() is called.
+     *
+     * @param port the recorder port of the record.
+     * @param time the time of the record.
+     */
+    inline
+    void begin_record(uint64_t port, double time)
+    {
+        if (size_ == capacity_)
+        {
+            grow();
+        }
+        static_cast<uint64_t*>(data(0))[size_] = port;
+        static_cast<double*>(data(1))[size_] = time;
+    }
+
+    /**
+     * Write value \a v of the current record.
+     *
+     * @param id index of the recorded variable.
+     * @param v the value to write.
+     */
+    inline
+    void write(size_t id, double v)
+    {
+        assert(id + 2 < columns_.size());
+        static_cast<double*>(data(id + 2))[size_] = v;
+    }
+
+    void end_record();
+    void flush();
+
+    /**
+     * @return the number of complete records.
+     */
+    size_t size() const
+    {
+        return size_;
+    }
+
+    /**
+     * @return the file name of the column with the given index.
+     */
+    const std::string& get_file_name(size_t column) const
+    {
+        return columns_[column].file_name_;
+    }
+
+private:
+
+    /**
+     * @brief Memory-mapped file of one column.
+     */
+    struct Column
+    {
+        std::string name_;
+        std::string file_name_;
+        std::string type_;
+        uint32_t item_size_;
+        int fd_;
+        char* mem_;
+        size_t mapped_size_;
+    };
+
+    RecorderStream(const RecorderStream&);
+    RecorderStream& operator=(const RecorderStream&);
+
+    inline
+    void* data(size_t column) const
+    {
+        return columns_[column].mem_ + header_size;
+    }
+
+    void open_column(Column& column, bool overwrite);
+    void map_column(Column& column, size_t capacity);
+    void close_column(Column& column);
+    void grow();
+
+    std::vector<Column> columns_;
+    size_t size_;
+    size_t capacity_;
+    size_t unflushed_;
+};
+
+}
+
+#endif /* RECORDER_STREAM_H */
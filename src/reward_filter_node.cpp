@@ -0,0 +1,345 @@
+/*
+ * This file is part of SPORE.
+ *
+ * Copyright (C) 2016, the SPORE team (see AUTHORS).
+ *
+ * SPORE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * SPORE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SPORE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * For more information see: https://github.com/IGITUGraz/spore-nest-module
+ *
+ * File:   reward_filter_node.cpp
+ * Author: Kappel
+ *
+ * Created on October 18, 2026
+ */
+
+
+#include "reward_filter_node.h"
+
+#include "exceptions.h"
+#include "dict.h"
+#include "integerdatum.h"
+#include "doubledatum.h"
+#include "arraydatum.h"
+#include "dictutils.h"
+#include "kernel_manager.h"
+#include "compose.hpp"
+
+#include "spore_names.h"
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+
+namespace spore
+{
+
+/* ----------------------------------------------------------------
+ * Default constructors defining default parameters and state
+ * ---------------------------------------------------------------- */
+
+RewardFilterNode::Parameters_::Parameters_()
+: source_(-1)
+, source_trace_ids_(1, 0)
+, baseline_mode_(BASELINE_NONE)
+, baseline_tau_(1000.0)
+, baseline_min_(0.001)
+, reward_offset_(0.0)
+, clip_min_(-std::numeric_limits<double>::infinity())
+, clip_max_(std::numeric_limits<double>::infinity())
+, lowpass_tau_(0.0)
+, replicate_traces_(false)
+{
+}
+
+RewardFilterNode::State_::State_()
+{
+}
+
+/* ----------------------------------------------------------------
+ * Parameter extraction and manipulation functions
+ * ---------------------------------------------------------------- */
+
+void RewardFilterNode::Parameters_::get(DictionaryDatum& d) const
+{
+    const char* mode_names[] = { "none", "subtract", "divide" };
+
+    (*d)[ nest::names::source ] = source_;
+    (*d)[ names::source_trace_ids ] = source_trace_ids_;
+    (*d)[ names::baseline_mode ] = std::string(mode_names[baseline_mode_]);
+    (*d)[ names::baseline_tau ] = baseline_tau_;
+    (*d)[ names::baseline_min ] = baseline_min_;
+    (*d)[ names::reward_offset ] = reward_offset_;
+    (*d)[ names::clip_min ] = clip_min_;
+    (*d)[ names::clip_max ] = clip_max_;
+    (*d)[ names::lowpass_tau ] = lowpass_tau_;
+    (*d)[ names::replicate_traces ] = replicate_traces_;
+}
+
+void RewardFilterNode::Parameters_::set(const DictionaryDatum& d)
+{
+    long source;
+    if (updateValue< long >(d, nest::names::source, source))
+    {
+        if (source != -1 && dynamic_cast<TracingNode*> (nest::kernel().node_manager.get_node(source)) == 0)
+        {
+            throw nest::BadProperty("reward_filter_node: source must be of model TracingNode.");
+        }
+        source_ = source;
+    }
+
+    updateValue< std::vector< long > >(d, names::source_trace_ids, source_trace_ids_);
+
+    std::string mode;
+    if (updateValue< std::string >(d, names::baseline_mode, mode))
+    {
+        if (mode == "none")
+            baseline_mode_ = BASELINE_NONE;
+        else if (mode == "subtract")
+            baseline_mode_ = BASELINE_SUBTRACT;
+        else if (mode == "divide")
+            baseline_mode_ = BASELINE_DIVIDE;
+        else
+            throw nest::BadProperty("reward_filter_node: baseline_mode must be 'none', 'subtract' or 'divide'.");
+    }
+
+    updateValue< double >(d, names::baseline_tau, baseline_tau_);
+    updateValue< double >(d, names::baseline_min, baseline_min_);
+    updateValue< double >(d, names::reward_offset, reward_offset_);
+    updateValue< double >(d, names::clip_min, clip_min_);
+    updateValue< double >(d, names::clip_max, clip_max_);
+    updateValue< double >(d, names::lowpass_tau, lowpass_tau_);
+    updateValue< bool >(d, names::replicate_traces, replicate_traces_);
+
+    if (source_trace_ids_.empty())
+    {
+        throw nest::BadProperty("reward_filter_node: source_trace_ids must not be empty.");
+    }
+
+    for (size_t i = 0; i < source_trace_ids_.size(); i++)
+    {
+        if (source_trace_ids_[i] < 0)
+        {
+            throw nest::BadProperty("reward_filter_node: source_trace_ids must be positive.");
+        }
+    }
+
+    if (baseline_tau_ <= 0.0)
+    {
+        throw nest::BadProperty("reward_filter_node: baseline_tau must be larger than 0.");
+    }
+
+    if (baseline_min_ <= 0.0)
+    {
+        throw nest::BadProperty("reward_filter_node: baseline_min must be larger than 0.");
+    }
+
+    if (lowpass_tau_ < 0.0)
+    {
+        throw nest::BadProperty("reward_filter_node: lowpass_tau must be positive.");
+    }
+
+    if (clip_min_ > clip_max_)
+    {
+        throw nest::BadProperty("reward_filter_node: clip_min must not be larger than clip_max.");
+    }
+}
+
+void RewardFilterNode::State_::get(DictionaryDatum& d) const
+{
+    (*d)[ names::baseline ] = baseline_;
+    (*d)[ names::filtered_reward ] = filtered_reward_;
+}
+
+/* ----------------------------------------------------------------
+ * Default and copy constructor for node
+ * ---------------------------------------------------------------- */
+
+RewardFilterNode::RewardFilterNode()
+: TracingNode()
+, P_()
+, S_()
+{
+    V_.source_ = 0;
+}
+
+RewardFilterNode::RewardFilterNode(const RewardFilterNode& n)
+: TracingNode(n)
+, P_(n.P_)
+, S_(n.S_)
+{
+    V_.source_ = 0;
+}
+
+/* ----------------------------------------------------------------
+ * Node initialization functions
+ * ---------------------------------------------------------------- */
+
+void RewardFilterNode::init_state_(const Node& n)
+{
+    const RewardFilterNode& pr = downcast< RewardFilterNode >(n);
+    S_ = pr.S_;
+}
+
+void RewardFilterNode::init_buffers_()
+{
+}
+
+void RewardFilterNode::calibrate()
+{
+    const size_t n_channels = P_.source_trace_ids_.size();
+
+    // traces and filter states are only set up once
+    if (S_.filtered_reward_.size() != n_channels)
+    {
+        init_traces(n_channels, false, P_.replicate_traces_);
+        S_.baseline_.assign(n_channels, 0.0);
+        S_.filtered_reward_.assign(n_channels, 0.0);
+    }
+
+    V_.source_ = 0;
+    if (P_.source_ != -1)
+    {
+        V_.source_ = dynamic_cast<TracingNode*> (nest::kernel().node_manager.get_node(P_.source_, get_thread()));
+        if (V_.source_ == 0)
+        {
+            throw nest::BadProperty("reward_filter_node: source must be a local TracingNode.");
+        }
+
+        for (size_t i = 0; i < n_channels; i++)
+        {
+            if (static_cast<size_t>(P_.source_trace_ids_[i]) >= V_.source_->get_num_traces())
+            {
+                throw nest::BadProperty(String::compose("reward_filter_node: source %1 has no trace with id %2.",
+                                                        P_.source_, P_.source_trace_ids_[i]));
+            }
+        }
+    }
+
+    const double h = nest::Time::get_resolution().get_ms();
+    V_.baseline_decay_ = std::exp(-h / P_.baseline_tau_);
+    V_.lowpass_decay_ = (P_.lowpass_tau_ > 0.0) ? std::exp(-h / P_.lowpass_tau_) : 0.0;
+    V_.read_delay_ = nest::kernel().connection_manager.get_min_delay();
+}
+
+void RewardFilterNode::get_status(DictionaryDatum& d) const
+{
+    TracingNode::get_trace_status(d);
+
+    P_.get(d);
+    S_.get(d);
+
+    (*d)[nest::names::element_type] = LiteralDatum(nest::names::other);
+}
+
+void RewardFilterNode::set_status(const DictionaryDatum& d)
+{
+    Parameters_ ptmp = P_; // temporary copy in case of errors
+    ptmp.set(d); // throws if BadProperty
+
+    if (!S_.filtered_reward_.empty() &&
+        (ptmp.source_trace_ids_.size() != P_.source_trace_ids_.size() ||
+         ptmp.replicate_traces_ != P_.replicate_traces_))
+    {
+        throw nest::BadProperty("reward_filter_node: the number of channels and replicate_traces can not be "
+                                "changed after simulation startup.");
+    }
+
+    P_ = ptmp;
+}
+
+/**
+ * Apply baseline normalization, clipping and low-pass filtering to a single
+ * value of the given channel.
+ *
+ * @param reward the raw reward.
+ * @param channel the channel.
+ * @return the filtered reward.
+ */
+inline
+double RewardFilterNode::filter(double reward, size_t channel)
+{
+    double& baseline = S_.baseline_[channel];
+
+    switch (P_.baseline_mode_)
+    {
+    case BASELINE_SUBTRACT:
+        baseline = V_.baseline_decay_ * baseline + (1.0 - V_.baseline_decay_) * reward;
+        reward = reward - baseline + P_.reward_offset_;
+        break;
+    case BASELINE_DIVIDE:
+        baseline = std::max(V_.baseline_decay_ * baseline + (1.0 - V_.baseline_decay_) * reward, P_.baseline_min_);
+        reward = reward / baseline + P_.reward_offset_;
+        break;
+    default:
+        break;
+    }
+
+    reward = std::min(P_.clip_max_, std::max(P_.clip_min_, reward));
+
+    double& filtered = S_.filtered_reward_[channel];
+    filtered = V_.lowpass_decay_ * filtered + (1.0 - V_.lowpass_decay_) * reward;
+    return filtered;
+}
+
+/**
+ * Filter \a n_steps values of the source trace starting at iterator
+ * \a source into the trace of \a channel starting at \a step.
+ */
+template < typename IteratorT >
+void RewardFilterNode::filter_trace(IteratorT source, long step, long n_steps, size_t channel)
+{
+    for (long i = 0; i < n_steps; ++i, ++source)
+    {
+        set_trace(step + i, filter(*source, channel), channel);
+    }
+}
+
+void RewardFilterNode::update(const nest::Time& origin, const long from, const long to)
+{
+    if (V_.source_ == 0)
+    {
+        return;
+    }
+
+    // the source is assumed to be 0 before simulation startup
+    const long source_from = origin.get_steps() + from - V_.read_delay_;
+    const long lead = std::min(to - from, std::max(0L, -source_from));
+
+    for (size_t channel = 0; channel < P_.source_trace_ids_.size(); channel++)
+    {
+        const trace_id id = P_.source_trace_ids_[channel];
+        const long step = origin.get_steps() + from + lead;
+        const long n_steps = to - from - lead;
+
+        for (long i = 0; i < lead; i++)
+        {
+            set_trace(step - lead + i, filter(0.0, channel), channel);
+        }
+
+        if (V_.source_->has_piecewise_constant_traces())
+        {
+            filter_trace(V_.source_->get_piecewise_trace(source_from + lead, id, get_thread()),
+                         step, n_steps, channel);
+        }
+        else
+        {
+            filter_trace(V_.source_->get_trace(source_from + lead, id, get_thread()),
+                         step, n_steps, channel);
+        }
+    }
+}
+
+}
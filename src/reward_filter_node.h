@@ -0,0 +1,192 @@
+/*
+ * This file is part of SPORE.
+ *
+ * Copyright (C) 2016, the SPORE team (see AUTHORS).
+ *
+ * SPORE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * SPORE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SPORE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * For more information see: https://github.com/IGITUGraz/spore-nest-module
+ *
+ * File:   reward_filter_node.h
+ * Author: Kappel
+ *
+ * Created on October 18, 2026
+ */
+
+
+#ifndef REWARD_FILTER_NODE_H
+#define REWARD_FILTER_NODE_H
+
+#include <vector>
+
+#include "nest.h"
+#include "event.h"
+
+#include "tracing_node.h"
+
+namespace spore
+{
+
+/**
+ * @brief A node that preprocesses reward traces of another TracingNode.
+ *
+ * This node reads one or more traces of a source TracingNode, e.g. a
+ * RewardInProxy or RewardShmProxy that provides the raw reward, and
+ * exposes the preprocessed reward as traces that can be used as reward
+ * signal of synapses (using the \a reward_transmitter and \a dopa_trace_id
+ * parameters of the synapse model). Each channel is processed independently
+ * in three stages:
+ *
+ * 1. <b>Baseline normalization.</b> An exponential moving average
+ *    \f$b(t)\f$ of the raw reward \f$r(t)\f$ with time constant
+ *    \a baseline_tau is computed. If \a baseline_mode is "subtract" the
+ *    output is \f$r(t) - b(t) + r_0\f$, where \f$r_0\f$ is given by
+ *    \a reward_offset. If \a baseline_mode is "divide", the baseline is
+ *    bounded from below by \f$b_{min} > 0\f$ (\a baseline_min) and the
+ *    output is \f$r(t)/b(t) + r_0\f$. Negative rewards are divided by the
+ *    same positive baseline and therefore stay negative. To map them to a
+ *    constant instead, set \a clip_min. The normalization of the python
+ *    reward generators of the showcases is obtained with \a baseline_min
+ *    and \a clip_min set to \f$r_0\f$. The default mode "none" passes the
+ *    raw reward.
+ * 2. <b>Clipping</b> to the interval [\a clip_min, \a clip_max].
+ * 3. <b>Low-pass filtering</b> with time constant \a lowpass_tau. The
+ *    filter is disabled if \a lowpass_tau is 0.
+ *
+ * The source trace is read with a delay of one minimal delay, since the
+ * source may be updated in parallel on another thread. Channel \a i of
+ * this node reads trace \a source_trace_ids[i] of the source node.
+ *
+ * <b>Parameters</b>
+ *
+ * <table>
+ * <tr><th>name</th>                 <th>type</th>   <th>comment</th></tr>
+ * <tr><td>\a source</td>            <td>int</td>    <td>GID of the source TracingNode (-1)</td></tr>
+ * <tr><td>\a source_trace_ids</td>  <td>[int]</td>  <td>trace ids of the source, one per channel ([0])</td></tr>
+ * <tr><td>\a baseline_mode</td>     <td>string</td> <td>"none", "subtract" or "divide" ("none")</td></tr>
+ * <tr><td>\a baseline_tau</td>      <td>double</td> <td>time constant of the baseline (1000.0, &gt;0.0) [ms]
+ *                                                      </td></tr>
+ * <tr><td>\a baseline_min</td>      <td>double</td> <td>lower bound of the baseline in divide mode
+ *                                                      (0.001, &gt;0.0)</td></tr>
+ * <tr><td>\a reward_offset</td>     <td>double</td> <td>reward offset {\f$r_0\f$} (0.0)</td></tr>
+ * <tr><td>\a clip_min</td>          <td>double</td> <td>lower bound of the reward (-inf)</td></tr>
+ * <tr><td>\a clip_max</td>          <td>double</td> <td>upper bound of the reward (inf, &ge;clip_min)</td></tr>
+ * <tr><td>\a lowpass_tau</td>       <td>double</td> <td>time constant of the low-pass filter (0.0, &ge;0.0)
+ *                                                      [ms]</td></tr>
+ * <tr><td>\a replicate_traces</td>  <td>bool</td>   <td>keep a thread-local replica of the traces
+ *                                                      for every thread (false)</td></tr>
+ * </table>
+ *
+ * The current baselines and filtered rewards can be read out as the
+ * state variables \a baseline and \a filtered_reward.
+ *
+ * @see RewardInProxy, RewardShmProxy, SynapticSamplingRewardGradientConnection
+ */
+class RewardFilterNode : public TracingNode
+{
+public:
+
+    RewardFilterNode();
+    RewardFilterNode(const RewardFilterNode& n);
+
+    bool has_proxies() const
+    {
+        return false;
+    }
+
+    bool one_node_per_process() const
+    {
+        return true;
+    }
+
+    virtual void get_status(DictionaryDatum& d) const;
+    virtual void set_status(const DictionaryDatum& d);
+
+protected:
+
+    virtual void init_buffers_();
+    virtual void init_state_(const Node&);
+
+    virtual void calibrate();
+
+    virtual void update(nest::Time const&, const long, const long);
+
+    // ------------------------------------------------------------
+
+    enum BaselineMode
+    {
+        BASELINE_NONE = 0,
+        BASELINE_SUBTRACT,
+        BASELINE_DIVIDE
+    };
+
+    /**
+     * @brief Class holding parameter variables of the node.
+     */
+    struct Parameters_
+    {
+        Parameters_(); //!< Sets default parameter values
+
+        void get(DictionaryDatum&) const; //!< Store current values in dictionary
+        void set(const DictionaryDatum&); //!< Set values from dicitonary
+
+        long source_; //!< GID of the source node
+        std::vector< long > source_trace_ids_; //!< trace ids of the source node
+        BaselineMode baseline_mode_; //!< type of baseline normalization
+        double baseline_tau_; //!< time constant of the baseline in ms
+        double baseline_min_; //!< lower bound of the baseline in divide mode
+        double reward_offset_; //!< offset of the normalized reward
+        double clip_min_; //!< lower bound of the reward
+        double clip_max_; //!< upper bound of the reward
+        double lowpass_tau_; //!< time constant of the low-pass filter in ms
+        bool replicate_traces_; //!< keep a replica of the traces for every thread
+    };
+
+    /**
+     * @brief Class holding state variables of the node.
+     */
+    struct State_
+    {
+        State_(); //!< Sets default state value
+
+        void get(DictionaryDatum&) const; //!< Store current values in dictionary
+
+        std::vector< double > baseline_; //!< current baseline of each channel
+        std::vector< double > filtered_reward_; //!< current output of each channel
+    };
+
+    /**
+     * @brief Class holding internal variables of the node.
+     */
+    struct Variables_
+    {
+        TracingNode* source_; //!< the source node
+        double baseline_decay_; //!< decay factor of the baseline per time step
+        double lowpass_decay_; //!< decay factor of the low-pass filter per time step
+        long read_delay_; //!< delay of reading the source trace in steps
+    };
+
+    double filter(double reward, size_t channel);
+
+    template < typename IteratorT >
+    void filter_trace(IteratorT source, long step, long n_steps, size_t channel);
+
+    Parameters_ P_;
+    State_ S_;
+    Variables_ V_;
+};
+
+}
+
+#endif
@@ -26,10 +26,13 @@
  * See: http://nest-initiative.org/
  */
 
+#include "config.h"
+
+#ifdef HAVE_MUSIC
+
 #include "reward_in_proxy.h"
 
 #include "spore.h"
-#include "config.h"
 #include "exceptions.h"
 #include "dict.h"
 #include "integerdatum.h"
@@ -51,9 +54,6 @@
 
 namespace spore
 {
-#ifndef HAVE_MUSIC
-#error MUSIC bindings for NEST are required.
-#endif
 
 /* ----------------------------------------------------------------
  * Default constructors defining default parameters, state and buffer
@@ -62,6 +62,8 @@ namespace spore
 RewardInProxy::Parameters_::Parameters_()
 : port_name_("reward_in")
 , delay_(0.0)
+, piecewise_constant_(false)
+, replicate_traces_(false)
 {
 }
 
@@ -79,6 +81,8 @@ void RewardInProxy::Parameters_::get(DictionaryDatum& d) const
 {
     (*d)[ nest::names::port_name ] = port_name_;
     (*d)[ names::delay ] = delay_;
+    (*d)[ names::piecewise_constant ] = piecewise_constant_;
+    (*d)[ names::replicate_traces ] = replicate_traces_;
 }
 
 void RewardInProxy::Parameters_::set(const DictionaryDatum& d, State_& s)
@@ -87,6 +91,8 @@ void RewardInProxy::Parameters_::set(const DictionaryDatum& d, State_& s)
     {
         updateValue< string >(d, nest::names::port_name, port_name_);
         updateValue< float >(d, names::delay, delay_);
+        updateValue< bool >(d, names::piecewise_constant, piecewise_constant_);
+        updateValue< bool >(d, names::replicate_traces, replicate_traces_);
     }
     else
     {
@@ -153,7 +159,7 @@ void RewardInProxy::calibrate()
             reward_in_->map(&data_map, P_.delay_, true);
             S_.published_ = true;
 
-            init_traces(S_.port_width_);
+            init_traces(S_.port_width_, P_.piecewise_constant_, P_.replicate_traces_);
 
             std::string msg = String::compose("Mapping MUSIC input port '%1' with width=%2.",
                                               P_.port_name_, S_.port_width_);
@@ -194,6 +200,17 @@ void RewardInProxy::update(const nest::Time& origin, const long from, const long
         return;
     }
 
+    if (P_.piecewise_constant_)
+    {
+        // MUSIC updates the input buffer only once per slice, so the values
+        // can only change at the first step of the slice.
+        for (int channel = 0; channel < n_channels; channel++)
+        {
+            set_trace(origin.get_steps() + from, reward_in_buffer_[channel], channel);
+        }
+        return;
+    }
+
     for (long lag = from; lag < to; ++lag)
     {
         nest::Time time = nest::Time::step(origin.get_steps() + lag);
@@ -205,3 +222,5 @@ void RewardInProxy::update(const nest::Time& origin, const long from, const long
 }
 
 }
+
+#endif /* HAVE_MUSIC */
@@ -29,6 +29,10 @@
 #ifndef REWARD_IN_PROXY_H
 #define REWARD_IN_PROXY_H
 
+#include "config.h"
+
+#ifdef HAVE_MUSIC
+
 #include "nest.h"
 #include "event.h"
 #include "ring_buffer.h"
@@ -53,8 +57,21 @@ namespace spore
  * A typical application for this node is to receive a reward signal and
  * communicate it to synapses that are trained using reward-modulated
  * plasticity. The number of traces that are received by this device is given
- * by the width of the MUSIC port. The received traces can be read out using
- * the TracingNode::get_trace() member function.
+ * by the width of the MUSIC port.
+ *
+ * By default, traces are dense traces that hold one value per time step and
+ * are read using TracingNode::get_trace(). Since MUSIC only updates
+ * continuous inputs once per time slice, setting \a piecewise_constant to
+ * \c true stores piecewise constant traces instead, such that only changes
+ * of the reward signal are recorded. Synapses can then integrate stretches
+ * of constant reward at once. These traces must be read out using the
+ * TracingNode::get_piecewise_trace() member function. The reward synapse
+ * models of this module and RewardFilterNode check
+ * TracingNode::has_piecewise_constant_traces() and support both kinds.
+ *
+ * If \a replicate_traces is set to \c true, connections on other threads
+ * read from thread-local replicas of the traces (see TracingNode). This
+ * avoids cross-thread cache traffic on machines with many cores.
  * 
  * @see SynapticSamplingRewardGradientConnection
  */
@@ -116,6 +133,8 @@ protected:
 
         std::string port_name_; //!< the name of MUSIC port to read from
         float delay_; //!< the accepted delay for the MUSIC connection
+        bool piecewise_constant_; //!< store traces as runs of constant values
+        bool replicate_traces_; //!< keep a replica of the traces for every thread
     };
 
     State_ S_;
@@ -124,4 +143,6 @@ protected:
 
 }
 
+#endif /* HAVE_MUSIC */
+
 #endif
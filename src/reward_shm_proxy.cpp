@@ -0,0 +1,411 @@
+/*
+ * This file is part of SPORE.
+ *
+ * Copyright (C) 2016, the SPORE team (see AUTHORS).
+ *
+ * SPORE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * SPORE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SPORE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * For more information see: https://github.com/IGITUGraz/spore-nest-module
+ *
+ * File:   reward_shm_proxy.cpp
+ * Author: Kappel
+ *
+ * Created on October 18, 2026
+ */
+
+#include "reward_shm_proxy.h"
+
+#include "exceptions.h"
+#include "dict.h"
+#include "integerdatum.h"
+#include "dictutils.h"
+#include "kernel_manager.h"
+#include "logging.h"
+#include "compose.hpp"
+
+#include "spore_names.h"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+
+
+namespace spore
+{
+
+const uint64_t RewardShmProxy::shm_magic;
+const uint32_t RewardShmProxy::shm_version;
+const int RewardShmProxy::attach_attempts;
+
+/* ----------------------------------------------------------------
+ * Default constructors defining default parameters, state and buffer
+ * ---------------------------------------------------------------- */
+
+RewardShmProxy::Parameters_::Parameters_()
+: shm_name_("/spore_reward")
+, n_channels_(1)
+, buffer_size_(1024)
+, piecewise_constant_(false)
+, replicate_traces_(false)
+{
+}
+
+RewardShmProxy::State_::State_()
+: attached_(false)
+, consumed_(0)
+{
+}
+
+/* ----------------------------------------------------------------
+ * Parameter extraction and manipulation functions
+ * ---------------------------------------------------------------- */
+
+void RewardShmProxy::Parameters_::get(DictionaryDatum& d) const
+{
+    (*d)[ names::shm_name ] = shm_name_;
+    (*d)[ names::n_channels ] = n_channels_;
+    (*d)[ names::buffer_size ] = buffer_size_;
+    (*d)[ names::piecewise_constant ] = piecewise_constant_;
+    (*d)[ names::replicate_traces ] = replicate_traces_;
+}
+
+void RewardShmProxy::Parameters_::set(const DictionaryDatum& d, State_& s)
+{
+    if (s.attached_)
+    {
+        throw nest::BadProperty("reward_shm_proxy: parameters can not be changed after "
+                                "the shared memory segment was attached.");
+    }
+
+    updateValue< std::string >(d, names::shm_name, shm_name_);
+    updateValue< long >(d, names::n_channels, n_channels_);
+    updateValue< long >(d, names::buffer_size, buffer_size_);
+    updateValue< bool >(d, names::piecewise_constant, piecewise_constant_);
+    updateValue< bool >(d, names::replicate_traces, replicate_traces_);
+
+    if (shm_name_.empty() || shm_name_[0] != '/')
+    {
+        throw nest::BadProperty("reward_shm_proxy: shm_name must start with '/'.");
+    }
+
+    if (n_channels_ <= 0)
+    {
+        throw nest::BadProperty("reward_shm_proxy: n_channels must be larger than 0.");
+    }
+
+    if (buffer_size_ <= 0)
+    {
+        throw nest::BadProperty("reward_shm_proxy: buffer_size must be larger than 0.");
+    }
+}
+
+void RewardShmProxy::State_::get(DictionaryDatum& d) const
+{
+    (*d)[ names::attached ] = attached_;
+    (*d)[ names::consumed ] = consumed_;
+}
+
+/* ----------------------------------------------------------------
+ * Default and copy constructor for node
+ * ---------------------------------------------------------------- */
+
+RewardShmProxy::RewardShmProxy()
+: TracingNode()
+, S_()
+, P_()
+, header_(0)
+, mapped_size_(0)
+{
+}
+
+RewardShmProxy::RewardShmProxy(const RewardShmProxy& n)
+: TracingNode(n)
+, S_()
+, P_(n.P_)
+, header_(0)
+, mapped_size_(0)
+{
+}
+
+RewardShmProxy::~RewardShmProxy()
+{
+    detach();
+}
+
+/* ----------------------------------------------------------------
+ * Node initialization functions
+ * ---------------------------------------------------------------- */
+
+void RewardShmProxy::init_state_(const Node& n)
+{
+}
+
+void RewardShmProxy::init_buffers_()
+{
+}
+
+void RewardShmProxy::calibrate()
+{
+    // only attach to the segment once
+    if (!S_.attached_)
+    {
+        attach();
+        reward_in_buffer_.assign(P_.n_channels_, 0.0);
+        init_traces(P_.n_channels_, P_.piecewise_constant_, P_.replicate_traces_);
+    }
+}
+
+/**
+ * Map the shared memory segment. The segment is created and its header is
+ * initialized if it does not exist yet.
+ */
+void RewardShmProxy::attach()
+{
+    std::string name = P_.shm_name_;
+    if (nest::kernel().mpi_manager.get_num_processes() > 1)
+    {
+        name += String::compose("_%1", nest::kernel().mpi_manager.get_rank());
+    }
+
+    const size_t entry_size = sizeof(int64_t) + P_.n_channels_ * sizeof(double);
+    const size_t required_size = sizeof(RewardShmHeader) + P_.buffer_size_ * entry_size;
+
+    // only the process that creates the segment sizes and initializes it.
+    // An existing segment is opened instead, and created again if it was
+    // removed in between.
+    int fd = -1;
+    int error = ENOENT;
+    bool created = false;
+    for (int attempt = 0; fd == -1 && error == ENOENT && attempt < attach_attempts; attempt++)
+    {
+        fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+        created = (fd != -1);
+        error = errno;
+        if (fd == -1 && error == EEXIST)
+        {
+            fd = shm_open(name.c_str(), O_RDWR, 0600);
+            error = errno;
+        }
+    }
+
+    if (fd == -1)
+    {
+        throw nest::BadProperty(String::compose("reward_shm_proxy: can not open shared memory "
+                                                "segment '%1': %2", name, strerror(error)));
+    }
+
+    // wait until the creator of an existing segment has sized it.
+    struct stat st;
+    for (int attempt = 0; ; attempt++)
+    {
+        if (fstat(fd, &st) == -1)
+        {
+            error = errno;
+            close(fd);
+            throw nest::BadProperty(String::compose("reward_shm_proxy: can not stat shared memory "
+                                                    "segment '%1': %2", name, strerror(error)));
+        }
+        if (created || st.st_size > 0 || attempt >= attach_attempts)
+        {
+            break;
+        }
+        usleep(1000);
+    }
+
+    if (created && ftruncate(fd, required_size) == -1)
+    {
+        error = errno;
+        close(fd);
+        throw nest::BadProperty(String::compose("reward_shm_proxy: can not resize shared memory "
+                                                "segment '%1': %2", name, strerror(error)));
+    }
+
+    const size_t size = created ? required_size : static_cast<size_t>(st.st_size);
+    if (size == 0)
+    {
+        close(fd);
+        throw nest::BadProperty(String::compose("reward_shm_proxy: shared memory segment '%1' "
+                                                "was not initialized by its creator.", name));
+    }
+
+    void* mem = mmap(0, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    error = errno;
+    close(fd);
+
+    if (mem == MAP_FAILED)
+    {
+        throw nest::BadProperty(String::compose("reward_shm_proxy: can not map shared memory "
+                                                "segment '%1': %2", name, strerror(error)));
+    }
+
+    header_ = static_cast<RewardShmHeader*> (mem);
+    mapped_size_ = size;
+
+    if (created)
+    {
+        header_->version = shm_version;
+        header_->n_channels = P_.n_channels_;
+        header_->capacity = P_.buffer_size_;
+        header_->entry_size = entry_size;
+        header_->write_index = 0;
+        header_->read_index = 0;
+        __sync_synchronize();
+        header_->magic = shm_magic;
+    }
+    else
+    {
+        // the creator publishes the header by writing the magic number last.
+        const volatile uint64_t* magic = &header_->magic;
+        for (int attempt = 0;
+             size >= sizeof(RewardShmHeader) && *magic != shm_magic && attempt < attach_attempts;
+             attempt++)
+        {
+            usleep(1000);
+        }
+        __sync_synchronize();
+
+        if (size < sizeof(RewardShmHeader) ||
+            header_->magic != shm_magic ||
+            header_->version != shm_version ||
+            header_->n_channels != static_cast<uint32_t>(P_.n_channels_) ||
+            header_->entry_size != entry_size ||
+            size < sizeof(RewardShmHeader) + header_->capacity * entry_size)
+        {
+            detach();
+            throw nest::BadProperty(String::compose("reward_shm_proxy: shared memory segment '%1' "
+                                                    "has an incompatible layout (expected %2 channels).",
+                                                    name, P_.n_channels_));
+        }
+    }
+
+    S_.attached_ = true;
+    S_.consumed_ = 0;
+
+    std::string msg = String::compose("Attached to shared memory segment '%1' with %2 channels "
+                                      "and %3 entries.", name, P_.n_channels_, header_->capacity);
+    LOG(nest::M_INFO, "reward_shm_proxy::calibrate()", msg.c_str());
+}
+
+/**
+ * Unmap the shared memory segment. The segment itself is not removed, such
+ * that the producer can continue to use it.
+ */
+void RewardShmProxy::detach()
+{
+    if (header_)
+    {
+        munmap(header_, mapped_size_);
+        header_ = 0;
+        mapped_size_ = 0;
+    }
+}
+
+/**
+ * Consume all entries of the ring buffer that are due at the given step.
+ *
+ * @return true if at least one entry was consumed.
+ */
+bool RewardShmProxy::consume(long step)
+{
+    const uint64_t write_index = header_->write_index;
+    uint64_t read_index = header_->read_index;
+
+    if (read_index == write_index)
+    {
+        return false;
+    }
+
+    // make sure entries are read after the producer's index
+    __sync_synchronize();
+
+    const char* entries = reinterpret_cast<const char*> (header_ + 1);
+    const uint64_t capacity = header_->capacity;
+    const size_t entry_size = header_->entry_size;
+
+    while (read_index < write_index)
+    {
+        const char* entry = entries + (read_index % capacity) * entry_size;
+
+        int64_t entry_step;
+        memcpy(&entry_step, entry, sizeof(int64_t));
+
+        if (entry_step > step)
+        {
+            break;
+        }
+
+        memcpy(&reward_in_buffer_[0], entry + sizeof(int64_t), P_.n_channels_ * sizeof(double));
+        ++read_index;
+        ++S_.consumed_;
+    }
+
+    if (read_index == header_->read_index)
+    {
+        return false;
+    }
+
+    // release the slots only after they have been read
+    __sync_synchronize();
+    header_->read_index = read_index;
+    return true;
+}
+
+void RewardShmProxy::get_status(DictionaryDatum& d) const
+{
+    TracingNode::get_trace_status(d);
+
+    P_.get(d);
+    S_.get(d);
+
+    (*d)[nest::names::element_type] = LiteralDatum(nest::names::other);
+}
+
+void RewardShmProxy::set_status(const DictionaryDatum& d)
+{
+    Parameters_ ptmp = P_; // temporary copy in case of errors
+    ptmp.set(d, S_); // throws if BadProperty
+    P_ = ptmp;
+}
+
+void RewardShmProxy::update(const nest::Time& origin, const long from, const long to)
+{
+    if (!S_.attached_)
+    {
+        return;
+    }
+
+    const long n_channels = P_.n_channels_;
+
+    for (long lag = from; lag < to; ++lag)
+    {
+        const long step = origin.get_steps() + lag;
+        const bool changed = consume(step);
+
+        if (P_.piecewise_constant_ && !changed)
+        {
+            // piecewise constant traces hold their value until it is set again
+            continue;
+        }
+
+        for (long channel = 0; channel < n_channels; channel++)
+        {
+            set_trace(step, reward_in_buffer_[channel], channel);
+        }
+    }
+}
+
+}
@@ -0,0 +1,186 @@
+/*
+ * This file is part of SPORE.
+ *
+ * Copyright (C) 2016, the SPORE team (see AUTHORS).
+ *
+ * SPORE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * SPORE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SPORE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * For more information see: https://github.com/IGITUGraz/spore-nest-module
+ *
+ * File:   reward_shm_proxy.h
+ * Author: Kappel
+ *
+ * Created on October 18, 2026
+ */
+
+#ifndef REWARD_SHM_PROXY_H
+#define REWARD_SHM_PROXY_H
+
+#include <stdint.h>
+
+#include "nest.h"
+#include "event.h"
+
+#include "tracing_node.h"
+
+namespace spore
+{
+
+/**
+ * @brief Header of the shared memory segment read by RewardShmProxy.
+ *
+ * The segment starts with this header, followed by \a capacity entries of
+ * \a entry_size bytes each. Every entry holds the simulation step (int64) at
+ * which the values become active, followed by \a n_channels doubles. The
+ * write and read indices are monotonically increasing counters that live on
+ * separate cache lines. Only the producer writes \a write_index and only the
+ * proxy writes \a read_index.
+ */
+struct RewardShmHeader
+{
+    uint64_t magic; //!< must be RewardShmProxy::shm_magic
+    uint32_t version; //!< layout version, must be RewardShmProxy::shm_version
+    uint32_t n_channels; //!< number of reward channels per entry
+    uint64_t capacity; //!< number of entries in the ring
+    uint64_t entry_size; //!< size of one entry in bytes
+    char pad0_[32];
+    volatile uint64_t write_index; //!< number of entries written by the producer
+    char pad1_[56];
+    volatile uint64_t read_index; //!< number of entries consumed by the proxy
+    char pad2_[56];
+};
+
+/**
+ * @brief A device that receives reward traces through POSIX shared memory.
+ *
+ * This device provides the same traces as RewardInProxy but does not require
+ * MUSIC or MPI. Reward values are read from a lock-free single-producer,
+ * single-consumer ring buffer in a POSIX shared memory segment (see
+ * RewardShmHeader for the layout). Any local process can feed rewards by
+ * appending entries of the form (step, value_0, ..., value_n) to the ring.
+ * An entry becomes active at the given simulation step and stays active
+ * until the next entry is due. Entries that are due in the past are applied
+ * immediately. The segment is created on calibration if it does not exist
+ * yet. Only the process that creates the segment sizes and initializes it,
+ * other processes wait up to attach_attempts milliseconds for its header.
+ * If NEST runs with multiple processes, the rank is appended to the
+ * segment name such that every process has its own producer.
+ *
+ * By default, traces are dense traces that are read with
+ * TracingNode::get_trace(). Set \a piecewise_constant to \c true to store
+ * piecewise constant traces instead (see TracingNode::get_piecewise_trace()),
+ * such that the proxy only does work when new entries are consumed. If
+ * \a replicate_traces is set, connections on other threads read from
+ * thread-local replicas of the traces (see TracingNode).
+ *
+ * A python reference producer can be found in utils/spore_shm.py.
+ *
+ * <b>Parameters</b>
+ *
+ * <table>
+ * <tr><th>name</th>             <th>type</th>   <th>comment</th></tr>
+ * <tr><td>\a shm_name</td>      <td>string</td> <td>name of the shared memory segment
+ *                                                  ("/spore_reward")</td></tr>
+ * <tr><td>\a n_channels</td>    <td>int</td>    <td>number of reward channels (1, &gt; 0)</td></tr>
+ * <tr><td>\a buffer_size</td>   <td>int</td>    <td>number of entries of the ring buffer if
+ *                                                  the segment is created (1024, &gt; 0)</td></tr>
+ * <tr><td>\a piecewise_constant</td> <td>bool</td> <td>store traces as runs of constant values
+ *                                                  (false)</td></tr>
+ * <tr><td>\a replicate_traces</td> <td>bool</td>   <td>keep a thread-local replica of the traces
+ *                                                  for every thread (false)</td></tr>
+ * </table>
+ *
+ * @see RewardInProxy, SynapticSamplingRewardGradientConnection
+ */
+class RewardShmProxy : public TracingNode
+{
+public:
+
+    static const uint64_t shm_magic = 0x4d485345524f5053ULL; //!< "SPORESHM"
+    static const uint32_t shm_version = 1;
+    static const int attach_attempts = 1000; //!< attempts to attach to a segment that is being created
+
+    RewardShmProxy();
+    RewardShmProxy(const RewardShmProxy& n);
+    ~RewardShmProxy();
+
+    bool has_proxies() const
+    {
+        return false;
+    }
+
+    bool one_node_per_process() const
+    {
+        return true;
+    }
+
+    virtual void get_status(DictionaryDatum& d) const;
+    virtual void set_status(const DictionaryDatum& d);
+
+protected:
+
+    virtual void init_buffers_();
+    virtual void init_state_(const Node&);
+
+    virtual void calibrate();
+
+    virtual void update(nest::Time const&, const long, const long);
+
+    void attach();
+    void detach();
+    bool consume(long step);
+
+    // ------------------------------------------------------------
+
+    /**
+     * @brief Class holding state variables of the proxy.
+     */
+    struct State_
+    {
+        State_(); //!< Sets default state value
+
+        void get(DictionaryDatum&) const; //!< Store current values in dictionary
+
+        bool attached_; //!< indicates whether the shared memory segment is mapped
+        long consumed_; //!< number of entries consumed since attaching
+    };
+
+    /**
+     * @brief Class holding parameter variables of the proxy.
+     */
+    struct Parameters_
+    {
+        Parameters_(); //!< Sets default parameter values
+
+        void get(DictionaryDatum&) const; //!< Store current values in dictionary
+        void set(const DictionaryDatum&, State_&); //!< Set values from dicitonary
+
+        std::string shm_name_; //!< the name of the shared memory segment
+        long n_channels_; //!< the number of reward channels
+        long buffer_size_; //!< the number of ring buffer entries
+        bool piecewise_constant_; //!< store traces as runs of constant values
+        bool replicate_traces_; //!< keep a replica of the traces for every thread
+    };
+
+    State_ S_;
+    Parameters_ P_;
+
+    RewardShmHeader* header_; //!< the mapped shared memory segment
+    size_t mapped_size_; //!< size of the mapped segment in bytes
+    std::vector< double > reward_in_buffer_; //!< the currently active reward values
+};
+
+}
+
+#endif
@@ -0,0 +1,188 @@
+/*
+ * This file is part of SPORE.
+ *
+ * Copyright (C) 2016, the SPORE team (see AUTHORS).
+ *
+ * SPORE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * SPORE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SPORE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * For more information see: https://github.com/IGITUGraz/spore-nest-module
+ *
+ * File:   segmented_vector.h
+ * Author: Kappel
+ *
+ * Created on October 18, 2026
+ */
+
+
+#ifndef SEGMENTED_VECTOR_H
+#define SEGMENTED_VECTOR_H
+
+#include <cassert>
+#include <cstddef>
+
+
+namespace spore
+{
+
+/**
+ * @brief An append-only vector that allows lock-free concurrent appends.
+ *
+ * Elements are stored in segments of geometrically growing size, such that
+ * elements never move once they have been appended. push_back() reserves a
+ * slot using an atomic counter and allocates missing segments using
+ * compare-and-swap, so any number of threads can append concurrently
+ * without locking. Elements can be accessed concurrently, given that each
+ * thread only accesses elements that were appended before, e.g. by itself.
+ *
+ * @note clear() and the destructor must not be called concurrently with
+ * other member functions.
+ */
+template<typename T>
+class SegmentedVector
+{
+public:
+
+    /**
+     * Default constructor.
+     */
+    SegmentedVector()
+    : size_(0)
+    {
+        for (size_t k = 0; k < max_segments; k++)
+            segments_[k] = 0;
+    }
+
+    /**
+     * Destructor.
+     */
+    ~SegmentedVector()
+    {
+        clear();
+    }
+
+    /**
+     * Append a copy of v to the vector. This function is thread-safe.
+     *
+     * @return the index of the new element.
+     */
+    size_t push_back(const T& v)
+    {
+        const size_t index = __sync_fetch_and_add(&size_, 1);
+        assert(index < max_size());
+
+        size_t offset;
+        const size_t k = get_segment(index, offset);
+
+        T* segment = segments_[k];
+        if (segment == 0)
+        {
+            // the first thread to install the segment wins
+            T* new_segment = new T[segment_size(k)];
+            segment = __sync_val_compare_and_swap(&segments_[k], static_cast<T*>(0), new_segment);
+            if (segment == 0)
+                segment = new_segment;
+            else
+                delete[] new_segment;
+        }
+
+        segment[offset] = v;
+        return index;
+    }
+
+    /**
+     * Returns the element at the given index.
+     */
+    inline
+    T& operator[](size_t index)
+    {
+        size_t offset;
+        const size_t k = get_segment(index, offset);
+        assert(segments_[k]);
+        return segments_[k][offset];
+    }
+
+    /**
+     * Returns the element at the given index.
+     */
+    inline
+    T const& operator[](size_t index) const
+    {
+        size_t offset;
+        const size_t k = get_segment(index, offset);
+        assert(segments_[k]);
+        return segments_[k][offset];
+    }
+
+    /**
+     * Returns the number of elements. Elements that are currently appended
+     * by other threads are included.
+     */
+    size_t size() const
+    {
+        return size_;
+    }
+
+    /**
+     * Returns the maximum number of elements.
+     */
+    static size_t max_size()
+    {
+        return base_size * ((size_t(1) << max_segments) - 1);
+    }
+
+    /**
+     * Erase all elements and free the memory.
+     */
+    void clear()
+    {
+        for (size_t k = 0; k < max_segments; k++)
+        {
+            delete[] segments_[k];
+            segments_[k] = 0;
+        }
+        size_ = 0;
+    }
+
+private:
+
+    static const size_t base_size = 64; //!< size of the first segment
+    static const size_t max_segments = 40; //!< segment k holds base_size * 2^k elements
+
+    static size_t segment_size(size_t k)
+    {
+        return base_size << k;
+    }
+
+    /**
+     * Computes the segment and the offset into the segment of the given index.
+     */
+    static inline
+    size_t get_segment(size_t index, size_t& offset)
+    {
+        const size_t j = index / base_size + 1;
+        const size_t k = (sizeof(unsigned long) * 8 - 1) - __builtin_clzl(j);
+        offset = index - base_size * ((size_t(1) << k) - 1);
+        return k;
+    }
+
+    T* volatile segments_[max_segments];
+    volatile size_t size_;
+
+    SegmentedVector(const SegmentedVector&); // not copyable
+    SegmentedVector& operator=(const SegmentedVector&);
+};
+
+}
+
+#endif /* SEGMENTED_VECTOR_H */
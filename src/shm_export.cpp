@@ -0,0 +1,137 @@
+/*
+ * This file is part of SPORE.
+ *
+ * Copyright (C) 2016, the SPORE team (see AUTHORS).
+ *
+ * SPORE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * SPORE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SPORE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * For more information see: https://github.com/IGITUGraz/spore-nest-module
+ *
+ * File:   shm_export.cpp
+ * Author: Kappel
+ *
+ * Created on October 18, 2026
+ */
+
+#include "shm_export.h"
+
+#include "exceptions.h"
+#include "compose.hpp"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+
+
+namespace spore
+{
+
+const uint64_t ShmExport::shm_magic;
+const uint32_t ShmExport::shm_version;
+const size_t ShmExport::header_size;
+const size_t ShmExport::name_size;
+
+/**
+ * Constructor. Creates the shared memory segment \a name, or replaces its
+ * content if it already exists, and writes the header. The content of the
+ * arrays must be filled in by the caller.
+ *
+ * @param name name of the segment, must start with '/'.
+ * @param kind content of the segment.
+ * @param n_rows number of rows.
+ * @param n_samples total number of samples of all rows.
+ * @param columns names of the columns.
+ */
+ShmExport::ShmExport(const std::string& name, Kind kind, size_t n_rows, size_t n_samples,
+                     const std::vector<std::string>& columns)
+: header_(0),
+mem_(0),
+size_(0),
+n_rows_(n_rows),
+n_samples_(n_samples)
+{
+    if (name.empty() || name[0] != '/')
+    {
+        throw nest::BadProperty("ShmExport: name of the shared memory segment must start with '/'.");
+    }
+
+    if (sizeof (ShmExportHeader) + columns.size() * name_size > header_size)
+    {
+        throw nest::BadProperty(String::compose("ShmExport: too many columns (%1).", columns.size()));
+    }
+
+    size_ = header_size + (3 * n_rows + 1) * sizeof (uint64_t) + columns.size() * n_samples * sizeof (double);
+
+    const int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+    if (fd == -1)
+    {
+        throw nest::BadProperty(String::compose("ShmExport: can not open shared memory "
+                                                "segment '%1': %2", name, strerror(errno)));
+    }
+
+    if (ftruncate(fd, size_) == -1)
+    {
+        const int error = errno;
+        close(fd);
+        throw nest::BadProperty(String::compose("ShmExport: can not resize shared memory "
+                                                "segment '%1': %2", name, strerror(error)));
+    }
+
+    void* mem = mmap(0, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    const int error = errno;
+    close(fd);
+
+    if (mem == MAP_FAILED)
+    {
+        throw nest::BadProperty(String::compose("ShmExport: can not map shared memory "
+                                                "segment '%1': %2", name, strerror(error)));
+    }
+
+    mem_ = static_cast<char*>(mem);
+    header_ = static_cast<ShmExportHeader*>(mem);
+
+    header_->version = shm_version;
+    header_->kind = kind;
+    header_->n_rows = n_rows;
+    header_->n_samples = n_samples;
+    header_->n_columns = columns.size();
+    header_->t0 = 0.0;
+    header_->dt = 0.0;
+    header_->reserved = 0;
+
+    for (size_t i = 0; i < columns.size(); i++)
+    {
+        strncpy(mem_ + sizeof (ShmExportHeader) + i * name_size, columns[i].c_str(), name_size - 1);
+    }
+}
+
+/**
+ * Destructor. Marks the segment as complete and unmaps it. The segment
+ * itself is not removed.
+ */
+ShmExport::~ShmExport()
+{
+    if (mem_)
+    {
+        // all data must be in memory before the segment is marked as valid.
+        __sync_synchronize();
+        header_->magic = shm_magic;
+        munmap(mem_, size_);
+    }
+}
+
+}
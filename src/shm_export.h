@@ -0,0 +1,141 @@
+/*
+ * This file is part of SPORE.
+ *
+ * Copyright (C) 2016, the SPORE team (see AUTHORS).
+ *
+ * SPORE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * SPORE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SPORE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * For more information see: https://github.com/IGITUGraz/spore-nest-module
+ *
+ * File:   shm_export.h
+ * Author: Kappel
+ *
+ * Created on October 18, 2026
+ */
+
+#ifndef SHM_EXPORT_H
+#define SHM_EXPORT_H
+
+#include <string>
+#include <vector>
+
+#include <stdint.h>
+
+
+namespace spore
+{
+
+/**
+ * @brief Header of a shared memory segment written by ShmExport.
+ *
+ * The header is followed by the names of the columns (\a n_columns entries
+ * of ShmExport::name_size bytes). The data starts at ShmExport::header_size
+ * and consists of the arrays
+ *
+ * <table>
+ * <tr><th>array</th>     <th>type</th>   <th>length</th>        <th>content</th></tr>
+ * <tr><td>offsets</td>   <td>uint64</td> <td>n_rows + 1</td>    <td>first sample of every row</td></tr>
+ * <tr><td>row_ids</td>   <td>uint64</td> <td>n_rows</td>        <td>id of every row (port or GID)</td></tr>
+ * <tr><td>row_sub</td>   <td>uint64</td> <td>n_rows</td>        <td>sub-id of every row (trace id)</td></tr>
+ * <tr><td>columns</td>   <td>double</td> <td>n_samples each</td><td>one array per column</td></tr>
+ * </table>
+ *
+ * The samples of row \a i are at positions offsets[i] to offsets[i+1]
+ * of every column.
+ */
+struct ShmExportHeader
+{
+    uint64_t magic; //!< must be ShmExport::shm_magic
+    uint32_t version; //!< layout version, must be ShmExport::shm_version
+    uint32_t kind; //!< content of the segment, see ShmExport::Kind
+    uint64_t n_rows; //!< number of rows
+    uint64_t n_samples; //!< total number of samples of all rows
+    uint64_t n_columns; //!< number of columns
+    double t0; //!< time of the first sample of every row (traces only) [ms]
+    double dt; //!< time between samples (traces only) [ms]
+    uint64_t reserved;
+};
+
+/**
+ * @brief Columnar export of simulation data to POSIX shared memory.
+ *
+ * ShmExport creates a shared memory segment of the given layout and
+ * exposes pointers to its arrays, such that data can be written to its
+ * final location without intermediate copies. Python can map the segment
+ * and view its arrays as numpy arrays without conversion (see
+ * utils/spore_export.py). The segment stays alive after the export object
+ * was destroyed until it is unlinked by the reader.
+ */
+class ShmExport
+{
+public:
+    static const uint64_t shm_magic = 0x50584545524f5053ULL; //!< "SPOREEXP"
+    static const uint32_t shm_version = 1;
+    static const size_t header_size = 4096;
+    static const size_t name_size = 64;
+
+    enum Kind
+    {
+        recorder = 1, //!< recorded connection data, one row per recorder port
+        traces = 2 //!< trace windows, one row per node and trace
+    };
+
+    ShmExport(const std::string& name, Kind kind, size_t n_rows, size_t n_samples,
+              const std::vector<std::string>& columns);
+    ~ShmExport();
+
+    ShmExportHeader& header()
+    {
+        return *header_;
+    }
+
+    uint64_t* offsets()
+    {
+        return reinterpret_cast<uint64_t*>(mem_ + header_size);
+    }
+
+    uint64_t* row_ids()
+    {
+        return offsets() + n_rows_ + 1;
+    }
+
+    uint64_t* row_sub()
+    {
+        return row_ids() + n_rows_;
+    }
+
+    double* column(size_t i)
+    {
+        return reinterpret_cast<double*>(row_sub() + n_rows_) + i * n_samples_;
+    }
+
+    size_t get_size() const
+    {
+        return size_;
+    }
+
+private:
+    ShmExport(const ShmExport&);
+    ShmExport& operator=(const ShmExport&);
+
+    ShmExportHeader* header_;
+    char* mem_;
+    size_t size_;
+    size_t n_rows_;
+    size_t n_samples_;
+};
+
+}
+
+#endif /* SHM_EXPORT_H */
@@ -30,7 +30,8 @@
 /**
  * @brief Global namespace holding all classes of the SPORE NEST module.
  *
- * @see DiligentConnectorModel, ConnectionUpdateManager, TracingNode, RewardInProxy
+ * @see DiligentConnectorModel, ConnectionUpdateManager, TracingNode, RewardInProxy, RewardShmProxy,
+ *      RewardFilterNode, TraceGeneratorNode
  */
 namespace spore
 {
@@ -58,10 +59,18 @@ namespace spore
  *   synapse models that were developed for reward-based learning.
  *
  * - It introduces a MUSIC proxy that allows to receive traces from a MUSIC
- *   port (RewardInProxy).
+ *   port (RewardInProxy), and a proxy that receives traces from a local
+ *   process through POSIX shared memory (RewardShmProxy).
  *
+ * - It introduces a node that normalizes and filters reward traces inside
+ *   the simulation (RewardFilterNode).
  *
- * @see DiligentConnectorModel, TracingNode, RewardInProxy
+ * - It introduces a node that generates synthetic reward and other traces,
+ *   e.g. for benchmarks without external processes (TraceGeneratorNode).
+ *
+ *
+ * @see DiligentConnectorModel, TracingNode, RewardInProxy, RewardShmProxy, RewardFilterNode,
+ *      TraceGeneratorNode
  */
 
 // version number of the module
@@ -70,6 +79,13 @@ namespace spore
 // specify to enable spore debug tests.
 #define __SPORE_DEBUG__ 0
 
+// hint the processor to load the cache line at the given address.
+#if defined(__GNUC__)
+#define SPORE_PREFETCH(addr) __builtin_prefetch(addr)
+#else
+#define SPORE_PREFETCH(addr)
+#endif
+
 }
 
 #endif
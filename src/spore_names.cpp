@@ -34,6 +34,30 @@ namespace names
 const Name trace("trace");
 const Name delay("delay");
 const Name reward_in_proxy("reward_in_proxy");
+const Name shm_name("shm_name");
+const Name n_channels("n_channels");
+const Name buffer_size("buffer_size");
+const Name attached("attached");
+const Name consumed("consumed");
+const Name piecewise_constant("piecewise_constant");
+const Name replicate_traces("replicate_traces");
+const Name source_trace_ids("source_trace_ids");
+const Name baseline_mode("baseline_mode");
+const Name baseline_tau("baseline_tau");
+const Name baseline_min("baseline_min");
+const Name reward_offset("reward_offset");
+const Name clip_min("clip_min");
+const Name clip_max("clip_max");
+const Name lowpass_tau("lowpass_tau");
+const Name baseline("baseline");
+const Name filtered_reward("filtered_reward");
+const Name signal("signal");
+const Name amplitude("amplitude");
+const Name rate("rate");
+const Name pulse_duration("pulse_duration");
+const Name tau("tau");
+const Name schedule_times("schedule_times");
+const Name schedule_values("schedule_values");
 
 const Name weight_update_time("weight_update_time");
 const Name bap_trace_id("bap_trace_id");
@@ -41,6 +65,59 @@ const Name recorder_times("recorder_times");
 const Name recorder_interval("recorder_interval");
 const Name recorder_values("recorder_values");
 const Name reset_recorder("reset_recorder");
+const Name recorder_stream("recorder_stream");
+const Name recorder_port("recorder_port");
+const Name recorder_max_samples("recorder_max_samples");
+const Name recorder_decimation_levels("recorder_decimation_levels");
+const Name aggregate_interval("aggregate_interval");
+const Name aggregate_bins("aggregate_bins");
+const Name aggregate_times("aggregate_times");
+const Name aggregate_counts("aggregate_counts");
+const Name retracted_counts("retracted_counts");
+const Name mean("mean");
+const Name variance("variance");
+const Name histogram("histogram");
+const Name histogram_range("histogram_range");
+const Name weight_histogram_min("weight_histogram_min");
+const Name weight_histogram_max("weight_histogram_max");
+const Name synaptic_parameter_histogram_min("synaptic_parameter_histogram_min");
+const Name synaptic_parameter_histogram_max("synaptic_parameter_histogram_max");
+const Name reward_gradient_histogram_min("reward_gradient_histogram_min");
+const Name reward_gradient_histogram_max("reward_gradient_histogram_max");
+const Name distribution("distribution");
+const Name value("value");
+const Name mu("mu");
+const Name sigma("sigma");
+const Name low("low");
+const Name high("high");
+const Name seed("seed");
+const Name port("port");
+const Name target_thread("target_thread");
+const Name synapses("synapses");
+const Name nodes("nodes");
+const Name traces("traces");
+const Name created("created");
+const Name dropped("dropped");
+const Name update_interval("update_interval");
+const Name acceptable_latency("acceptable_latency");
+const Name deferred_registration("deferred_registration");
+const Name learning_frozen("learning_frozen");
+const Name target_ordered_updates("target_ordered_updates");
+const Name num_connectors("num_connectors");
+const Name num_dormant_synapses("num_dormant_synapses");
+const Name compaction_interval("compaction_interval");
+const Name compaction_threshold("compaction_threshold");
+const Name estimated_reclaimed_bytes("estimated_reclaimed_bytes");
+const Name threads("threads");
+const Name total("total");
+const Name num_synapses("num_synapses");
+const Name synapse_bytes("synapse_bytes");
+const Name trace_bytes("trace_bytes");
+const Name recorder_bytes("recorder_bytes");
+const Name schedule_bytes("schedule_bytes");
+const Name garbage_pile_bytes("garbage_pile_bytes");
+const Name dormant_bytes("dormant_bytes");
+const Name total_bytes("total_bytes");
 const Name test_name("test_name");
 const Name test_time("test_time");
 
@@ -64,6 +141,7 @@ const Name dopa_trace_id("dopa_trace_id");
 const Name psp_cutoff_amplitude("psp_cutoff_amplitude");
 const Name simulate_retracted_synapses("simulate_retracted_synapses");
 const Name delete_retracted_synapses("delete_retracted_synapses");
+const Name dormant_retracted_synapses("dormant_retracted_synapses");
 
 const Name synaptic_parameter("synaptic_parameter");
 const Name eligibility_trace("eligibility_trace");
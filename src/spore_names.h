@@ -43,6 +43,30 @@ namespace names
 extern const Name trace;
 extern const Name delay;
 extern const Name reward_in_proxy;
+extern const Name shm_name;
+extern const Name n_channels;
+extern const Name buffer_size;
+extern const Name attached;
+extern const Name consumed;
+extern const Name piecewise_constant;
+extern const Name replicate_traces;
+extern const Name source_trace_ids;
+extern const Name baseline_mode;
+extern const Name baseline_tau;
+extern const Name baseline_min;
+extern const Name reward_offset;
+extern const Name clip_min;
+extern const Name clip_max;
+extern const Name lowpass_tau;
+extern const Name baseline;
+extern const Name filtered_reward;
+extern const Name signal;
+extern const Name amplitude;
+extern const Name rate;
+extern const Name pulse_duration;
+extern const Name tau;
+extern const Name schedule_times;
+extern const Name schedule_values;
 
 extern const Name weight_update_time;
 extern const Name bap_trace_id;
@@ -50,6 +74,59 @@ extern const Name recorder_times;
 extern const Name recorder_interval;
 extern const Name recorder_values;
 extern const Name reset_recorder;
+extern const Name recorder_stream;
+extern const Name recorder_port;
+extern const Name recorder_max_samples;
+extern const Name recorder_decimation_levels;
+extern const Name aggregate_interval;
+extern const Name aggregate_bins;
+extern const Name aggregate_times;
+extern const Name aggregate_counts;
+extern const Name retracted_counts;
+extern const Name mean;
+extern const Name variance;
+extern const Name histogram;
+extern const Name histogram_range;
+extern const Name weight_histogram_min;
+extern const Name weight_histogram_max;
+extern const Name synaptic_parameter_histogram_min;
+extern const Name synaptic_parameter_histogram_max;
+extern const Name reward_gradient_histogram_min;
+extern const Name reward_gradient_histogram_max;
+extern const Name distribution;
+extern const Name value;
+extern const Name mu;
+extern const Name sigma;
+extern const Name low;
+extern const Name high;
+extern const Name seed;
+extern const Name port;
+extern const Name target_thread;
+extern const Name synapses;
+extern const Name nodes;
+extern const Name traces;
+extern const Name created;
+extern const Name dropped;
+extern const Name update_interval;
+extern const Name acceptable_latency;
+extern const Name deferred_registration;
+extern const Name learning_frozen;
+extern const Name target_ordered_updates;
+extern const Name num_connectors;
+extern const Name num_dormant_synapses;
+extern const Name compaction_interval;
+extern const Name compaction_threshold;
+extern const Name estimated_reclaimed_bytes;
+extern const Name threads;
+extern const Name total;
+extern const Name num_synapses;
+extern const Name synapse_bytes;
+extern const Name trace_bytes;
+extern const Name recorder_bytes;
+extern const Name schedule_bytes;
+extern const Name garbage_pile_bytes;
+extern const Name dormant_bytes;
+extern const Name total_bytes;
 extern const Name test_name;
 extern const Name test_time;
 
@@ -73,6 +150,7 @@ extern const Name dopa_trace_id;
 extern const Name psp_cutoff_amplitude;
 extern const Name simulate_retracted_synapses;
 extern const Name delete_retracted_synapses;
+extern const Name dormant_retracted_synapses;
 
 extern const Name synaptic_parameter;
 extern const Name eligibility_trace;
@@ -175,6 +175,21 @@ public:
         return false;
     }
 
+    /**
+     * Nothing to prefetch for the test synapse.
+     */
+    void prefetch(nest::thread t, double t_lastspike, const CommonPropertiesType& cp) const
+    {
+    }
+
+    /**
+     * The test synapse has no dormant synapses.
+     */
+    static void update_dormant(DormantPool& pool, const nest::Time& time, nest::thread th,
+                               nest::synindex syn_id, const CommonPropertiesType& cp)
+    {
+    }
+
 private:
     double weight_;
     double t_weight_;
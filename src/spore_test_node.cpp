@@ -27,6 +27,8 @@
 #include "spore_test_node.h"
 
 #include "test_circular_buffer.h"
+#include "test_change_point_buffer.h"
+#include "test_segmented_vector.h"
 #include "test_tracing_node.h"
 #include "test_pulse_trace.h"
 
@@ -41,6 +43,8 @@ SporeTestNode::SporeTestNode()
 : test_time_(-1.0)
 {
     register_test(new TestCircularBuffer());
+    register_test(new TestChangePointBuffer());
+    register_test(new TestSegmentedVector());
     register_test(new TestTracingNode());
     register_test(new TestPulseTrace());
 }
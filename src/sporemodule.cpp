@@ -27,7 +27,11 @@
 #include "sporemodule.h"
 #include "spore.h"
 
+// Includes from NEST:
+#include "config.h"
+
 // Includes from nestkernel:
+#include "compose.hpp"
 #include "connection_manager_impl.h"
 #include "connector_model_impl.h"
 #include "dynamicloader.h"
@@ -41,12 +45,22 @@
 #include "target_identifier.h"
 
 // Include the module's headers
+#include "checkpoint.h"
 #include "connection_updater.h"
+#include "connectivity_file.h"
 #include "diligent_connector_model.h"
+#include "shm_export.h"
+#include "tracing_node.h"
 
 #include "poisson_dbl_exp_neuron.h"
 #include "synaptic_sampling_rewardgradient_connection.h"
+#include "reward_shm_proxy.h"
+#include "reward_filter_node.h"
+#include "trace_generator_node.h"
+
+#ifdef HAVE_MUSIC
 #include "reward_in_proxy.h"
+#endif
 
 #ifdef __SPORE_DEBUG__
 #include "spore_test_node.h"
@@ -145,6 +159,490 @@ InitSynapseUpdater_i_i_Function::execute(SLIInterpreter* i) const
     i->EStack.pop();
 }
 
+/**
+ * Constructor.
+ */
+spore::SporeModule::
+GetSporeStatus_Function::GetSporeStatus_Function()
+{
+}
+
+/**
+ * Returns the status of the synapse updater.
+ *
+ * @param i   pointer to the SLI interpreter.
+ */
+void spore::SporeModule::
+GetSporeStatus_Function::execute(SLIInterpreter* i) const
+{
+    DictionaryDatum d(new Dictionary);
+    ConnectionUpdateManager::instance()->get_status(d);
+
+    i->OStack.push(d);
+    i->EStack.pop();
+}
+
+/**
+ * Constructor.
+ */
+spore::SporeModule::
+SetSporeStatus_D_Function::SetSporeStatus_D_Function()
+{
+}
+
+/**
+ * Sets the status of the synapse updater.
+ *
+ * @param i   pointer to the SLI interpreter.
+ */
+void spore::SporeModule::
+SetSporeStatus_D_Function::execute(SLIInterpreter* i) const
+{
+    i->assert_stack_load(1);
+
+    const DictionaryDatum d = getValue<DictionaryDatum>(i->OStack.pick(0));
+    ConnectionUpdateManager::instance()->set_status(d);
+
+    i->OStack.pop();
+    i->EStack.pop();
+}
+
+/**
+ * Constructor.
+ */
+spore::SporeModule::
+GetSporeMemoryStatus_Function::GetSporeMemoryStatus_Function()
+{
+}
+
+/**
+ * Returns the memory used by SPORE objects.
+ *
+ * @param i   pointer to the SLI interpreter.
+ */
+void spore::SporeModule::
+GetSporeMemoryStatus_Function::execute(SLIInterpreter* i) const
+{
+    DictionaryDatum d(new Dictionary);
+    ConnectionUpdateManager::instance()->get_memory_status(d);
+
+    i->OStack.push(d);
+    i->EStack.pop();
+}
+
+/**
+ * Constructor.
+ */
+spore::SporeModule::
+GetSynapseAggregates_s_Function::GetSynapseAggregates_s_Function()
+{
+}
+
+/**
+ * Returns the aggregate statistics of a synapse model.
+ *
+ * @param i   pointer to the SLI interpreter.
+ */
+void spore::SporeModule::
+GetSynapseAggregates_s_Function::execute(SLIInterpreter* i) const
+{
+    i->assert_stack_load(1);
+
+    const std::string name = getValue<std::string>(i->OStack.pick(0));
+
+    const Token synmodel = nest::kernel().model_manager.get_synapsedict()->lookup(name);
+    if (synmodel.empty())
+    {
+        throw nest::UnknownSynapseType(name);
+    }
+    const nest::synindex syn_id = static_cast<size_t>(synmodel);
+
+    DictionaryDatum d(new Dictionary);
+    ConnectionDataLoggerBase::get_aggregates(syn_id, ConnectionUpdateManager::instance()->get_horizon().get_ms(), d);
+
+    i->OStack.pop();
+    i->OStack.push(d);
+    i->EStack.pop();
+}
+
+namespace spore
+{
+
+typedef SynapticSamplingRewardGradientConnection<nest::TargetIdentifierPtrRport> SynapticSamplingConnection;
+typedef SynapticSamplingRewardGradientConnection<nest::TargetIdentifierIndex> SynapticSamplingConnectionHpc;
+typedef SynapticSamplingRewardGradientConnection<nest::TargetIdentifierPtrRport, HomogeneousPrior>
+        SynapticSamplingConnectionHom;
+typedef SynapticSamplingRewardGradientConnection<nest::TargetIdentifierIndex, HomogeneousPrior>
+        SynapticSamplingConnectionHomHpc;
+typedef SynapticSamplingRewardGradientConnection<nest::TargetIdentifierIndex, SynapsePrior, FixedPointStorage>
+        SynapticSamplingConnectionHpcFixed;
+typedef SynapticSamplingRewardGradientConnection<nest::TargetIdentifierIndex, HomogeneousPrior, FixedPointStorage>
+        SynapticSamplingConnectionHomHpcFixed;
+
+/**
+ * @brief Functions of one instantiation of SynapticSamplingRewardGradientConnection.
+ */
+struct SynapticSamplingType
+{
+    bool (*is_model)(nest::synindex syn_id);
+    void (*get_synapse_arrays)(nest::synindex syn_id, DictionaryDatum& d);
+    void (*set_synapse_arrays)(nest::synindex syn_id, const DictionaryDatum& d);
+    void (*convert_to_static)(nest::synindex syn_id, nest::synindex static_id, DictionaryDatum& d);
+};
+
+/**
+ * @return all registered instantiations of SynapticSamplingRewardGradientConnection.
+ */
+static std::vector<SynapticSamplingType>& synaptic_sampling_types()
+{
+    static std::vector<SynapticSamplingType> types;
+    return types;
+}
+
+/**
+ * @return true if the synapse model \a syn_id is of type ConnectionT.
+ */
+template < typename ConnectionT >
+static bool is_synaptic_sampling_model(nest::synindex syn_id)
+{
+    return dynamic_cast<const nest::GenericConnectorModel<ConnectionT>*>(
+            &nest::kernel().model_manager.get_synapse_prototype(syn_id)) != 0;
+}
+
+/**
+ * Register an instantiation of SynapticSamplingRewardGradientConnection as
+ * diligent synapse model with the given name, for checkpoints and for the
+ * SLI functions of the module.
+ *
+ * @param name name of the synapse model.
+ */
+template < typename ConnectionT >
+static void register_synaptic_sampling_model(const std::string& name)
+{
+    register_diligent_connection_model< ConnectionT >(name);
+    SporeCheckpoint::register_connection_type< ConnectionT >();
+
+    SynapticSamplingType type;
+    type.is_model = &is_synaptic_sampling_model<ConnectionT>;
+    type.get_synapse_arrays = &ConnectionT::get_synapse_arrays;
+    type.set_synapse_arrays = &ConnectionT::set_synapse_arrays;
+    type.convert_to_static = &ConnectionT::convert_to_static;
+    synaptic_sampling_types().push_back(type);
+}
+
+/**
+ * Look up a synapse model that was instantiated from
+ * SynapticSamplingRewardGradientConnection.
+ *
+ * @param name name of the synapse model.
+ * @param caller name of the calling SLI function, used for error messages.
+ * @param syn_id to retrieve the id of the synapse model.
+ * @return the functions of the synapse model.
+ */
+static const SynapticSamplingType& get_synaptic_sampling_model(const std::string& name, const std::string& caller,
+                                                               nest::synindex& syn_id)
+{
+    const Token synmodel = nest::kernel().model_manager.get_synapsedict()->lookup(name);
+    if (synmodel.empty())
+    {
+        throw nest::UnknownSynapseType(name);
+    }
+    syn_id = static_cast<size_t>(synmodel);
+
+    const std::vector<SynapticSamplingType>& types = synaptic_sampling_types();
+    for (size_t k = 0; k < types.size(); k++)
+    {
+        if (types[k].is_model(syn_id))
+        {
+            return types[k];
+        }
+    }
+
+    throw nest::BadProperty(String::compose("%1: synapse model '%2' is not a "
+                                            "synaptic_sampling_rewardgradient_synapse.", caller, name));
+}
+
+}
+
+/**
+ * Constructor.
+ */
+spore::SporeModule::
+GetSynapseArrays_s_Function::GetSynapseArrays_s_Function()
+{
+}
+
+/**
+ * Returns the state of all synapses of a synapse model as flat arrays.
+ *
+ * @param i   pointer to the SLI interpreter.
+ */
+void spore::SporeModule::
+GetSynapseArrays_s_Function::execute(SLIInterpreter* i) const
+{
+    i->assert_stack_load(1);
+
+    const std::string name = getValue<std::string>(i->OStack.pick(0));
+    nest::synindex syn_id;
+    const SynapticSamplingType& type = get_synaptic_sampling_model(name, "GetSynapseArrays", syn_id);
+
+    DictionaryDatum d(new Dictionary);
+    type.get_synapse_arrays(syn_id, d);
+
+    i->OStack.pop();
+    i->OStack.push(d);
+    i->EStack.pop();
+}
+
+/**
+ * Constructor.
+ */
+spore::SporeModule::
+SetSynapseArrays_s_D_Function::SetSynapseArrays_s_D_Function()
+{
+}
+
+/**
+ * Sets the parameters of many synapses of a synapse model at once.
+ *
+ * @param i   pointer to the SLI interpreter.
+ */
+void spore::SporeModule::
+SetSynapseArrays_s_D_Function::execute(SLIInterpreter* i) const
+{
+    i->assert_stack_load(2);
+
+    const std::string name = getValue<std::string>(i->OStack.pick(1));
+    const DictionaryDatum d = getValue<DictionaryDatum>(i->OStack.pick(0));
+    nest::synindex syn_id;
+    const SynapticSamplingType& type = get_synaptic_sampling_model(name, "SetSynapseArrays", syn_id);
+
+    type.set_synapse_arrays(syn_id, d);
+
+    i->OStack.pop(2);
+    i->EStack.pop();
+}
+
+/**
+ * Constructor.
+ */
+spore::SporeModule::
+ExportRecorderData_s_s_Function::ExportRecorderData_s_s_Function()
+{
+}
+
+/**
+ * Exports the recordings of a connection data logger to shared memory.
+ *
+ * @param i   pointer to the SLI interpreter.
+ */
+void spore::SporeModule::
+ExportRecorderData_s_s_Function::execute(SLIInterpreter* i) const
+{
+    i->assert_stack_load(2);
+
+    const std::string label = getValue<std::string>(i->OStack.pick(1));
+    const std::string shm_name = getValue<std::string>(i->OStack.pick(0));
+
+    if (!ConnectionDataLoggerBase::export_data(label, shm_name))
+    {
+        throw nest::BadProperty(String::compose("ExportRecorderData: no recorder with label '%1'.", label));
+    }
+
+    i->OStack.pop(2);
+    i->EStack.pop();
+}
+
+/**
+ * Constructor.
+ */
+spore::SporeModule::
+ExportTraces_a_s_Function::ExportTraces_a_s_Function()
+{
+}
+
+/**
+ * Exports the trace windows of tracing nodes to shared memory.
+ *
+ * @param i   pointer to the SLI interpreter.
+ */
+void spore::SporeModule::
+ExportTraces_a_s_Function::execute(SLIInterpreter* i) const
+{
+    i->assert_stack_load(2);
+
+    const std::vector<long> gids = getValue< std::vector<long> >(i->OStack.pick(1));
+    const std::string shm_name = getValue<std::string>(i->OStack.pick(0));
+
+    std::vector<const TracingNode*> nodes;
+    size_t n_rows = 0;
+    for (size_t k = 0; k < gids.size(); k++)
+    {
+        const long gid = gids[k];
+        const TracingNode* node = dynamic_cast<const TracingNode*>(nest::kernel().node_manager.get_node(gid));
+        if (node == 0)
+        {
+            throw nest::BadProperty(String::compose("ExportTraces: node %1 is not a local tracing node.", gid));
+        }
+        nodes.push_back(node);
+        n_rows += node->get_num_traces();
+    }
+
+    const nest::Time horizon = ConnectionUpdateManager::instance()->get_horizon();
+    const size_t length = ConnectionUpdateManager::instance()->get_max_latency();
+
+    std::vector<std::string> columns(1, "trace");
+    ShmExport shm(shm_name, ShmExport::traces, n_rows, n_rows * length, columns);
+    shm.header().t0 = horizon.get_ms();
+    shm.header().dt = nest::Time::get_resolution().get_ms();
+
+    size_t row = 0;
+    shm.offsets()[0] = 0;
+    for (size_t k = 0; k < nodes.size(); k++)
+    {
+        for (size_t trace_id = 0; trace_id < nodes[k]->get_num_traces(); trace_id++, row++)
+        {
+            nodes[k]->copy_trace(trace_id, horizon.get_steps(), length, shm.column(0) + row * length);
+            shm.offsets()[row + 1] = (row + 1) * length;
+            shm.row_ids()[row] = nodes[k]->get_gid();
+            shm.row_sub()[row] = trace_id;
+        }
+    }
+
+    i->OStack.pop(2);
+    i->EStack.pop();
+}
+
+/**
+ * Constructor.
+ */
+spore::SporeModule::
+SaveSporeCheckpoint_s_Function::SaveSporeCheckpoint_s_Function()
+{
+}
+
+/**
+ * Writes the learning state of the network to a checkpoint file.
+ *
+ * @param i   pointer to the SLI interpreter.
+ */
+void spore::SporeModule::
+SaveSporeCheckpoint_s_Function::execute(SLIInterpreter* i) const
+{
+    i->assert_stack_load(1);
+
+    const std::string file_name = getValue<std::string>(i->OStack.pick(0));
+
+    DictionaryDatum d(new Dictionary);
+    SporeCheckpoint::save(file_name, d);
+
+    i->OStack.pop();
+    i->OStack.push(d);
+    i->EStack.pop();
+}
+
+/**
+ * Constructor.
+ */
+spore::SporeModule::
+LoadSporeCheckpoint_s_Function::LoadSporeCheckpoint_s_Function()
+{
+}
+
+/**
+ * Restores the learning state of the network from a checkpoint file.
+ *
+ * @param i   pointer to the SLI interpreter.
+ */
+void spore::SporeModule::
+LoadSporeCheckpoint_s_Function::execute(SLIInterpreter* i) const
+{
+    i->assert_stack_load(1);
+
+    const std::string file_name = getValue<std::string>(i->OStack.pick(0));
+
+    DictionaryDatum d(new Dictionary);
+    SporeCheckpoint::load(file_name, d);
+
+    i->OStack.pop();
+    i->OStack.push(d);
+    i->EStack.pop();
+}
+
+/**
+ * Constructor.
+ */
+spore::SporeModule::
+LoadConnectivity_s_s_Function::LoadConnectivity_s_s_Function()
+{
+}
+
+/**
+ * Creates the connections of a connectivity file.
+ *
+ * @param i   pointer to the SLI interpreter.
+ */
+void spore::SporeModule::
+LoadConnectivity_s_s_Function::execute(SLIInterpreter* i) const
+{
+    i->assert_stack_load(2);
+
+    const std::string file_name = getValue<std::string>(i->OStack.pick(1));
+    const std::string name = getValue<std::string>(i->OStack.pick(0));
+    nest::synindex syn_id;
+    get_synaptic_sampling_model(name, "LoadConnectivity", syn_id);
+
+    DictionaryDatum d(new Dictionary);
+    ConnectivityFile::load(file_name, syn_id, d);
+
+    i->OStack.pop(2);
+    i->OStack.push(d);
+    i->EStack.pop();
+}
+
+/**
+ * Constructor.
+ */
+spore::SporeModule::
+ConvertToStaticSynapses_s_s_Function::ConvertToStaticSynapses_s_s_Function()
+{
+}
+
+/**
+ * Replaces all synapses of a synapse model by static connections.
+ *
+ * @param i   pointer to the SLI interpreter.
+ */
+void spore::SporeModule::
+ConvertToStaticSynapses_s_s_Function::execute(SLIInterpreter* i) const
+{
+    i->assert_stack_load(2);
+
+    const std::string name = getValue<std::string>(i->OStack.pick(1));
+    const std::string static_name = getValue<std::string>(i->OStack.pick(0));
+    nest::synindex syn_id;
+    const SynapticSamplingType& type = get_synaptic_sampling_model(name, "ConvertToStaticSynapses", syn_id);
+
+    const Token static_model = nest::kernel().model_manager.get_synapsedict()->lookup(static_name);
+    if (static_model.empty())
+    {
+        throw nest::UnknownSynapseType(static_name);
+    }
+    const nest::synindex static_id = static_cast<size_t>(static_model);
+
+    if (static_id == syn_id)
+    {
+        throw nest::BadProperty("ConvertToStaticSynapses: synapse models must differ.");
+    }
+
+    DictionaryDatum d(new Dictionary);
+    type.convert_to_static(syn_id, static_id, d);
+
+    i->OStack.pop(2);
+    i->OStack.push(d);
+    i->EStack.pop();
+}
+
 /**
  * Initialize module by registering models with the interpreter.
  * @param SLIInterpreter* SLI interpreter
@@ -157,15 +655,38 @@ void spore::SporeModule::init(SLIInterpreter* i)
             /*private_model=*/true);
 
     nest::kernel().model_manager.register_node_model<PoissonDblExpNeuron>("poisson_dbl_exp_neuron");
+    nest::kernel().model_manager.register_node_model<RewardShmProxy>("reward_shm_proxy");
+    nest::kernel().model_manager.register_node_model<RewardFilterNode>("reward_filter_node");
+    nest::kernel().model_manager.register_node_model<TraceGeneratorNode>("trace_generator_node");
+#ifdef HAVE_MUSIC
     nest::kernel().model_manager.register_node_model<RewardInProxy>("reward_in_proxy");
+#endif
 
     ConnectionUpdateManager::instance()->init(cu_model_id);
 
-    spore::register_diligent_connection_model
-            < SynapticSamplingRewardGradientConnection<nest::TargetIdentifierPtrRport> >
-            ("synaptic_sampling_rewardgradient_synapse");
+    register_synaptic_sampling_model< SynapticSamplingConnection >("synaptic_sampling_rewardgradient_synapse");
+    register_synaptic_sampling_model< SynapticSamplingConnectionHpc >("synaptic_sampling_rewardgradient_synapse_hpc");
+    register_synaptic_sampling_model< SynapticSamplingConnectionHom >("synaptic_sampling_rewardgradient_synapse_hom");
+    register_synaptic_sampling_model< SynapticSamplingConnectionHomHpc >
+            ("synaptic_sampling_rewardgradient_synapse_hom_hpc");
+    register_synaptic_sampling_model< SynapticSamplingConnectionHpcFixed >
+            ("synaptic_sampling_rewardgradient_synapse_hpc_fixed");
+    register_synaptic_sampling_model< SynapticSamplingConnectionHomHpcFixed >
+            ("synaptic_sampling_rewardgradient_synapse_hom_hpc_fixed");
 
     i->createcommand("InitSynapseUpdater", &init_synapse_updater_i_i_function_);
+    i->createcommand("GetSporeStatus", &get_spore_status_function_);
+    i->createcommand("SetSporeStatus", &set_spore_status_d_function_);
+    i->createcommand("GetSporeMemoryStatus", &get_spore_memory_status_function_);
+    i->createcommand("GetSynapseAggregates", &get_synapse_aggregates_s_function_);
+    i->createcommand("GetSynapseArrays", &get_synapse_arrays_s_function_);
+    i->createcommand("SetSynapseArrays", &set_synapse_arrays_s_D_function_);
+    i->createcommand("ExportRecorderData", &export_recorder_data_s_s_function_);
+    i->createcommand("ExportTraces", &export_traces_a_s_function_);
+    i->createcommand("SaveSporeCheckpoint", &save_spore_checkpoint_s_function_);
+    i->createcommand("LoadSporeCheckpoint", &load_spore_checkpoint_s_function_);
+    i->createcommand("LoadConnectivity", &load_connectivity_s_s_function_);
+    i->createcommand("ConvertToStaticSynapses", &convert_to_static_synapses_s_s_function_);
 
 #ifdef __SPORE_DEBUG__
     nest::kernel().model_manager.register_node_model<SporeTestNode>("spore_test_node");
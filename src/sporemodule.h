@@ -71,6 +71,228 @@ protected:
     }
     init_synapse_updater_i_i_function_;
 
+    /**
+     * @brief \a GetSporeStatus SLI function.
+     *
+     * This SLI command returns a dictionary with the status of the
+     * ConnectionUpdateManager: the update interval, the acceptable latency,
+     * whether registration of connectors is deferred, whether learning is
+     * frozen and the number of connectors.
+     *
+     * @see ConnectionUpdateManager::get_status
+     */
+    class GetSporeStatus_Function : public SLIFunction
+    {
+    public:
+        GetSporeStatus_Function();
+        void execute(SLIInterpreter*) const;
+    }
+    get_spore_status_function_;
+
+    /**
+     * @brief \a SetSporeStatus SLI function.
+     *
+     * This SLI command takes a dictionary to change the status of the
+     * ConnectionUpdateManager. Setting \a deferred_registration to true
+     * speeds up network construction by registering connectors only once
+     * when the simulation starts. Setting \a learning_frozen to true stops
+     * all learning, e.g. for evaluation runs. Setting
+     * \a target_ordered_updates to true updates synapses in the order of
+     * their targets. Setting \a compaction_interval to a positive number of
+     * updates releases memory of pruned connectors and SPORE's buffers
+     * periodically.
+     *
+     * @see ConnectionUpdateManager::set_status
+     */
+    class SetSporeStatus_D_Function : public SLIFunction
+    {
+    public:
+        SetSporeStatus_D_Function();
+        void execute(SLIInterpreter*) const;
+    }
+    set_spore_status_d_function_;
+
+    /**
+     * @brief \a GetSporeMemoryStatus SLI function.
+     *
+     * This SLI command returns a dictionary with the memory used by SPORE
+     * objects: for each thread in \a threads and summed up in \a total, the
+     * number and bytes of synapses of each diligent synapse model and the
+     * bytes of traces, update schedules, garbage piles and dormant synapses.
+     * The total also includes the bytes of all recorders and the estimated
+     * memory released by compaction (\a estimated_reclaimed_bytes). All
+     * figures are estimates from the sizes of SPORE's containers.
+     *
+     * @see ConnectionUpdateManager::get_memory_status
+     */
+    class GetSporeMemoryStatus_Function : public SLIFunction
+    {
+    public:
+        GetSporeMemoryStatus_Function();
+        void execute(SLIInterpreter*) const;
+    }
+    get_spore_memory_status_function_;
+
+    /**
+     * @brief \a GetSynapseAggregates SLI function.
+     *
+     * This SLI command takes the name of a synapse model as argument and
+     * returns a dictionary with the aggregate statistics of all synapses
+     * of this model. Every time point is returned once, as soon as all
+     * synapses have been updated past it.
+     *
+     * @see ConnectionDataLoggerBase::get_aggregates
+     */
+    class GetSynapseAggregates_s_Function : public SLIFunction
+    {
+    public:
+        GetSynapseAggregates_s_Function();
+        void execute(SLIInterpreter*) const;
+    }
+    get_synapse_aggregates_s_function_;
+
+    /**
+     * @brief \a GetSynapseArrays SLI function.
+     *
+     * This SLI command takes the name of a synapse model as argument and
+     * returns a dictionary of flat arrays with the source, target and state
+     * variables of all local synapses of this model.
+     *
+     * @see SynapticSamplingRewardGradientConnection::get_synapse_arrays
+     */
+    class GetSynapseArrays_s_Function : public SLIFunction
+    {
+    public:
+        GetSynapseArrays_s_Function();
+        void execute(SLIInterpreter*) const;
+    }
+    get_synapse_arrays_s_function_;
+
+    /**
+     * @brief \a SetSynapseArrays SLI function.
+     *
+     * This SLI command takes the name of a synapse model and a dictionary
+     * of values and sets the parameters of many synapses of this model at
+     * once, either from arrays aligned with a list of connections or from
+     * distributions.
+     *
+     * @see SynapticSamplingRewardGradientConnection::set_synapse_arrays
+     */
+    class SetSynapseArrays_s_D_Function : public SLIFunction
+    {
+    public:
+        SetSynapseArrays_s_D_Function();
+        void execute(SLIInterpreter*) const;
+    }
+    set_synapse_arrays_s_D_function_;
+
+    /**
+     * @brief \a ExportRecorderData SLI function.
+     *
+     * This SLI command takes the label of a connection data logger, e.g.
+     * "synaptic_sampling_rewardgradient", and the name of a shared memory
+     * segment. It writes the in-memory recordings of all recorder ports of
+     * the logger to the segment.
+     *
+     * @see ConnectionDataLoggerBase::export_data, ShmExport
+     */
+    class ExportRecorderData_s_s_Function : public SLIFunction
+    {
+    public:
+        ExportRecorderData_s_s_Function();
+        void execute(SLIInterpreter*) const;
+    }
+    export_recorder_data_s_s_function_;
+
+    /**
+     * @brief \a ExportTraces SLI function.
+     *
+     * This SLI command takes an array of GIDs of local tracing nodes and
+     * the name of a shared memory segment. It writes the current trace
+     * windows of all nodes to the segment.
+     *
+     * @see TracingNode::copy_trace, ShmExport
+     */
+    class ExportTraces_a_s_Function : public SLIFunction
+    {
+    public:
+        ExportTraces_a_s_Function();
+        void execute(SLIInterpreter*) const;
+    }
+    export_traces_a_s_function_;
+
+    /**
+     * @brief \a SaveSporeCheckpoint SLI function.
+     *
+     * This SLI command takes a file name and writes the state of all local
+     * SPORE synapses and tracing nodes to this file. It returns a
+     * dictionary with the number of written synapses and nodes.
+     *
+     * @see SporeCheckpoint::save
+     */
+    class SaveSporeCheckpoint_s_Function : public SLIFunction
+    {
+    public:
+        SaveSporeCheckpoint_s_Function();
+        void execute(SLIInterpreter*) const;
+    }
+    save_spore_checkpoint_s_function_;
+
+    /**
+     * @brief \a LoadSporeCheckpoint SLI function.
+     *
+     * This SLI command takes the name of a file written by
+     * \a SaveSporeCheckpoint and restores the state of all synapses and
+     * tracing nodes from it. Missing connections are created. It returns a
+     * dictionary with the number of restored synapses, nodes and traces.
+     *
+     * @see SporeCheckpoint::load
+     */
+    class LoadSporeCheckpoint_s_Function : public SLIFunction
+    {
+    public:
+        LoadSporeCheckpoint_s_Function();
+        void execute(SLIInterpreter*) const;
+    }
+    load_spore_checkpoint_s_function_;
+
+    /**
+     * @brief \a LoadConnectivity SLI function.
+     *
+     * This SLI command takes the name of a connectivity file and the name
+     * of a synaptic_sampling_rewardgradient_synapse model and creates all
+     * connections listed in the file in bulk. It returns a dictionary with
+     * the number of created connections.
+     *
+     * @see ConnectivityFile::load
+     */
+    class LoadConnectivity_s_s_Function : public SLIFunction
+    {
+    public:
+        LoadConnectivity_s_s_Function();
+        void execute(SLIInterpreter*) const;
+    }
+    load_connectivity_s_s_function_;
+
+    /**
+     * @brief \a ConvertToStaticSynapses SLI function.
+     *
+     * This SLI command takes the name of a synaptic_sampling_rewardgradient_synapse
+     * model and the name of a static synapse model. It replaces all synapses
+     * of the first model by connections of the second model that carry their
+     * current weight and drops retracted synapses. It returns a dictionary
+     * with the number of created and dropped connections.
+     *
+     * @see SynapticSamplingRewardGradientConnection::convert_to_static
+     */
+    class ConvertToStaticSynapses_s_s_Function : public SLIFunction
+    {
+    public:
+        ConvertToStaticSynapses_s_s_Function();
+        void execute(SLIInterpreter*) const;
+    }
+    convert_to_static_synapses_s_s_function_;
+
 };
 
 }
@@ -58,8 +58,19 @@ template < typename T, typename C >
     p.parameter( v.bap_trace_id_, names::bap_trace_id, 0l, pc::MinL(0) );
     p.parameter( v.dopa_trace_id_, names::dopa_trace_id, 0l, pc::MinL(0) );
     p.parameter( v.psp_cutoff_amplitude_, names::psp_cutoff_amplitude, 0.0001, pc::MinD(0) );
+    p.parameter( v.prior_mean_, names::prior_mean, 0.0 );
+    p.parameter( v.prior_precision_, names::prior_precision, 1.0 );
     p.parameter( v.simulate_retracted_synapses_, names::simulate_retracted_synapses, false );
     p.parameter( v.delete_retracted_synapses_, names::delete_retracted_synapses, false );
+    p.parameter( v.dormant_retracted_synapses_, names::dormant_retracted_synapses, false );
+    p.parameter( v.aggregate_interval_, names::aggregate_interval, 0.0, pc::MinD(0.0) );
+    p.parameter( v.aggregate_bins_, names::aggregate_bins, 20l, pc::MinL(1) );
+    p.parameter( v.aggregate_ranges_[0], names::weight_histogram_min, 0.0 );
+    p.parameter( v.aggregate_ranges_[1], names::weight_histogram_max, 10.0 );
+    p.parameter( v.aggregate_ranges_[2], names::synaptic_parameter_histogram_min, -2.0 );
+    p.parameter( v.aggregate_ranges_[3], names::synaptic_parameter_histogram_max, 5.0 );
+    p.parameter( v.aggregate_ranges_[4], names::reward_gradient_histogram_min, -1.0 );
+    p.parameter( v.aggregate_ranges_[5], names::reward_gradient_histogram_max, 1.0 );
 }
 
 /**
@@ -75,6 +86,10 @@ SynapticSamplingRewardGradientCommonProperties::SynapticSamplingRewardGradientCo
   psp_depression_update_(0.0),
   psp_scale_factor_(0.0),
   weight_update_steps_(0),
+  aggregate_steps_(0),
+  learning_frozen_(false),
+  learning_frozen_at_(0.0),
+  learning_resumed_(0.0),
   std_wiener_(0.0),
   std_gradient_(0.0)
 {
@@ -151,10 +166,31 @@ void SynapticSamplingRewardGradientCommonProperties::calibrate(const nest::TimeC
         throw nest::BadProperty("Reward transmitter was not set at simulation startup!");
     }
 
+    for (size_t i = 0; i < 3; i++)
+    {
+        if (aggregate_ranges_[2 * i] >= aggregate_ranges_[2 * i + 1])
+        {
+            throw nest::BadProperty("Histogram limits of aggregated variables must be increasing.");
+        }
+    }
+
+    if (dormant_retracted_synapses_ && (simulate_retracted_synapses_ || delete_retracted_synapses_))
+    {
+        throw nest::BadProperty("dormant_retracted_synapses can not be combined with simulate_retracted_synapses "
+                                "or delete_retracted_synapses.");
+    }
+
     resolution_unit_ = nest::Time::get_resolution().get_ms();
 
+    learning_frozen_ = ConnectionUpdateManager::instance()->is_learning_frozen();
+    learning_frozen_at_ = ConnectionUpdateManager::instance()->get_learning_frozen_at().get_ms();
+    learning_resumed_ = ConnectionUpdateManager::instance()->get_learning_resumed().get_ms();
+
     weight_update_steps_ = std::ceil(weight_update_interval_ / resolution_unit_);
 
+    // aggregates are taken on the grid of weight updates
+    aggregate_steps_ = std::ceil(aggregate_interval_ / weight_update_interval_) * weight_update_steps_;
+
     const double l_rate = weight_update_interval_ * learning_rate_;
     std_wiener_ = std::sqrt(2.0 * temperature_ * l_rate);
     std_gradient_ = std::sqrt(2.0 * gradient_noise_ * l_rate);
@@ -30,14 +30,25 @@
 #define SYNAPTIC_SAMPLING_REWARDGRADIENT_CONNECTIO
 
 #include <cmath>
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <stdint.h>
 #include "nest.h"
+#include "numerics.h"
 #include "connection.h"
 #include "normal_randomdev.h"
 #include "spikecounter.h"
+#include "compose.hpp"
+#include "doublevectordatum.h"
+#include "intvectordatum.h"
 
 #include "tracing_node.h"
+#include "checkpoint.h"
+#include "diligent_connector_model.h"
 #include "connection_updater.h"
 #include "connection_data_logger.h"
+#include "value_distribution.h"
 #include "spore_names.h"
 
 #ifdef _OPENMP
@@ -150,12 +161,19 @@ public:
     double weight_update_interval_;
     double gradient_scale_;
     double psp_cutoff_amplitude_;
+    double prior_mean_; //!< prior mean of models with HomogeneousPrior
+    double prior_precision_; //!< prior precision of models with HomogeneousPrior
 
     long bap_trace_id_;
     long dopa_trace_id_;
 
     bool simulate_retracted_synapses_;
     bool delete_retracted_synapses_;
+    bool dormant_retracted_synapses_;
+
+    double aggregate_interval_;
+    long aggregate_bins_;
+    double aggregate_ranges_[6]; //!< histogram limits of weight, synaptic parameter and reward gradient
 
     // state variables
     TracingNode* reward_transmitter_;
@@ -169,6 +187,11 @@ public:
     double psp_scale_factor_;
 
     long weight_update_steps_;
+    long aggregate_steps_;
+
+    bool learning_frozen_; //!< copy of ConnectionUpdateManager::is_learning_frozen()
+    double learning_frozen_at_; //!< time when learning was frozen last [ms]
+    double learning_resumed_; //!< time when learning was resumed last [ms]
 
 private:
 
@@ -177,6 +200,317 @@ private:
     librandom::NormalRandomDev normal_dev_;
 };
 
+/**
+ * @brief Properties of SynapticSamplingRewardGradientConnection that depend on the target identifier.
+ *
+ * Connections with target pointers keep their recorder port as a member.
+ * Connections with index-based target identifier keep it in a side table.
+ */
+template <typename targetidentifierT>
+struct SynapticSamplingTraits
+{
+    typedef RecorderPortMember RecorderPortStorage;
+
+    static const char* label()
+    {
+        return "synaptic_sampling_rewardgradient";
+    }
+};
+
+/**
+ * @brief Properties of the compact SynapticSamplingRewardGradientConnection.
+ */
+template <>
+struct SynapticSamplingTraits<nest::TargetIdentifierIndex>
+{
+    typedef RecorderPortTable RecorderPortStorage;
+
+    static const char* label()
+    {
+        return "synaptic_sampling_rewardgradient_hpc";
+    }
+};
+
+/**
+ * @brief Gaussian prior of SynapticSamplingRewardGradientConnection, stored in each synapse.
+ *
+ * Default prior policy. Each synapse has its own \a prior_mean and
+ * \a prior_precision.
+ *
+ * @see HomogeneousPrior
+ */
+class SynapsePrior
+{
+public:
+    static const bool homogeneous = false;
+
+    SynapsePrior()
+    : prior_mean_(0.0),
+    prior_precision_(1.0)
+    {
+    }
+
+    double get_prior_mean(const SynapticSamplingRewardGradientCommonProperties&) const
+    {
+        return prior_mean_;
+    }
+
+    double get_prior_precision(const SynapticSamplingRewardGradientCommonProperties&) const
+    {
+        return prior_precision_;
+    }
+
+    /**
+     * @return the prior mean (\a i = 0) or precision (\a i = 1) of the synapse.
+     */
+    double* get_prior_field(size_t i)
+    {
+        return (i == 0) ? &prior_mean_ : &prior_precision_;
+    }
+
+    void get_prior(DictionaryDatum& d) const
+    {
+        def<double>(d, names::prior_mean, prior_mean_);
+        def<double>(d, names::prior_precision, prior_precision_);
+    }
+
+    void set_prior(const DictionaryDatum& d)
+    {
+        updateValue<double>(d, names::prior_mean, prior_mean_);
+        updateValue<double>(d, names::prior_precision, prior_precision_);
+    }
+
+    void get_prior(CheckpointSynapse& record) const
+    {
+        record.prior_mean = prior_mean_;
+        record.prior_precision = prior_precision_;
+    }
+
+    void set_prior(const CheckpointSynapse& record)
+    {
+        prior_mean_ = record.prior_mean;
+        prior_precision_ = record.prior_precision;
+    }
+
+    static void check_prior(const DictionaryDatum&)
+    {
+    }
+
+    static const char* label_suffix()
+    {
+        return "";
+    }
+
+private:
+    double prior_mean_;
+    double prior_precision_;
+};
+
+/**
+ * @brief Gaussian prior of SynapticSamplingRewardGradientConnection, shared by all synapses of a model.
+ *
+ * Prior policy of the \a _hom synapse models. \a prior_mean and
+ * \a prior_precision are common properties of the synapse model and take
+ * no memory in the synapses. They can only be set with SetDefaults or
+ * CopyModel. Per-synapse values in SetStatus are ignored.
+ *
+ * @see SynapsePrior
+ */
+class HomogeneousPrior
+{
+public:
+    static const bool homogeneous = true;
+
+    double get_prior_mean(const SynapticSamplingRewardGradientCommonProperties& cp) const
+    {
+        return cp.prior_mean_;
+    }
+
+    double get_prior_precision(const SynapticSamplingRewardGradientCommonProperties& cp) const
+    {
+        return cp.prior_precision_;
+    }
+
+    double* get_prior_field(size_t)
+    {
+        return 0;
+    }
+
+    void get_prior(DictionaryDatum&) const
+    {
+    }
+
+    void set_prior(const DictionaryDatum&)
+    {
+    }
+
+    /**
+     * The prior is not stored per synapse, so NaN is written to checkpoints.
+     */
+    void get_prior(CheckpointSynapse& record) const
+    {
+        record.prior_mean = std::numeric_limits<double>::quiet_NaN();
+        record.prior_precision = std::numeric_limits<double>::quiet_NaN();
+    }
+
+    void set_prior(const CheckpointSynapse&)
+    {
+    }
+
+    static void check_prior(const DictionaryDatum& syn_spec)
+    {
+        if (syn_spec->known(names::prior_mean) || syn_spec->known(names::prior_precision))
+        {
+            throw nest::BadProperty("prior_mean and prior_precision are common to all synapses of this "
+                                    "model. Use SetDefaults or CopyModel to set them.");
+        }
+    }
+
+    static const char* label_suffix()
+    {
+        return "_hom";
+    }
+};
+
+/**
+ * @brief Storage of synaptic parameter and reward gradient of SynapticSamplingRewardGradientConnection as double.
+ *
+ * Default storage policy. Values are stored as they are.
+ *
+ * @see FixedPointStorage
+ */
+class DoubleStorage
+{
+public:
+    DoubleStorage()
+    : synaptic_parameter_(0.0),
+    reward_gradient_(0.0)
+    {
+    }
+
+    double get_stored_parameter() const
+    {
+        return synaptic_parameter_;
+    }
+
+    void set_stored_parameter(double v)
+    {
+        synaptic_parameter_ = v;
+    }
+
+    void update_stored_parameter(double v, nest::thread, const SynapticSamplingRewardGradientCommonProperties&)
+    {
+        synaptic_parameter_ = v;
+    }
+
+    double get_stored_gradient() const
+    {
+        return reward_gradient_;
+    }
+
+    void set_stored_gradient(double v)
+    {
+        reward_gradient_ = v;
+    }
+
+    void update_stored_gradient(double v, nest::thread, const SynapticSamplingRewardGradientCommonProperties&)
+    {
+        reward_gradient_ = v;
+    }
+
+    static const char* label_suffix()
+    {
+        return "";
+    }
+
+private:
+    double synaptic_parameter_;
+    double reward_gradient_;
+};
+
+/**
+ * @brief Storage of synaptic parameter and reward gradient of SynapticSamplingRewardGradientConnection in fixed point.
+ *
+ * Storage policy of the \a _fixed synapse models. Both values are stored
+ * as 32-bit fixed point numbers with \a fraction_bits fractional bits,
+ * i.e. at a resolution of about 1e-6 in the range +/-2048. Values outside
+ * this range saturate. Values that are computed by the synapse dynamics
+ * are rounded stochastically, using the random number generator of the
+ * synapse's thread, such that the rounding error is zero on average.
+ * Values that are set by the user are rounded to the nearest value.
+ *
+ * @see DoubleStorage
+ */
+class FixedPointStorage
+{
+public:
+    static const int fraction_bits = 20;
+
+    FixedPointStorage()
+    : synaptic_parameter_(0),
+    reward_gradient_(0)
+    {
+    }
+
+    double get_stored_parameter() const
+    {
+        return to_double(synaptic_parameter_);
+    }
+
+    void set_stored_parameter(double v)
+    {
+        synaptic_parameter_ = to_fixed(v, 0.5);
+    }
+
+    void update_stored_parameter(double v, nest::thread thread,
+                                 const SynapticSamplingRewardGradientCommonProperties& cp)
+    {
+        synaptic_parameter_ = to_fixed(v, cp.drand(thread));
+    }
+
+    double get_stored_gradient() const
+    {
+        return to_double(reward_gradient_);
+    }
+
+    void set_stored_gradient(double v)
+    {
+        reward_gradient_ = to_fixed(v, 0.5);
+    }
+
+    void update_stored_gradient(double v, nest::thread thread,
+                                const SynapticSamplingRewardGradientCommonProperties& cp)
+    {
+        reward_gradient_ = to_fixed(v, cp.drand(thread));
+    }
+
+    static const char* label_suffix()
+    {
+        return "_fixed";
+    }
+
+private:
+
+    static double to_double(int32_t q)
+    {
+        return q / static_cast<double>(1 << fraction_bits);
+    }
+
+    /**
+     * Convert \a v to fixed point. The result is rounded up if the
+     * fractional part of the scaled value is at least 1 - \a u.
+     */
+    static int32_t to_fixed(double v, double u)
+    {
+        const double q = std::floor(v * static_cast<double>(1 << fraction_bits) + u);
+        return static_cast<int32_t>(std::max(static_cast<double>(std::numeric_limits<int32_t>::min()),
+                                             std::min(static_cast<double>(std::numeric_limits<int32_t>::max()), q)));
+    }
+
+    int32_t synaptic_parameter_;
+    int32_t reward_gradient_;
+};
+
 /**
  * @brief Reward-based synaptic sampling connection class
  *
@@ -240,11 +574,32 @@ private:
  * <tr><td>\a simulate_retracted_synapses</td> <td>bool</td>   <td>continue simulating retracted synapses
  *                                                              (false)</td></tr>
  * <tr><td>\a delete_retracted_synapses</td>   <td>bool</td>   <td>delete retracted synapses (false)</td></tr>
+ * <tr><td>\a dormant_retracted_synapses</td>  <td>bool</td>   <td>keep retracted synapses as dormant
+ *                                                              synapses (false)</td></tr>
+ * <tr><td>\a aggregate_interval</td>          <td>double</td> <td>interval of aggregate statistics, 0 turns
+ *                                                              them off (0.0, &ge;0.0) [ms]**</td></tr>
+ * <tr><td>\a aggregate_bins</td>              <td>long</td>   <td>number of histogram bins (20, &ge;1)</td></tr>
+ * <tr><td>\a weight_histogram_min/max</td>    <td>double</td> <td>histogram limits of weights (0.0/10.0)</td></tr>
+ * <tr><td>\a synaptic_parameter_histogram_min/max</td> <td>double</td> <td>histogram limits of synaptic
+ *                                                              parameters (-2.0/5.0)</td></tr>
+ * <tr><td>\a reward_gradient_histogram_min/max</td> <td>double</td> <td>histogram limits of reward
+ *                                                              gradients (-1.0/1.0)</td></tr>
  * </table>
  *
  * *)  \a reward_transmitter must be set to the GID of a TracingNode before
  *        simulation startup.
  *
+ * **) If \a aggregate_interval is larger than 0, statistics of \a weight,
+ *        \a synaptic_parameter and \a reward_gradient over all synapses of
+ *        the synapse model are accumulated in this interval (rounded up to
+ *        a multiple of \a weight_update_interval). Values outside of the
+ *        histogram limits are counted in the first or last bin. Aggregates
+ *        can be read with the SLI function \a GetSynapseAggregates, e.g.
+ *        nest.sli_func('GetSynapseAggregates', <model>). Every call returns
+ *        the time points that were not read before and that all synapses
+ *        have passed. Copy the synapse model to aggregate populations
+ *        separately.
+ *
  * The following parameters can be set in the status dictionary:
  * <table>
  * <tr><th>name</th>                           <th>type</th>   <th>comment</th></tr>
@@ -266,6 +621,14 @@ private:
  *                                                               </td></tr>
  * <tr><td>\a psp_values</td>                  <td>[double]</td> <td>array of recorded psp values*</td></tr>
  * <tr><td>\a recorder_interval</td>           <td>double</td> <td>interval of synaptic recordings [ms]</td></tr>
+ * <tr><td>\a recorder_stream</td>             <td>bool</td>   <td>write recordings to stream files instead of
+ *                                                             memory**</td></tr>
+ * <tr><td>\a recorder_port</td>               <td>int</td>    <td>id of the recorder of this synapse (read only)
+ *                                                             </td></tr>
+ * <tr><td>\a recorder_max_samples</td>        <td>int</td>    <td>maximum number of samples kept in memory,
+ *                                                             0 is unbounded (0)***</td></tr>
+ * <tr><td>\a recorder_decimation_levels</td>  <td>int</td>    <td>number of levels of decimated history (1)***
+ *                                                             </td></tr>
  * <tr><td>\a reset_recorder</td>              <td>bool</td>   <td>clear all recorded values now* (write only)
  *                                                             </td></tr>
  * </table>
@@ -273,6 +636,84 @@ private:
  * *) Recorder fields are read only. If \a reset_recorder is set to \c true
  *    all recorder fields will be cleared instantaneously.
  *
+ * **) If \a recorder_stream is set, recorder fields stay empty. Records are
+ *    appended to the files "<data_prefix>synaptic_sampling_rewardgradient-<thread>-<column>.dat"
+ *    in the data path of the kernel instead, which can be read with
+ *    utils/spore_recorder.py (see ConnectionDataLoggerBase and RecorderStream).
+ *
+ * ***) If \a recorder_max_samples is set, only the most recent samples are
+ *    kept. With \a recorder_decimation_levels \f$L > 1\f$ the samples are
+ *    split into \f$L\f$ rings of equal size. Every second sample that
+ *    drops out of one ring moves on to the next one, such that ring
+ *    \f$l\f$ holds older samples at \f$2^l\f$ times the recorder
+ *    interval. Changing either value clears the recorder.
+ *
+ * The state of all synapses of a synapse model can be read at once with the
+ * SLI function \a GetSynapseArrays, e.g.
+ * nest.sli_func('GetSynapseArrays', <model>). It returns a dictionary of
+ * flat arrays \a source, \a target, \a weight, \a synaptic_parameter,
+ * \a eligibility_trace and \a reward_gradient with one entry per local
+ * synapse, which is much faster than GetStatus for large networks.
+ *
+ * Likewise, \a synaptic_parameter, \a prior_mean and \a prior_precision
+ * can be initialized in bulk with the SLI function \a SetSynapseArrays,
+ * e.g. nest.sli_func('SetSynapseArrays', <model>, <dict>). Each variable
+ * in the dictionary can be given as a number, as a distribution
+ * dictionary (see ValueDistribution) or as an array. Arrays must be
+ * aligned with the connections given by the arrays \a source, \a target
+ * and \a target_thread (columns 0, 1 and 2 of the result of
+ * GetConnections). Multiple connections between the same nodes are matched
+ * in the order in which they appear in the arrays. Alternatively,
+ * connections can be given by \a source, \a target_thread and \a port
+ * (columns 0, 2 and 4), which is only valid as long as no connections were
+ * added since the connections were retrieved, since adding connections can
+ * change the ports of existing ones (see DiligentConnectorModel). Without
+ * connection arrays, all local synapses of the model are set. Random values are reproducible for a given \a seed (0)
+ * regardless of the number of threads.
+ *
+ * The state of all synapses of this type, together with the state and
+ * traces of all tracing nodes, can be saved to a checkpoint file with the
+ * SLI function \a SaveSporeCheckpoint and restored with
+ * \a LoadSporeCheckpoint, e.g. nest.sli_func('LoadSporeCheckpoint', <file>).
+ * Connections that do not exist when the checkpoint is restored are
+ * created (see SporeCheckpoint).
+ *
+ * For deployment, all synapses of this type can be replaced by static
+ * synapses that carry their current weight with the SLI function
+ * \a ConvertToStaticSynapses, e.g.
+ * nest.sli_func('ConvertToStaticSynapses', <model>, 'static_synapse').
+ * Retracted synapses are dropped. The learning state is lost.
+ *
+ * Learning of all synapses can be frozen for evaluation runs with the SLI
+ * function \a SetSporeStatus, e.g.
+ * nest.sli_func('SetSporeStatus', {'learning_frozen': True}). While frozen,
+ * synapses are not updated and deliver spikes with their current weight
+ * like static synapses. When learning is resumed, synapses continue from
+ * the state they had when learning was frozen, as if the frozen period
+ * had not happened (see ConnectionUpdateManager).
+ *
+ * For large networks, the model \a synaptic_sampling_rewardgradient_synapse_hpc
+ * uses NEST's index-based target identifier instead of a target pointer and
+ * receptor port, and keeps the recorder ports of recorded synapses in a side
+ * table (see RecorderPortTable), which reduces the size of each synapse by
+ * 24 bytes on 64-bit systems. Synapses of this model only support receptor
+ * port 0, and the number of local targets per thread is limited as for all
+ * NEST synapse models with index-based target identifier.
+ *
+ * If all synapses of a population share the same prior, the models
+ * \a synaptic_sampling_rewardgradient_synapse_hom and
+ * \a synaptic_sampling_rewardgradient_synapse_hom_hpc keep \a prior_mean and
+ * \a prior_precision as common properties of the synapse model instead
+ * (see HomogeneousPrior), which saves another 16 bytes per synapse. The
+ * prior is then set with SetDefaults or CopyModel.
+ *
+ * The models \a synaptic_sampling_rewardgradient_synapse_hpc_fixed and
+ * \a synaptic_sampling_rewardgradient_synapse_hom_hpc_fixed store
+ * \a synaptic_parameter and \a reward_gradient as 32-bit fixed point numbers
+ * (see FixedPointStorage), which saves another 8 bytes per synapse. Updates
+ * of these values are rounded stochastically, so their dynamics are not
+ * biased by the limited resolution.
+ *
  * <b>Implementation Details</b>
  *
  * This connection type is a diligent synapse model, therefore updates are triggered
@@ -328,6 +769,19 @@ private:
  * retracted synapses will be removed from the network using the garbage
  * collector of the ConnectionUpdateManager.
  *
+ * If \a dormant_retracted_synapses is set to \c true, retracted synapses
+ * are removed from the network as well, but are kept by the
+ * ConnectionUpdateManager as dormant synapses, which store only source,
+ * target, delay, receptor port and \f$\theta(t)\f$. Spikes are not
+ * delivered to dormant synapses. Their synaptic parameters follow equation
+ * (4) with \f$g(t) = 0\f$ on the grid of weight updates, and they are
+ * connected again when \f$\theta(t)\f$ is not negative at an update of
+ * the ConnectionUpdateManager. Dormant synapses are not recorded, are not
+ * included in aggregates, GetConnections, GetSynapseArrays or checkpoints,
+ * and lose their recorder ports. This mode is only available for the
+ * \a _hom synapse models and can not be combined with
+ * \a simulate_retracted_synapses or \a delete_retracted_synapses.
+ *
  * <b>References</b>
  *
  * [1] David Kappel, Robert Legenstein, Stefan Habenschuss, Michael Hsieh and
@@ -348,13 +802,16 @@ private:
  *
  * @see TracingNode, DiligentConnectorModel
  */
-template<typename targetidentifierT>
-class SynapticSamplingRewardGradientConnection : public nest::Connection<targetidentifierT>
+template<typename targetidentifierT, typename priorT = SynapsePrior, typename storageT = DoubleStorage>
+class SynapticSamplingRewardGradientConnection : public nest::Connection<targetidentifierT>,
+                                                 private SynapticSamplingTraits<targetidentifierT>::RecorderPortStorage,
+                                                 private priorT,
+                                                 private storageT
 {
 public:
 
     SynapticSamplingRewardGradientConnection();
-    SynapticSamplingRewardGradientConnection(const SynapticSamplingRewardGradientConnection<targetidentifierT>& rhs);
+    SynapticSamplingRewardGradientConnection(const SynapticSamplingRewardGradientConnection& rhs);
     ~SynapticSamplingRewardGradientConnection();
 
     //! Type to use for representing common synapse properties
@@ -363,6 +820,9 @@ public:
     //! Shortcut for base class
     typedef nest::Connection<targetidentifierT> ConnectionBase;
 
+    //! Storage of the recorder port
+    typedef typename SynapticSamplingTraits<targetidentifierT>::RecorderPortStorage RecorderPortStorage;
+
     /**
      * Checks if the type of the postsynaptic node is supported. Throws an
      * \a IllegalConnection exception if the postsynaptic node is not
@@ -385,8 +845,13 @@ public:
     void set_status(const DictionaryDatum& d, nest::ConnectorModel& cm);
 
     void send(nest::Event& e, nest::thread t, double t_lastspike, const CommonPropertiesType& cp);
+    void send_frozen(nest::Event& e, nest::thread t, double t_lastspike, const CommonPropertiesType& cp);
+    void prefetch(nest::thread t, double t_lastspike, const CommonPropertiesType& cp) const;
     void check_synapse_params( const DictionaryDatum& syn_spec ) const;
 
+    static void update_dormant(DormantPool& pool, const nest::Time& time, nest::thread thread,
+                               nest::synindex syn_id, const CommonPropertiesType& cp);
+
     using ConnectionBase::get_delay_steps;
     using ConnectionBase::get_delay;
     using ConnectionBase::get_rport;
@@ -402,7 +867,7 @@ public:
      */
     void set_weight(double w)
     {
-        synaptic_parameter_ = w;
+        storageT::set_stored_parameter(w);
     }
 
     /**
@@ -434,7 +899,7 @@ public:
      */
     double get_synaptic_parameter() const
     {
-        return synaptic_parameter_;
+        return storageT::get_stored_parameter();
     }
 
     /**
@@ -442,7 +907,7 @@ public:
      */
     double get_reward_gradient() const
     {
-        return reward_gradient_;
+        return storageT::get_stored_gradient();
     }
 
     /**
@@ -455,32 +920,62 @@ public:
 
     static ConnectionDataLogger<SynapticSamplingRewardGradientConnection>* logger();
 
+    static void get_synapse_arrays(nest::synindex syn_id, DictionaryDatum& d);
+    static void set_synapse_arrays(nest::synindex syn_id, const DictionaryDatum& d);
+    static void convert_to_static(nest::synindex syn_id, nest::synindex static_id, DictionaryDatum& d);
+
+    void get_checkpoint(CheckpointSynapse& record) const;
+    void set_checkpoint(const CheckpointSynapse& record);
+
 private:
 
+    /**
+     * @brief Connection to be replaced by a static connection.
+     */
+    struct StaticConnection
+    {
+        nest::index source_;
+        nest::Node* target_;
+        nest::rport rport_;
+        double delay_;
+        double weight_;
+    };
+
     double weight_;
-    double synaptic_parameter_;
 
     double psp_facilitation_;
     double psp_depression_;
 
     double eligibility_trace_;
-    double reward_gradient_;
-
-    double prior_mean_;
-    double prior_precision_;
-
-    nest::index recorder_port_;
 
     static ConnectionDataLogger<SynapticSamplingRewardGradientConnection>* logger_;
 
-    void update_synapse_state(long t_to,
+    template < typename DopaIteratorT >
+    void update_synapse(nest::thread thread,
+                        long s_from,
+                        long s_to,
+                        double t_last_spike,
+                        TracingNode::const_iterator& bap_trace,
+                        DopaIteratorT& dopa_trace,
+                        const CommonPropertiesType& cp);
+
+    template < typename DopaIteratorT >
+    void update_synapse_state(nest::thread thread,
+                              long t_to,
                               long t_last_update,
                               TracingNode::const_iterator& bap_trace,
-                              TracingNode::const_iterator& dopa_trace,
+                              DopaIteratorT& dopa_trace,
                               const CommonPropertiesType& cp);
 
     void update_synapic_parameter(nest::thread thread, const CommonPropertiesType& cp);
-    void update_synapic_weight(long time_step, const CommonPropertiesType& cp);
+    static void update_dormant_parameter(double& synaptic_parameter, long s_from, long s_to,
+                                         nest::thread thread, const CommonPropertiesType& cp);
+    static void promote_dormant(const DormantSynapse& synapse, nest::thread thread, nest::synindex syn_id,
+                                const CommonPropertiesType& cp);
+    nest::thread get_model_thread(const nest::ConnectorModel& cm) const;
+    void set_bulk_values(const ValueSource* values, size_t k, uint64_t seed,
+                         nest::index source, nest::index target, size_t port);
+    void update_synapic_weight(nest::thread thread, long time_step, const CommonPropertiesType& cp);
 
     class ConnTestDummyNode : public nest::ConnTestDummyNodeBase
     {
@@ -511,18 +1006,13 @@ private:
 /**
  * Default Constructor.
  */
-template <typename targetidentifierT>
-SynapticSamplingRewardGradientConnection<targetidentifierT>::SynapticSamplingRewardGradientConnection()
+template <typename targetidentifierT, typename priorT, typename storageT>
+SynapticSamplingRewardGradientConnection<targetidentifierT, priorT, storageT>::SynapticSamplingRewardGradientConnection()
 : ConnectionBase(),
 weight_(0.0),
-synaptic_parameter_(0.0),
 psp_facilitation_(0.0),
 psp_depression_(0.0),
-eligibility_trace_(0.0),
-reward_gradient_(0.0),
-prior_mean_(0.0),
-prior_precision_(1.0),
-recorder_port_(nest::invalid_index)
+eligibility_trace_(0.0)
 {
     // make sure the global logger object is instantiated here.
     logger();
@@ -531,19 +1021,17 @@ recorder_port_(nest::invalid_index)
 /**
  * Copy Constructor.
  */
-template <typename targetidentifierT>
-SynapticSamplingRewardGradientConnection<targetidentifierT>::
+template <typename targetidentifierT, typename priorT, typename storageT>
+SynapticSamplingRewardGradientConnection<targetidentifierT, priorT, storageT>::
 SynapticSamplingRewardGradientConnection(const SynapticSamplingRewardGradientConnection& rhs)
 : ConnectionBase(rhs),
+RecorderPortStorage(rhs),
+priorT(rhs),
+storageT(rhs),
 weight_(rhs.weight_),
-synaptic_parameter_(rhs.synaptic_parameter_),
 psp_facilitation_(rhs.psp_facilitation_),
 psp_depression_(rhs.psp_depression_),
-eligibility_trace_(rhs.eligibility_trace_),
-reward_gradient_(rhs.reward_gradient_),
-prior_mean_(rhs.prior_mean_),
-prior_precision_(rhs.prior_precision_),
-recorder_port_(nest::invalid_index)
+eligibility_trace_(rhs.eligibility_trace_)
 {
     // make sure the global logger object is instantiated here.
     logger();
@@ -552,8 +1040,8 @@ recorder_port_(nest::invalid_index)
 /**
  * Destructor.
  */
-template <typename targetidentifierT>
-SynapticSamplingRewardGradientConnection<targetidentifierT>::~SynapticSamplingRewardGradientConnection()
+template <typename targetidentifierT, typename priorT, typename storageT>
+SynapticSamplingRewardGradientConnection<targetidentifierT, priorT, storageT>::~SynapticSamplingRewardGradientConnection()
 {
 }
 
@@ -564,9 +1052,9 @@ SynapticSamplingRewardGradientConnection<targetidentifierT>::~SynapticSamplingRe
 /**
  * Pointer to the global instance of the data logger.
  */
-template <typename targetidentifierT>
-ConnectionDataLogger< SynapticSamplingRewardGradientConnection<targetidentifierT> >
-*SynapticSamplingRewardGradientConnection<targetidentifierT>::logger_ = 0;
+template <typename targetidentifierT, typename priorT, typename storageT>
+ConnectionDataLogger< SynapticSamplingRewardGradientConnection<targetidentifierT, priorT, storageT> >
+*SynapticSamplingRewardGradientConnection<targetidentifierT, priorT, storageT>::logger_ = 0;
 
 /**
  * Get the data logger singleton.
@@ -576,9 +1064,9 @@ ConnectionDataLogger< SynapticSamplingRewardGradientConnection<targetidentifierT
  *
  * @return the instance of the data logger.
  */
-template <typename targetidentifierT>
-ConnectionDataLogger< SynapticSamplingRewardGradientConnection<targetidentifierT> >
-*SynapticSamplingRewardGradientConnection<targetidentifierT>::logger()
+template <typename targetidentifierT, typename priorT, typename storageT>
+ConnectionDataLogger< SynapticSamplingRewardGradientConnection<targetidentifierT, priorT, storageT> >
+*SynapticSamplingRewardGradientConnection<targetidentifierT, priorT, storageT>::logger()
 {
     if (!logger_)
     {
@@ -588,7 +1076,9 @@ ConnectionDataLogger< SynapticSamplingRewardGradientConnection<targetidentifierT
         assert( not omp_in_parallel() );
 #endif
 
-        logger_ = new ConnectionDataLogger<SynapticSamplingRewardGradientConnection>();
+        logger_ = new ConnectionDataLogger<SynapticSamplingRewardGradientConnection>(
+                std::string(SynapticSamplingTraits<targetidentifierT>::label()) + priorT::label_suffix() +
+                storageT::label_suffix());
 
         logger_->register_recordable_variable(names::eligibility_trace_values,
                                               &SynapticSamplingRewardGradientConnection::get_eligibility_trace);
@@ -602,60 +1092,565 @@ ConnectionDataLogger< SynapticSamplingRewardGradientConnection<targetidentifierT
                                               &SynapticSamplingRewardGradientConnection::get_synaptic_parameter);
         logger_->register_recordable_variable(names::reward_gradient_values,
                                               &SynapticSamplingRewardGradientConnection::get_reward_gradient);
+
+        // order must match SynapticSamplingRewardGradientCommonProperties::aggregate_ranges_
+        logger_->register_aggregate_variable(nest::names::weight,
+                                             &SynapticSamplingRewardGradientConnection::get_weight);
+        logger_->register_aggregate_variable(names::synaptic_parameter,
+                                             &SynapticSamplingRewardGradientConnection::get_synaptic_parameter);
+        logger_->register_aggregate_variable(names::reward_gradient,
+                                             &SynapticSamplingRewardGradientConnection::get_reward_gradient);
     }
 
     return logger_;
 }
 
-//
-// Parameter and state extractions and manipulation functions
-//
-
 /**
- * Check syn_spec dictionary for parameters that are not allowed for this
- * connection. Will issue warning or throw error if a parameter is found.
+ * Read the state of all local synapses of the given synapse model into flat
+ * arrays. The connectors of each thread are read in parallel and the
+ * arrays are ordered by thread. This function must not be called while
+ * connections are created or simulated.
+ *
+ * @param syn_id the synapse model, must be instantiated from this class.
+ * @param d dictionary to retrieve the arrays.
  */
-template <typename targetidentifierT>
-void SynapticSamplingRewardGradientConnection<targetidentifierT>::check_synapse_params(const DictionaryDatum& syn_spec)
-    const
+template <typename targetidentifierT, typename priorT, typename storageT>
+void SynapticSamplingRewardGradientConnection<targetidentifierT, priorT, storageT>::get_synapse_arrays(nest::synindex syn_id,
+                                                                                             DictionaryDatum& d)
 {
-    // FIXME!! Check synaptic parameters here!
+    typedef std::vector< std::pair< nest::index, nest::vector_like<SynapticSamplingRewardGradientConnection>* > >
+            ConnectorList;
+
+    const size_t num_threads = nest::kernel().vp_manager.get_num_threads();
+    std::vector<size_t> offsets(num_threads + 1, 0);
+
+    IntVectorDatum sources(new std::vector<long>());
+    IntVectorDatum targets(new std::vector<long>());
+    DoubleVectorDatum weights(new std::vector<double>());
+    DoubleVectorDatum synaptic_parameters(new std::vector<double>());
+    DoubleVectorDatum eligibility_traces(new std::vector<double>());
+    DoubleVectorDatum reward_gradients(new std::vector<double>());
+
+#pragma omp parallel
+    {
+        const nest::thread th = nest::kernel().vp_manager.get_thread_id();
+
+        ConnectorList connectors;
+        ConnectionUpdateManager::instance()->get_connectors(syn_id, th, connectors);
+
+        size_t count = 0;
+        for (size_t c = 0; c < connectors.size(); c++)
+        {
+            count += connectors[c].second->size();
+        }
+        offsets[th + 1] = count;
+
+#pragma omp barrier
+#pragma omp single
+        {
+            for (size_t t = 0; t < num_threads; t++)
+            {
+                offsets[t + 1] += offsets[t];
+            }
+            sources->resize(offsets[num_threads]);
+            targets->resize(offsets[num_threads]);
+            weights->resize(offsets[num_threads]);
+            synaptic_parameters->resize(offsets[num_threads]);
+            eligibility_traces->resize(offsets[num_threads]);
+            reward_gradients->resize(offsets[num_threads]);
+        } // implicit barrier
+
+        size_t k = offsets[th];
+        for (size_t c = 0; c < connectors.size(); c++)
+        {
+            const nest::vector_like<SynapticSamplingRewardGradientConnection>& connector = *connectors[c].second;
+            for (size_t i = 0; i < connector.size(); i++, k++)
+            {
+                const SynapticSamplingRewardGradientConnection& connection = connector.at(i);
+                (*sources)[k] = connectors[c].first;
+                (*targets)[k] = connection.get_target(th)->get_gid();
+                (*weights)[k] = connection.weight_;
+                (*synaptic_parameters)[k] = connection.get_synaptic_parameter();
+                (*eligibility_traces)[k] = connection.eligibility_trace_;
+                (*reward_gradients)[k] = connection.get_reward_gradient();
+            }
+        }
+    }
+
+    (*d)[nest::names::source] = sources;
+    (*d)[nest::names::target] = targets;
+    (*d)[nest::names::weight] = weights;
+    (*d)[names::synaptic_parameter] = synaptic_parameters;
+    (*d)[names::eligibility_trace] = eligibility_traces;
+    (*d)[names::reward_gradient] = reward_gradients;
 }
 
 /**
- * Status getter function.
+ * Set \a synaptic_parameter, \a prior_mean and \a prior_precision of
+ * synapses of the given synapse model in bulk. Synapses are set in parallel
+ * by the thread they belong to. This function must not be called while
+ * connections are created or simulated.
+ *
+ * @param syn_id the synapse model, must be instantiated from this class.
+ * @param d dictionary with the values and, optionally, the connections.
  */
-template <typename targetidentifierT>
-void SynapticSamplingRewardGradientConnection<targetidentifierT>::get_status(DictionaryDatum& d) const
+template <typename targetidentifierT, typename priorT, typename storageT>
+void SynapticSamplingRewardGradientConnection<targetidentifierT, priorT, storageT>::set_synapse_arrays(nest::synindex syn_id,
+                                                                                             const DictionaryDatum& d)
 {
-    ConnectionBase::get_status(d);
-    def<double>(d, nest::names::weight, weight_);
-    def<double>(d, names::synaptic_parameter, synaptic_parameter_);
-    def<double>(d, names::eligibility_trace, eligibility_trace_);
-    def<double>(d, names::reward_gradient, reward_gradient_);
-    def<double>(d, names::prior_mean, prior_mean_);
-    def<double>(d, names::prior_precision, prior_precision_);
-    def<long>(d, nest::names::size_of, sizeof (*this));
+    typedef nest::vector_like<SynapticSamplingRewardGradientConnection> ConnectorType;
+    typedef std::vector< std::pair< nest::index, ConnectorType* > > ConnectorList;
 
-    logger()->get_status(d, recorder_port_);
-}
+    const size_t num_threads = nest::kernel().vp_manager.get_num_threads();
 
-/**
+    long seed = 0;
+    updateValue<long>(d, names::seed, seed);
+
+    const bool aligned = d->known(nest::names::source);
+    const bool by_target = d->known(nest::names::target);
+    std::vector<long> sources;
+    std::vector<long> target_gids;
+    std::vector<long> threads;
+    std::vector<long> ports;
+
+    if (aligned)
+    {
+        sources = getValue< std::vector<long> >(d, nest::names::source);
+        threads = getValue< std::vector<long> >(d, names::target_thread);
+
+        // connections are matched by target if given, otherwise by port
+        if (by_target)
+        {
+            target_gids = getValue< std::vector<long> >(d, nest::names::target);
+            ports.assign(sources.size(), -1);
+        }
+        else
+        {
+            ports = getValue< std::vector<long> >(d, names::port);
+            target_gids.assign(sources.size(), -1);
+        }
+
+        if (threads.size() != sources.size() || ports.size() != sources.size() ||
+            target_gids.size() != sources.size())
+        {
+            throw nest::BadProperty("SetSynapseArrays: 'source', 'target_thread' and 'target' or 'port' must "
+                                    "have the same length.");
+        }
+    }
+
+    const size_t n = sources.size();
+
+    // bucket the connections by thread
+    std::vector< std::vector<size_t> > thread_connections(num_threads);
+    for (size_t k = 0; k < n; k++)
+    {
+        if (threads[k] < 0 || static_cast<size_t>(threads[k]) >= num_threads)
+        {
+            throw nest::BadProperty(String::compose("SetSynapseArrays: invalid target_thread %1 of "
+                                                    "connection %2.", threads[k], k));
+        }
+        thread_connections[threads[k]].push_back(k);
+    }
+
+    ValueSource values[3];
+    values[0].set(d, names::synaptic_parameter, aligned, n);
+    values[1].set(d, names::prior_mean, aligned, n);
+    values[2].set(d, names::prior_precision, aligned, n);
+
+    if (priorT::homogeneous && (values[1].is_defined() || values[2].is_defined()))
+    {
+        throw nest::BadProperty("SetSynapseArrays: prior_mean and prior_precision are common to all "
+                                "synapses of this model.");
+    }
+
+    std::vector<long> invalid(num_threads, -1);
+
+#pragma omp parallel
+    {
+        const nest::thread th = nest::kernel().vp_manager.get_thread_id();
+
+        ConnectorList connectors;
+        ConnectionUpdateManager::instance()->get_connectors(syn_id, th, connectors);
+
+        if (aligned)
+        {
+            std::map< nest::index, ConnectorType* > source_connectors;
+            for (size_t c = 0; c < connectors.size(); c++)
+            {
+                source_connectors[connectors[c].first] = connectors[c].second;
+            }
+
+            // look up all connections before writing, such that nothing is
+            // changed if one of them does not exist. Connections between the
+            // same nodes are matched by target in the order of the arrays.
+            const std::vector<size_t>& own = thread_connections[th];
+            std::vector<SynapticSamplingRewardGradientConnection*> targets(own.size(), 0);
+            std::map< std::pair<long, long>, size_t > parallel;
+            for (size_t j = 0; j < own.size(); j++)
+            {
+                const size_t k = own[j];
+                typename std::map< nest::index, ConnectorType* >::const_iterator it =
+                        source_connectors.find(sources[k]);
+                if (it != source_connectors.end() && by_target && target_gids[k] > 0)
+                {
+                    ports[k] = DiligentConnectorModel<SynapticSamplingRewardGradientConnection>::find_connection(
+                            it->second, target_gids[k], th) + parallel[std::make_pair(sources[k], target_gids[k])]++;
+                }
+                if (it == source_connectors.end() || ports[k] < 0 ||
+                    static_cast<size_t>(ports[k]) >= it->second->size() ||
+                    (by_target && it->second->at(ports[k]).get_target(th)->get_gid() !=
+                                  static_cast<nest::index>(target_gids[k])))
+                {
+                    invalid[th] = k;
+                    break;
+                }
+                targets[j] = &it->second->at(ports[k]);
+            }
+
+#pragma omp barrier
+
+            if (std::count(invalid.begin(), invalid.end(), -1) == static_cast<long>(num_threads))
+            {
+                for (size_t j = 0; j < own.size(); j++)
+                {
+                    const size_t k = own[j];
+                    targets[j]->set_bulk_values(values, k, seed, sources[k],
+                                                targets[j]->get_target(th)->get_gid(), ports[k]);
+                }
+            }
+        }
+        else
+        {
+            for (size_t c = 0; c < connectors.size(); c++)
+            {
+                ConnectorType& connector = *connectors[c].second;
+                for (size_t i = 0; i < connector.size(); i++)
+                {
+                    SynapticSamplingRewardGradientConnection& connection = connector.at(i);
+                    connection.set_bulk_values(values, 0, seed, connectors[c].first,
+                                               connection.get_target(th)->get_gid(), i);
+                }
+            }
+        }
+    }
+
+    for (size_t t = 0; t < num_threads; t++)
+    {
+        if (invalid[t] >= 0)
+        {
+            if (by_target)
+            {
+                throw nest::BadProperty(String::compose("SetSynapseArrays: connection %1 (source %2, target %3, "
+                                                        "target_thread %4) does not exist.", invalid[t],
+                                                        sources[invalid[t]], target_gids[invalid[t]], t));
+            }
+            throw nest::BadProperty(String::compose("SetSynapseArrays: connection %1 (source %2, target_thread "
+                                                    "%3, port %4) does not exist.", invalid[t],
+                                                    sources[invalid[t]], t, ports[invalid[t]]));
+        }
+    }
+}
+
+/**
+ * Replace all synapses of the given synapse model by connections of the
+ * model \a static_id that carry their current weight, e.g. static synapses.
+ * Synapses that do not transmit spikes (retracted synapses) and dormant
+ * synapses of the model are dropped.
+ * Synapses are converted in parallel by the thread they belong to. This
+ * function must not be called while connections are created or simulated.
+ *
+ * @param syn_id the synapse model, must be instantiated from this class.
+ * @param static_id the synapse model of the new connections.
+ * @param d dictionary to retrieve the number of created and dropped connections.
+ */
+template <typename targetidentifierT, typename priorT, typename storageT>
+void SynapticSamplingRewardGradientConnection<targetidentifierT, priorT, storageT>::convert_to_static(nest::synindex syn_id,
+                                                                                            nest::synindex static_id,
+                                                                                            DictionaryDatum& d)
+{
+    typedef nest::vector_like<SynapticSamplingRewardGradientConnection> ConnectorType;
+    typedef std::vector< std::pair< nest::index, ConnectorType* > > ConnectorList;
+
+    const size_t num_threads = nest::kernel().vp_manager.get_num_threads();
+
+    std::vector<size_t> created(num_threads, 0);
+    std::vector<size_t> dropped(num_threads, 0);
+    std::vector<std::string> errors(num_threads);
+
+#pragma omp parallel
+    {
+        const nest::thread th = nest::kernel().vp_manager.get_thread_id();
+
+        const CommonPropertiesType& cp =
+                static_cast<const nest::GenericConnectorModel<SynapticSamplingRewardGradientConnection>&>(
+                    nest::kernel().model_manager.get_synapse_prototype(syn_id, th)).get_common_properties();
+
+        ConnectorList connectors;
+        ConnectionUpdateManager::instance()->get_connectors(syn_id, th, connectors);
+
+        // copy all connections before the connectors are changed and mark
+        // them for deletion (see DiligentConnectorModel::delete_connection).
+        std::vector<StaticConnection> connections;
+        for (size_t c = 0; c < connectors.size(); c++)
+        {
+            ConnectorType& connector = *connectors[c].second;
+            for (size_t i = 0; i < connector.size(); i++)
+            {
+                SynapticSamplingRewardGradientConnection& connection = connector.at(i);
+                if (connector.get_t_lastspike() == 0.0 && !connection.is_degenerated())
+                {
+                    // the weight of a new synapse is set on its first update.
+                    connection.update_synapic_weight(th, 0, cp);
+                }
+
+                StaticConnection sc;
+                sc.source_ = connectors[c].first;
+                sc.target_ = connection.get_target(th);
+                sc.rport_ = connection.get_rport();
+                sc.delay_ = connection.get_delay();
+                sc.weight_ = connection.is_degenerated() ? 0.0 : connection.weight_;
+                connections.push_back(sc);
+
+                connection.psp_facilitation_ = -1.0;
+            }
+        }
+
+        try
+        {
+            // delete connections from the back of their connectors.
+            for (size_t k = connections.size(); k > 0; k--)
+            {
+                nest::kernel().connection_manager.disconnect(*connections[k - 1].target_,
+                                                             connections[k - 1].source_, th, syn_id);
+            }
+
+            for (size_t k = 0; k < connections.size(); k++)
+            {
+                const StaticConnection& sc = connections[k];
+                if (sc.weight_ > 0.0 && sc.rport_ == 0)
+                {
+                    nest::kernel().connection_manager.connect(sc.source_, sc.target_, th, static_id,
+                                                              sc.delay_, sc.weight_);
+                    created[th]++;
+                }
+                else if (sc.weight_ > 0.0)
+                {
+                    DictionaryDatum params(new Dictionary);
+                    def<long>(params, nest::names::receptor_type, sc.rport_);
+                    nest::kernel().connection_manager.connect(sc.source_, sc.target_, th, static_id, params,
+                                                              sc.delay_, sc.weight_);
+                    created[th]++;
+                }
+                else
+                {
+                    dropped[th]++;
+                }
+            }
+        }
+        catch (nest::KernelException& e)
+        {
+            errors[th] = e.message();
+        }
+        catch (std::exception& e)
+        {
+            errors[th] = e.what();
+        }
+    }
+
+    // dormant synapses are retracted and dropped as well, such that they
+    // are not turned into plastic connections again.
+    size_t n_dropped = ConnectionUpdateManager::instance()->drop_dormant(syn_id);
+    ConnectionUpdateManager::instance()->check_connections();
+
+    for (size_t t = 0; t < num_threads; t++)
+    {
+        if (!errors[t].empty())
+        {
+            throw nest::BadProperty(String::compose("ConvertToStaticSynapses: %1", errors[t]));
+        }
+    }
+
+    size_t n_created = 0;
+    for (size_t t = 0; t < num_threads; t++)
+    {
+        n_created += created[t];
+        n_dropped += dropped[t];
+    }
+    def<long>(d, names::created, n_created);
+    def<long>(d, names::dropped, n_dropped);
+}
+
+/**
+ * Set the variables of this synapse that are defined in \a values.
+ *
+ * @param values sources of synaptic_parameter, prior_mean and prior_precision.
+ * @param k index of this synapse in value arrays.
+ * @param seed seed of random values.
+ * @param source GID of the presynaptic node.
+ * @param target GID of the postsynaptic node.
+ * @param port index of this synapse in its connector.
+ */
+template <typename targetidentifierT, typename priorT, typename storageT>
+void SynapticSamplingRewardGradientConnection<targetidentifierT, priorT, storageT>::set_bulk_values(const ValueSource* values,
+                                                                                          size_t k, uint64_t seed,
+                                                                                          nest::index source,
+                                                                                          nest::index target,
+                                                                                          size_t port)
+{
+    const uint64_t key = ValueDistribution::key(ValueDistribution::key(ValueDistribution::key(seed, source),
+                                                                       target), port);
+    if (values[0].is_defined())
+    {
+        storageT::set_stored_parameter(values[0].get(k, ValueDistribution::key(key, 0)));
+    }
+
+    for (size_t i = 1; i < 3; i++)
+    {
+        double* field = priorT::get_prior_field(i - 1);
+        if (values[i].is_defined() && field)
+        {
+            *field = values[i].get(k, ValueDistribution::key(key, i));
+        }
+    }
+}
+
+/**
+ * Store the delay and the state of this synapse in a checkpoint record.
+ * Source, target and port of the record are set by the caller.
+ *
+ * @param record the record to write.
+ */
+template <typename targetidentifierT, typename priorT, typename storageT>
+void SynapticSamplingRewardGradientConnection<targetidentifierT, priorT, storageT>::get_checkpoint(
+        CheckpointSynapse& record) const
+{
+    record.delay = get_delay();
+    record.weight = weight_;
+    record.synaptic_parameter = get_synaptic_parameter();
+    record.psp_facilitation = psp_facilitation_;
+    record.psp_depression = psp_depression_;
+    record.eligibility_trace = eligibility_trace_;
+    record.reward_gradient = get_reward_gradient();
+    priorT::get_prior(record);
+}
+
+/**
+ * Restore the state of this synapse from a checkpoint record.
+ *
+ * @param record the record to read.
+ */
+template <typename targetidentifierT, typename priorT, typename storageT>
+void SynapticSamplingRewardGradientConnection<targetidentifierT, priorT, storageT>::set_checkpoint(
+        const CheckpointSynapse& record)
+{
+    weight_ = record.weight;
+    storageT::set_stored_parameter(record.synaptic_parameter);
+    psp_facilitation_ = record.psp_facilitation;
+    psp_depression_ = record.psp_depression;
+    eligibility_trace_ = record.eligibility_trace;
+    storageT::set_stored_gradient(record.reward_gradient);
+    priorT::set_prior(record);
+}
+
+//
+// Parameter and state extractions and manipulation functions
+//
+
+/**
+ * Check syn_spec dictionary for parameters that are not allowed for this
+ * connection. Will issue warning or throw error if a parameter is found.
+ */
+template <typename targetidentifierT, typename priorT, typename storageT>
+void SynapticSamplingRewardGradientConnection<targetidentifierT, priorT, storageT>::check_synapse_params(
+        const DictionaryDatum& syn_spec) const
+{
+    // FIXME!! Check synaptic parameters here!
+    priorT::check_prior(syn_spec);
+}
+
+/**
+ * Status getter function.
+ */
+template <typename targetidentifierT, typename priorT, typename storageT>
+void SynapticSamplingRewardGradientConnection<targetidentifierT, priorT, storageT>::get_status(DictionaryDatum& d) const
+{
+    ConnectionBase::get_status(d);
+    def<double>(d, nest::names::weight, weight_);
+    def<double>(d, names::synaptic_parameter, get_synaptic_parameter());
+    def<double>(d, names::eligibility_trace, eligibility_trace_);
+    def<double>(d, names::reward_gradient, get_reward_gradient());
+    priorT::get_prior(d);
+    def<long>(d, nest::names::size_of, sizeof (*this));
+
+    logger()->get_status(d, RecorderPortStorage::get_recorder_port(-1));
+}
+
+/**
  * @brief Status setter function.
  *
  * @note \a weight will be overwritten next time when the synapse is updated.
  */
-template <typename targetidentifierT>
-void SynapticSamplingRewardGradientConnection<targetidentifierT>::set_status(const DictionaryDatum& d,
-                                                                             nest::ConnectorModel& cm)
+template <typename targetidentifierT, typename priorT, typename storageT>
+void SynapticSamplingRewardGradientConnection<targetidentifierT, priorT, storageT>::set_status(const DictionaryDatum& d,
+                                                                                     nest::ConnectorModel& cm)
 {
+    bool dormant = false;
+    if (!priorT::homogeneous && updateValue<bool>(d, names::dormant_retracted_synapses, dormant) && dormant)
+    {
+        throw nest::BadProperty("dormant_retracted_synapses is only available for synapse models with "
+                                "homogeneous prior.");
+    }
+
     ConnectionBase::set_status(d, cm);
     updateValue<double>(d, nest::names::weight, weight_);
-    updateValue<double>(d, names::synaptic_parameter, synaptic_parameter_);
-    updateValue<double>(d, names::prior_mean, prior_mean_);
-    updateValue<double>(d, names::prior_precision, prior_precision_);
+    double synaptic_parameter;
+    if (updateValue<double>(d, names::synaptic_parameter, synaptic_parameter))
+    {
+        storageT::set_stored_parameter(synaptic_parameter);
+    }
+    priorT::set_prior(d);
+
+    const ConnectionDataLoggerBase::recorder_port old_port = RecorderPortStorage::get_recorder_port(-1);
+    ConnectionDataLoggerBase::recorder_port port = old_port;
+    logger()->set_status(d, port);
 
-    logger()->set_status(d, recorder_port_);
+    if (port != old_port)
+    {
+        RecorderPortStorage::set_recorder_port(port, get_model_thread(cm));
+    }
+}
+
+/**
+ * Find the thread of the connections that are configured through the given
+ * synapse prototype. NEST passes the prototype of the thread that owns the
+ * connection to set_status().
+ *
+ * @param cm the synapse prototype.
+ * @return the thread of the connection, 0 if not found.
+ */
+template <typename targetidentifierT, typename priorT, typename storageT>
+nest::thread SynapticSamplingRewardGradientConnection<targetidentifierT, priorT, storageT>::get_model_thread(
+                const nest::ConnectorModel& cm) const
+{
+#ifdef _OPENMP
+    if (omp_in_parallel())
+    {
+        return nest::kernel().vp_manager.get_thread_id();
+    }
+#endif
+
+    const nest::synindex syn_id = nest::Connection<targetidentifierT>::get_syn_id();
+    const size_t num_threads = nest::kernel().vp_manager.get_num_threads();
+
+    for (size_t t = 0; t < num_threads; t++)
+    {
+        if (nest::kernel().model_manager.get_synapse_prototypes(t)[syn_id] == &cm)
+        {
+            return t;
+        }
+    }
+
+    return 0;
 }
 
 //
@@ -674,12 +1669,18 @@ void SynapticSamplingRewardGradientConnection<targetidentifierT>::set_status(con
  * @param t_last_spike the time of the last spike.
  * @param cp the synapse type common properties.
  */
-template <typename targetidentifierT>
-void SynapticSamplingRewardGradientConnection<targetidentifierT>::send(nest::Event& e,
-                                                                       nest::thread thread,
-                                                                       double t_last_spike,
-                                                                       const CommonPropertiesType& cp)
+template <typename targetidentifierT, typename priorT, typename storageT>
+void SynapticSamplingRewardGradientConnection<targetidentifierT, priorT, storageT>::send(nest::Event& e,
+                                                                               nest::thread thread,
+                                                                               double t_last_spike,
+                                                                               const CommonPropertiesType& cp)
 {
+    if (cp.learning_frozen_ && e.get_stamp().get_ms() > cp.learning_frozen_at_)
+    {
+        send_frozen(e, thread, t_last_spike, cp);
+        return;
+    }
+
     if (is_degenerated())
     {
         // synapse is waiting for the garbage collector.
@@ -691,12 +1692,20 @@ void SynapticSamplingRewardGradientConnection<targetidentifierT>::send(nest::Eve
     const long s_to = std::floor( e.get_stamp().get_ms() / cp.resolution_unit_ );
     long s_from = std::floor( t_last_spike / cp.resolution_unit_ );
 
+    if (s_from == 0 && s_to > 0)
+    {
+        update_synapic_weight(thread, 0, cp);
+    }
+
+    if (t_last_spike < cp.learning_resumed_)
+    {
+        // the synapse was frozen, skip the frozen period.
+        t_last_spike = cp.learning_resumed_;
+        s_from = std::floor( t_last_spike / cp.resolution_unit_ );
+    }
+
     if (s_to > s_from)
     {
-        if (s_from == 0)
-        {
-            update_synapic_weight(0, cp);
-        }
         // prepare the pointer to the target neuron. We can safely static_cast
         // since the connection is checked when established.
         TracingNode* target = static_cast<TracingNode*> (get_target(thread));
@@ -704,29 +1713,39 @@ void SynapticSamplingRewardGradientConnection<targetidentifierT>::send(nest::Eve
         TracingNode::const_iterator bap_trace =
                 target->get_trace(s_from, cp.bap_trace_id_);
 
-        TracingNode::const_iterator dopa_trace =
-                cp.reward_transmitter_->get_trace(s_from, cp.dopa_trace_id_);
-
-        const double t_last_weight_update =
-            std::floor(t_last_spike / cp.weight_update_interval_) * cp.weight_update_interval_;
-        const long s_last_update = std::floor( t_last_weight_update/cp.resolution_unit_ );
-
-        for (long next_weight_step = s_last_update + cp.weight_update_steps_;
-             next_weight_step <= s_to;
-             next_weight_step += cp.weight_update_steps_)
+        if (cp.reward_transmitter_->has_piecewise_constant_traces())
         {
-            update_synapse_state(next_weight_step, s_from, bap_trace, dopa_trace, cp);
-            update_synapic_parameter(thread, cp);
-            update_synapic_weight(next_weight_step, cp);
-            s_from = next_weight_step;
+            TracingNode::piecewise_const_iterator dopa_trace =
+                    cp.reward_transmitter_->get_piecewise_trace(s_from, cp.dopa_trace_id_, thread);
+            update_synapse(thread, s_from, s_to, t_last_spike, bap_trace, dopa_trace, cp);
         }
-
-        if (s_to > s_from)
+        else
         {
-            update_synapse_state(s_to, s_from, bap_trace, dopa_trace, cp);
+            TracingNode::const_iterator dopa_trace =
+                    cp.reward_transmitter_->get_trace(s_from, cp.dopa_trace_id_, thread);
+            update_synapse(thread, s_from, s_to, t_last_spike, bap_trace, dopa_trace, cp);
         }
     }
 
+    if (priorT::homogeneous && cp.dormant_retracted_synapses_ && (weight_ == 0.0))
+    {
+        // keep the synapse as dormant synapse and let the garbage collector
+        // remove its connection.
+        DormantSynapse synapse;
+        synapse.source_ = e.get_sender_gid();
+        synapse.target_ = get_target(thread)->get_gid();
+        synapse.synaptic_parameter_ = get_synaptic_parameter();
+        synapse.delay_ = get_delay_steps();
+        synapse.rport_ = get_rport();
+
+        psp_facilitation_ = -1.0;
+        nest::synindex syn_id = nest::Connection<targetidentifierT>::get_syn_id();
+        ConnectionUpdateManager::instance()->demote_synapse(synapse, s_to, thread, syn_id);
+        ConnectionUpdateManager::instance()->trigger_garbage_collector(synapse.target_, synapse.source_,
+                                                                       thread, syn_id);
+        return;
+    }
+
     if (cp.delete_retracted_synapses_ && (weight_==0.0))
     {
         // synapse prepares to be picked up by the garbage collector.
@@ -759,6 +1778,107 @@ void SynapticSamplingRewardGradientConnection<targetidentifierT>::send(nest::Eve
     }
 }
 
+/**
+ * Prefetch the BAP trace of the target at the time step from which the
+ * next call to send() will read it (see DiligentConnectorModel::update_schedule()).
+ *
+ * @param thread the id of the connections thread.
+ * @param t_last_spike the time of the last spike.
+ * @param cp the synapse type common properties.
+ */
+template <typename targetidentifierT, typename priorT, typename storageT>
+void SynapticSamplingRewardGradientConnection<targetidentifierT, priorT, storageT>::prefetch(nest::thread thread,
+                                                                                   double t_last_spike,
+                                                                                   const CommonPropertiesType& cp) const
+{
+    if (cp.resolution_unit_ > 0.0)
+    {
+        const long s_from = std::floor( std::max(t_last_spike, cp.learning_resumed_) / cp.resolution_unit_ );
+        static_cast<TracingNode*> (get_target(thread))->prefetch_trace(s_from, cp.bap_trace_id_);
+    }
+}
+
+/**
+ * Deliver a spike while learning is frozen. The synapse state is kept as
+ * it is and the spike is delivered with the current weight, as done by
+ * static synapses. Synapse update events are ignored.
+ *
+ * @param e the spike event.
+ * @param thread the id of the connections thread.
+ * @param t_last_spike the time of the last spike.
+ * @param cp the synapse type common properties.
+ */
+template <typename targetidentifierT, typename priorT, typename storageT>
+void SynapticSamplingRewardGradientConnection<targetidentifierT, priorT, storageT>::send_frozen(nest::Event& e,
+                                                                                      nest::thread thread,
+                                                                                      double t_last_spike,
+                                                                                      const CommonPropertiesType& cp)
+{
+    if (e.get_rport() < 0)
+    {
+        return;
+    }
+
+    if (t_last_spike == 0.0 && !is_degenerated())
+    {
+        // the weight of a new synapse is set on its first update.
+        update_synapic_weight(thread, 0, cp);
+    }
+
+    if (weight_ > 0.0)
+    {
+        e.set_weight(weight_);
+        e.set_delay(get_delay_steps());
+        e.set_receiver(*get_target(thread));
+        e.set_rport(get_rport());
+        e();
+    }
+}
+
+/**
+ * Advances the synapse from time step s_from to s_to. Synaptic parameters
+ * and weights are updated on the grid given by \a weight_update_interval.
+ * The iterators are expected to be positioned at s_from.
+ *
+ * @param thread the id of the connections thread.
+ * @param s_from time step of the last update.
+ * @param s_to time step to advance to.
+ * @param t_last_spike the time of the last spike.
+ * @param bap_trace iterator pointing to the current value of the BAP trace.
+ * @param dopa_trace iterator pointing to the current value of the dopamine trace.
+ * @param cp synapse type common properties.
+ */
+template <typename targetidentifierT, typename priorT, typename storageT>
+template <typename DopaIteratorT>
+void SynapticSamplingRewardGradientConnection<targetidentifierT, priorT, storageT>::update_synapse(nest::thread thread,
+                                                                                         long s_from,
+                                                                                         long s_to,
+                                                                                         double t_last_spike,
+                                                                                         TracingNode::const_iterator&
+                                                                                         bap_trace,
+                                                                                         DopaIteratorT& dopa_trace,
+                                                                                         const CommonPropertiesType& cp)
+{
+    const double t_last_weight_update =
+        std::floor(t_last_spike / cp.weight_update_interval_) * cp.weight_update_interval_;
+    const long s_last_update = std::floor( t_last_weight_update/cp.resolution_unit_ );
+
+    for (long next_weight_step = s_last_update + cp.weight_update_steps_;
+         next_weight_step <= s_to;
+         next_weight_step += cp.weight_update_steps_)
+    {
+        update_synapse_state(thread, next_weight_step, s_from, bap_trace, dopa_trace, cp);
+        update_synapic_parameter(thread, cp);
+        update_synapic_weight(thread, next_weight_step, cp);
+        s_from = next_weight_step;
+    }
+
+    if (s_to > s_from)
+    {
+        update_synapse_state(thread, s_to, s_from, bap_trace, dopa_trace, cp);
+    }
+}
+
 /**
  * Updates the state of the synapse to the given time point. This method
  * expects the back propagating action potential BAP trace of the postsynaptic
@@ -766,22 +1886,33 @@ void SynapticSamplingRewardGradientConnection<targetidentifierT>::send(nest::Eve
  * passed. Iterators are expected to be positioned at time t_last_update and
  * will be advanced to t_to after the call.
  *
- * This method implements equations (1-3).
+ * This method implements equations (1-3). If the PSP has decayed and the
+ * dopamine trace is piecewise constant, equations (2-3) and the direct
+ * gradient term of (4) are solved in closed form over the whole stretch of
+ * constant dopamine. With \f$a\f$ and \f$b\f$ the per-step decay factors
+ * of \f$e(t)\f$ and \f$g(t)\f$, \f$n\f$ steps at constant dopamine
+ * \f$d\f$ amount to
+ * \f[
+ *     e_n = a^n e_0 \;, \hspace{12px}
+ *     g_n = b^n g_0 + d\,e_0\,a\frac{b^n - a^n}{b - a} \;.
+ * \f]
  *
+ * @param thread the id of the connections thread.
  * @param t_to time to advance to.
  * @param t_last_update time of last update.
  * @param bap_trace iterator pointing to the current value of the BAP trace.
  * @param dopa_trace iterator pointing to the current value of the dopamine trace.
  * @param cp synapse type common properties.
  */
-template <typename targetidentifierT>
-void SynapticSamplingRewardGradientConnection<targetidentifierT>::update_synapse_state(long t_to,
-                                                                                       long t_last_update,
-                                                                                       TracingNode::const_iterator&
-                                                                                       bap_trace,
-                                                                                       TracingNode::const_iterator&
-                                                                                       dopa_trace,
-                                                                                       const CommonPropertiesType& cp)
+template <typename targetidentifierT, typename priorT, typename storageT>
+template <typename DopaIteratorT>
+void SynapticSamplingRewardGradientConnection<targetidentifierT, priorT, storageT>::update_synapse_state(
+        nest::thread thread,
+        long t_to,
+        long t_last_update,
+        TracingNode::const_iterator& bap_trace,
+        DopaIteratorT& dopa_trace,
+        const CommonPropertiesType& cp)
 {
     if ((weight_ == 0.0) && not cp.simulate_retracted_synapses_)
     {
@@ -796,15 +1927,60 @@ void SynapticSamplingRewardGradientConnection<targetidentifierT>::update_synapse
     const bool direct_gradient = cp.direct_gradient_rate_ > 0.0;
     bool psp_active = (psp_facilitation_ != 0.0);
 
+    double synaptic_parameter = get_synaptic_parameter();
+    double reward_gradient = get_reward_gradient();
+
     while( steps )
     {
+        if (not psp_active)
+        {
+            const long run = std::min(steps, dopa_trace.get_run_length());
+            if (run > 1)
+            {
+                // constant dopamine and no PSP: integrate the whole run at once
+                const double dopa = *dopa_trace;
+                const double a = cp.eligibility_trace_update_;
+                const double b = cp.reward_gradient_update_;
+                const double a_n = std::pow(a, run);
+                const double b_n = std::pow(b, run);
+
+                if (dopa != 0.0 && eligibility_trace_ != 0.0)
+                {
+                    const double sum_ba = (a == b) ? run * a_n : a * (b_n - a_n) / (b - a);
+                    reward_gradient = b_n * reward_gradient + dopa * eligibility_trace_ * sum_ba;
+
+                    if (direct_gradient)
+                    {
+                        // sum of a^k for k = 1..run, using expm1 to avoid cancellation
+                        // for a close to 1 and the limit run for a == 1.
+                        const double log_a = std::log(a);
+                        const double sum_a = (log_a == 0.0) ? run
+                                             : a * numerics::expm1(run * log_a) / numerics::expm1(log_a);
+                        synaptic_parameter += dopa * cp.learning_rate_ * cp.direct_gradient_rate_ *
+                                              eligibility_trace_ * sum_a;
+                    }
+                }
+                else
+                {
+                    reward_gradient *= b_n;
+                }
+
+                eligibility_trace_ *= a_n;
+
+                bap_trace.advance(run);
+                dopa_trace.advance(run);
+                steps -= run;
+                continue;
+            }
+        }
+
         // This loop will - considering every call - iterate through EVERY time step (in steps of resolution)
 
         // decay eligibility trace
         eligibility_trace_ *= cp.eligibility_trace_update_;
 
         // decay gradient variable
-        reward_gradient_ *= cp.reward_gradient_update_;
+        reward_gradient *= cp.reward_gradient_update_;
 
         // update postsynaptic spike potential
         if (psp_active)
@@ -822,18 +1998,24 @@ void SynapticSamplingRewardGradientConnection<targetidentifierT>::update_synapse
             }
         }
 
-        reward_gradient_ += (*dopa_trace) * eligibility_trace_;
+        reward_gradient += (*dopa_trace) * eligibility_trace_;
 
         if (direct_gradient)
         {
-            synaptic_parameter_ += (*dopa_trace) * cp.learning_rate_ *
-                                   cp.direct_gradient_rate_ * eligibility_trace_;
+            synaptic_parameter += (*dopa_trace) * cp.learning_rate_ *
+                                  cp.direct_gradient_rate_ * eligibility_trace_;
         }
 
         ++bap_trace;
         ++dopa_trace;
         --steps;
     }
+
+    storageT::update_stored_gradient(reward_gradient, thread, cp);
+    if (direct_gradient)
+    {
+        storageT::update_stored_parameter(synaptic_parameter, thread, cp);
+    }
 }
 
 /**
@@ -844,24 +2026,143 @@ void SynapticSamplingRewardGradientConnection<targetidentifierT>::update_synapse
  * @param thread the thread of the synapse.
  * @param cp the synapse type common properties.
  */
-template < typename targetidentifierT >
-void SynapticSamplingRewardGradientConnection< targetidentifierT >::
+template < typename targetidentifierT, typename priorT, typename storageT >
+void SynapticSamplingRewardGradientConnection< targetidentifierT, priorT, storageT >::
 update_synapic_parameter(nest::thread thread, const CommonPropertiesType& cp)
 {
     // update synaptic parameters
     const double l_rate = cp.weight_update_interval_ * cp.learning_rate_;
 
     // compute prior
-    const double prior = prior_precision_ * (prior_mean_ - synaptic_parameter_);
+    const double synaptic_parameter = get_synaptic_parameter();
+    const double prior = priorT::get_prior_precision(cp) * (priorT::get_prior_mean(cp) - synaptic_parameter);
 
-    reward_gradient_ += cp.get_gradient_noise(thread);
+    double reward_gradient = get_reward_gradient();
+    const double gradient_noise = cp.get_gradient_noise(thread);
+    if (gradient_noise != 0.0)
+    {
+        reward_gradient += gradient_noise;
+        storageT::update_stored_gradient(reward_gradient, thread, cp);
+    }
 
     const double d_lik = std::max(-cp.max_param_change_,
-                                  std::min(cp.max_param_change_, cp.gradient_scale_ * reward_gradient_));
+                                  std::min(cp.max_param_change_, cp.gradient_scale_ * reward_gradient));
 
     const double d_param = l_rate * (prior + d_lik) + cp.get_d_wiener(thread);
 
-    synaptic_parameter_ = std::max(cp.min_param_, std::min(cp.max_param_, synaptic_parameter_ + d_param));
+    storageT::update_stored_parameter(std::max(cp.min_param_, std::min(cp.max_param_, synaptic_parameter + d_param)),
+                                      thread, cp);
+}
+
+/**
+ * Advance the dormant synapses of \a pool to \a time and connect synapses
+ * whose synaptic parameter is not negative again (see
+ * ConnectionUpdateManager::update_dormant()).
+ *
+ * @param pool the dormant synapses of the synapse model on the thread.
+ * @param time the time point to advance to.
+ * @param thread the thread of the pool.
+ * @param syn_id the synapse model.
+ * @param cp the synapse type common properties.
+ */
+template < typename targetidentifierT, typename priorT, typename storageT >
+void SynapticSamplingRewardGradientConnection< targetidentifierT, priorT, storageT >::
+update_dormant(DormantPool& pool, const nest::Time& time, nest::thread thread, nest::synindex syn_id,
+               const CommonPropertiesType& cp)
+{
+    assert(cp.resolution_unit_ > 0.0);
+
+    const long s_to = std::floor( time.get_ms() / cp.resolution_unit_ );
+    const long s_resumed = std::floor( cp.learning_resumed_ / cp.resolution_unit_ );
+
+    for (size_t k = 0; k < pool.synapses_.size(); k++)
+    {
+        update_dormant_parameter(pool.synapses_[k].synaptic_parameter_, std::max(pool.step_, s_resumed), s_to,
+                                 thread, cp);
+    }
+
+    std::vector< std::pair< DormantSynapse, long > > pending;
+    pending.swap(pool.pending_);
+    for (size_t k = 0; k < pending.size(); k++)
+    {
+        update_dormant_parameter(pending[k].first.synaptic_parameter_, std::max(pending[k].second, s_resumed), s_to,
+                                 thread, cp);
+        pool.synapses_.push_back(pending[k].first);
+    }
+
+    pool.step_ = s_to;
+
+    // connecting synapses may demote others, which are added to the
+    // pending synapses of the pool.
+    size_t n = 0;
+    for (size_t k = 0; k < pool.synapses_.size(); k++)
+    {
+        const DormantSynapse synapse = pool.synapses_[k];
+        if (synapse.synaptic_parameter_ >= 0.0)
+        {
+            promote_dormant(synapse, thread, syn_id, cp);
+        }
+        else
+        {
+            pool.synapses_[n++] = synapse;
+        }
+    }
+    pool.synapses_.resize(n);
+}
+
+/**
+ * Apply equation (4) with \f$g(t) = 0\f$ to the synaptic parameter of a
+ * dormant synapse at all weight updates after \a s_from up to \a s_to.
+ *
+ * @param synaptic_parameter the synaptic parameter to update.
+ * @param s_from time step to which the parameter is up to date.
+ * @param s_to time step to advance to.
+ * @param thread the thread of the synapse.
+ * @param cp the synapse type common properties.
+ */
+template < typename targetidentifierT, typename priorT, typename storageT >
+void SynapticSamplingRewardGradientConnection< targetidentifierT, priorT, storageT >::
+update_dormant_parameter(double& synaptic_parameter, long s_from, long s_to, nest::thread thread,
+                         const CommonPropertiesType& cp)
+{
+    const double l_rate = cp.weight_update_interval_ * cp.learning_rate_;
+
+    for (long step = (s_from / cp.weight_update_steps_ + 1) * cp.weight_update_steps_;
+         step <= s_to;
+         step += cp.weight_update_steps_)
+    {
+        const double prior = cp.prior_precision_ * (cp.prior_mean_ - synaptic_parameter);
+        const double d_param = l_rate * prior + cp.get_d_wiener(thread);
+        synaptic_parameter = std::max(cp.min_param_, std::min(cp.max_param_, synaptic_parameter + d_param));
+    }
+}
+
+/**
+ * Connect a dormant synapse again, with its synaptic parameter and the
+ * weight that corresponds to it.
+ *
+ * @param synapse the dormant synapse.
+ * @param thread the thread of the target.
+ * @param syn_id the synapse model.
+ * @param cp the synapse type common properties.
+ */
+template < typename targetidentifierT, typename priorT, typename storageT >
+void SynapticSamplingRewardGradientConnection< targetidentifierT, priorT, storageT >::
+promote_dormant(const DormantSynapse& synapse, nest::thread thread, nest::synindex syn_id,
+                const CommonPropertiesType& cp)
+{
+    DictionaryDatum params(new Dictionary);
+    def<double>(params, names::synaptic_parameter, synapse.synaptic_parameter_);
+    def<double>(params, nest::names::weight,
+                cp.weight_scale_ * std::exp(synapse.synaptic_parameter_ - cp.parameter_mapping_offset_));
+    if (synapse.rport_ != 0)
+    {
+        def<long>(params, nest::names::receptor_type, synapse.rport_);
+    }
+
+    nest::Node* target = nest::kernel().node_manager.get_node(synapse.target_, thread);
+    nest::kernel().connection_manager.connect(synapse.source_, target, thread, syn_id, params,
+                                              nest::Time::delay_steps_to_ms(synapse.delay_));
 }
 
 /**
@@ -869,19 +2170,21 @@ update_synapic_parameter(nest::thread thread, const CommonPropertiesType& cp)
  *
  * This method implements equation (5).
  *
+ * @param thread the id of the connections thread.
  * @param time_step the current time step.
  * @param cp the synapse type common properties.
  */
-template < typename targetidentifierT >
-void SynapticSamplingRewardGradientConnection< targetidentifierT >::
-update_synapic_weight(long time_step, const CommonPropertiesType& cp)
+template < typename targetidentifierT, typename priorT, typename storageT >
+void SynapticSamplingRewardGradientConnection< targetidentifierT, priorT, storageT >::
+update_synapic_weight(nest::thread thread, long time_step, const CommonPropertiesType& cp)
 {
     const bool synapse_is_active = (weight_ != 0.0) || (time_step==0);
 
     // update synaptic weight
-    if (synaptic_parameter_ >= 0.0)
+    const double synaptic_parameter = get_synaptic_parameter();
+    if (synaptic_parameter >= 0.0)
     {
-        weight_ = cp.weight_scale_ * std::exp(synaptic_parameter_ - cp.parameter_mapping_offset_);
+        weight_ = cp.weight_scale_ * std::exp(synaptic_parameter - cp.parameter_mapping_offset_);
     }
     else
     {
@@ -894,10 +2197,17 @@ update_synapic_weight(long time_step, const CommonPropertiesType& cp)
         psp_facilitation_ = 0.0;
         psp_depression_ = 0.0;
         eligibility_trace_ = 0.0;
-        reward_gradient_ = 0.0;
+        storageT::set_stored_gradient(0.0);
     }
 
-    logger()->record(time_step*cp.resolution_unit_, *this, recorder_port_);
+    logger()->record(time_step*cp.resolution_unit_, *this, RecorderPortStorage::get_recorder_port(thread), thread);
+
+    if (cp.aggregate_steps_ > 0 && (time_step % cp.aggregate_steps_) == 0)
+    {
+        logger()->aggregate(time_step*cp.resolution_unit_, *this, (weight_ == 0.0),
+                            nest::Connection<targetidentifierT>::get_syn_id(), thread,
+                            cp.aggregate_bins_, cp.aggregate_ranges_);
+    }
 }
 
 }
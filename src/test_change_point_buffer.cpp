@@ -0,0 +1,115 @@
+/*
+ * This file is part of SPORE.
+ *
+ * Copyright (C) 2016, the SPORE team (see AUTHORS).
+ *
+ * SPORE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * SPORE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SPORE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * For more information see: https://github.com/IGITUGraz/spore-nest-module
+ *
+ * File:   test_change_point_buffer.cpp
+ * Author: Kappel
+ *
+ * Created on October 18, 2026
+ */
+
+#include "test_change_point_buffer.h"
+
+#include <vector>
+
+#include "change_point_buffer.h"
+
+namespace spore
+{
+
+/**
+ * Constructor.
+ */
+TestChangePointBuffer::TestChangePointBuffer()
+: SporeTestBase("test_change_point_buffer")
+{
+}
+
+/**
+ * Execute once at startup.
+ */
+void TestChangePointBuffer::init()
+{
+    // reference trace with runs of different lengths
+    std::vector<double> dense(60, 0.0);
+    for (size_t i = 5; i < 60; i++)
+        dense[i] = (i < 12) ? 1.0 : (i < 13) ? 2.0 : (i < 30) ? -1.0 : (i < 31) ? 0.5 : 3.0;
+
+    ChangePointBuffer<double> cb;
+
+    cb.resize(20, 0.0);
+
+    test_assert(cb.size() == 1, "ChangePointBuffer test size 0");
+    test_assert(cb.capacity() == 20, "ChangePointBuffer test capacity 0");
+    test_assert(*cb.get(-100) == 0.0, "ChangePointBuffer test initial value");
+
+    for (size_t i = 0; i < dense.size(); i++)
+        cb.set(i, dense[i]);
+
+    test_assert(cb.size() == 6, "ChangePointBuffer test size 1");
+
+    // forward iteration
+    ChangePointBuffer<double>::const_iterator it = cb.get(0);
+    for (size_t i = 0; i < dense.size(); i++, ++it)
+        test_assert(*it == dense[i], "ChangePointBuffer test content 0");
+
+    // backward iteration
+    ChangePointBuffer<double>::const_iterator it2 = cb.get(dense.size() - 1);
+    for (long i = dense.size() - 1; i >= 0; i--, --it2)
+        test_assert(*it2 == dense[i], "ChangePointBuffer test content 1");
+
+    // random access
+    for (size_t i = 0; i < dense.size(); i++)
+        test_assert(*cb.get(i) == dense[i], "ChangePointBuffer test content 2");
+
+    // run lengths and advance
+    ChangePointBuffer<double>::const_iterator it3 = cb.get(7);
+    test_assert(it3.get_run_length() == 5, "ChangePointBuffer test run length 0");
+    it3.advance(it3.get_run_length());
+    test_assert(*it3 == 2.0, "ChangePointBuffer test advance 0");
+    test_assert(it3.get_run_length() == 1, "ChangePointBuffer test run length 1");
+    it3.advance(20);
+    test_assert(*it3 == 3.0, "ChangePointBuffer test advance 1");
+    test_assert(it3.get_run_length() > 1000, "ChangePointBuffer test run length 2");
+
+    // overwriting the most recent step does not create a new run
+    cb.set(59, 4.0);
+    test_assert(cb.size() == 7, "ChangePointBuffer test size 2");
+    cb.set(59, 5.0);
+    test_assert(cb.size() == 7, "ChangePointBuffer test size 3");
+    test_assert(*cb.get(59) == 5.0 && *cb.get(58) == 3.0, "ChangePointBuffer test content 3");
+
+    // runs wrap around at the capacity of the buffer
+    for (long i = 60; i < 100; i++)
+        cb.set(i, double(i));
+
+    test_assert(cb.size() == 20, "ChangePointBuffer test size 4");
+
+    ChangePointBuffer<double>::const_iterator it4 = cb.get(81);
+    for (long i = 81; i < 100; i++, ++it4)
+        test_assert(*it4 == double(i), "ChangePointBuffer test content 4");
+
+    ChangePointBuffer<double> cb_copy(cb);
+    test_assert(*cb_copy.get(90) == 90.0, "ChangePointBuffer test copy");
+
+    cb.clear(-2.0);
+    test_assert(cb.size() == 1 && *cb.get(90) == -2.0, "ChangePointBuffer test clear");
+}
+
+}
@@ -0,0 +1,88 @@
+/*
+ * This file is part of SPORE.
+ *
+ * Copyright (C) 2016, the SPORE team (see AUTHORS).
+ *
+ * SPORE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * SPORE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SPORE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * For more information see: https://github.com/IGITUGraz/spore-nest-module
+ *
+ * File:   test_segmented_vector.cpp
+ * Author: Kappel
+ *
+ * Created on October 18, 2026
+ */
+
+
+#include "test_segmented_vector.h"
+
+#include <vector>
+#include <algorithm>
+
+#include "segmented_vector.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace spore
+{
+
+/**
+ * Constructor.
+ */
+TestSegmentedVector::TestSegmentedVector()
+: SporeTestBase("test_segmented_vector")
+{
+}
+
+/**
+ * Execute once at startup.
+ */
+void TestSegmentedVector::init()
+{
+    SegmentedVector<long> sv;
+
+    test_assert(sv.size() == 0, "SegmentedVector test size 0");
+
+    for (long i = 0; i < 1000; i++)
+        test_assert(sv.push_back(i) == size_t(i), "SegmentedVector test index 0");
+
+    test_assert(sv.size() == 1000, "SegmentedVector test size 1");
+
+    for (long i = 0; i < 1000; i++)
+        test_assert(sv[i] == i, "SegmentedVector test content 0");
+
+    sv.clear();
+    test_assert(sv.size() == 0, "SegmentedVector test size 2");
+
+    // concurrent appends must hand out every index exactly once
+    const long n = 100000;
+    std::vector<size_t> indices(n);
+
+#pragma omp parallel for num_threads(4)
+    for (long i = 0; i < n; i++)
+        indices[i] = sv.push_back(i);
+
+    test_assert(sv.size() == size_t(n), "SegmentedVector test size 3");
+
+    for (long i = 0; i < n; i++)
+        test_assert(sv[indices[i]] == i, "SegmentedVector test content 1");
+
+    std::sort(indices.begin(), indices.end());
+    for (long i = 0; i < n; i++)
+        test_assert(indices[i] == size_t(i), "SegmentedVector test index 1");
+}
+
+}
@@ -0,0 +1,47 @@
+/*
+ * This file is part of SPORE.
+ *
+ * Copyright (C) 2016, the SPORE team (see AUTHORS).
+ *
+ * SPORE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * SPORE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SPORE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * For more information see: https://github.com/IGITUGraz/spore-nest-module
+ *
+ * File:   test_segmented_vector.h
+ * Author: Kappel
+ *
+ * Created on October 18, 2026
+ */
+
+#ifndef TEST_SEGMENTED_VECTOR_H
+#define TEST_SEGMENTED_VECTOR_H
+
+#include "spore_test_base.h"
+
+namespace spore
+{
+
+/**
+ * @brief Test class for the SegmentedVector container.
+ */
+class TestSegmentedVector : public SporeTestBase
+{
+public:
+    TestSegmentedVector();
+    virtual void init();
+};
+
+}
+
+#endif
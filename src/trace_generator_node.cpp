@@ -0,0 +1,329 @@
+/*
+ * This file is part of SPORE.
+ *
+ * Copyright (C) 2016, the SPORE team (see AUTHORS).
+ *
+ * SPORE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * SPORE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SPORE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * For more information see: https://github.com/IGITUGraz/spore-nest-module
+ *
+ * File:   trace_generator_node.cpp
+ * Author: Kappel
+ *
+ * Created on October 18, 2026
+ */
+
+
+#include "trace_generator_node.h"
+
+#include "exceptions.h"
+#include "dict.h"
+#include "integerdatum.h"
+#include "doubledatum.h"
+#include "arraydatum.h"
+#include "dictutils.h"
+#include "kernel_manager.h"
+
+#include "spore_names.h"
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+
+namespace spore
+{
+
+/* ----------------------------------------------------------------
+ * Default constructors defining default parameters and state
+ * ---------------------------------------------------------------- */
+
+TraceGeneratorNode::Parameters_::Parameters_()
+: signal_(SIGNAL_CONSTANT)
+, n_channels_(1)
+, mean_(0.0)
+, amplitude_(1.0)
+, rate_(10.0)
+, pulse_duration_(1.0)
+, tau_(100.0)
+, sigma_(1.0)
+, piecewise_constant_(false)
+, replicate_traces_(false)
+{
+}
+
+TraceGeneratorNode::State_::State_()
+: schedule_index_(0)
+{
+}
+
+/* ----------------------------------------------------------------
+ * Parameter extraction and manipulation functions
+ * ---------------------------------------------------------------- */
+
+void TraceGeneratorNode::Parameters_::get(DictionaryDatum& d) const
+{
+    const char* signal_names[] = { "constant", "poisson", "ornstein_uhlenbeck", "schedule" };
+
+    (*d)[ names::signal ] = std::string(signal_names[signal_]);
+    (*d)[ names::n_channels ] = n_channels_;
+    (*d)[ names::mean ] = mean_;
+    (*d)[ names::amplitude ] = amplitude_;
+    (*d)[ names::rate ] = rate_;
+    (*d)[ names::pulse_duration ] = pulse_duration_;
+    (*d)[ names::tau ] = tau_;
+    (*d)[ names::sigma ] = sigma_;
+    (*d)[ names::schedule_times ] = schedule_times_;
+    (*d)[ names::schedule_values ] = schedule_values_;
+    (*d)[ names::piecewise_constant ] = piecewise_constant_;
+    (*d)[ names::replicate_traces ] = replicate_traces_;
+}
+
+void TraceGeneratorNode::Parameters_::set(const DictionaryDatum& d)
+{
+    std::string signal;
+    if (updateValue< std::string >(d, names::signal, signal))
+    {
+        if (signal == "constant")
+            signal_ = SIGNAL_CONSTANT;
+        else if (signal == "poisson")
+            signal_ = SIGNAL_POISSON;
+        else if (signal == "ornstein_uhlenbeck")
+            signal_ = SIGNAL_ORNSTEIN_UHLENBECK;
+        else if (signal == "schedule")
+            signal_ = SIGNAL_SCHEDULE;
+        else
+            throw nest::BadProperty("trace_generator_node: signal must be 'constant', 'poisson', "
+                                    "'ornstein_uhlenbeck' or 'schedule'.");
+    }
+
+    updateValue< long >(d, names::n_channels, n_channels_);
+    updateValue< double >(d, names::mean, mean_);
+    updateValue< double >(d, names::amplitude, amplitude_);
+    updateValue< double >(d, names::rate, rate_);
+    updateValue< double >(d, names::pulse_duration, pulse_duration_);
+    updateValue< double >(d, names::tau, tau_);
+    updateValue< double >(d, names::sigma, sigma_);
+    updateValue< std::vector< double > >(d, names::schedule_times, schedule_times_);
+    updateValue< std::vector< double > >(d, names::schedule_values, schedule_values_);
+    updateValue< bool >(d, names::piecewise_constant, piecewise_constant_);
+    updateValue< bool >(d, names::replicate_traces, replicate_traces_);
+
+    if (n_channels_ < 1)
+    {
+        throw nest::BadProperty("trace_generator_node: n_channels must be larger than 0.");
+    }
+
+    if (rate_ < 0.0)
+    {
+        throw nest::BadProperty("trace_generator_node: rate must be positive.");
+    }
+
+    if (pulse_duration_ <= 0.0)
+    {
+        throw nest::BadProperty("trace_generator_node: pulse_duration must be larger than 0.");
+    }
+
+    if (tau_ <= 0.0)
+    {
+        throw nest::BadProperty("trace_generator_node: tau must be larger than 0.");
+    }
+
+    if (sigma_ < 0.0)
+    {
+        throw nest::BadProperty("trace_generator_node: sigma must be positive.");
+    }
+
+    if (schedule_times_.size() != schedule_values_.size())
+    {
+        throw nest::BadProperty("trace_generator_node: schedule_times and schedule_values must have the same size.");
+    }
+
+    for (size_t i = 1; i < schedule_times_.size(); i++)
+    {
+        if (schedule_times_[i] < schedule_times_[i - 1])
+        {
+            throw nest::BadProperty("trace_generator_node: schedule_times must be sorted in ascending order.");
+        }
+    }
+}
+
+/* ----------------------------------------------------------------
+ * Default and copy constructor for node
+ * ---------------------------------------------------------------- */
+
+TraceGeneratorNode::TraceGeneratorNode()
+: TracingNode()
+, P_()
+, S_()
+{
+}
+
+TraceGeneratorNode::TraceGeneratorNode(const TraceGeneratorNode& n)
+: TracingNode(n)
+, P_(n.P_)
+, S_(n.S_)
+{
+}
+
+/* ----------------------------------------------------------------
+ * Node initialization functions
+ * ---------------------------------------------------------------- */
+
+void TraceGeneratorNode::init_state_(const Node& n)
+{
+    const TraceGeneratorNode& pr = downcast< TraceGeneratorNode >(n);
+    S_ = pr.S_;
+}
+
+void TraceGeneratorNode::init_buffers_()
+{
+}
+
+void TraceGeneratorNode::calibrate()
+{
+    const double h = nest::Time::get_resolution().get_ms();
+    const long now = nest::kernel().simulation_manager.get_time().get_steps();
+    const size_t n_channels = P_.n_channels_;
+    const bool initialized = (S_.value_.size() == n_channels);
+    const double pulse_interval = (P_.rate_ > 0.0) ? 1000.0 / (P_.rate_ * h) : std::numeric_limits<double>::infinity();
+
+    V_.rng_ = nest::kernel().rng_manager.get_rng(get_thread());
+    V_.pulse_steps_ = std::max(1L, nest::Time(nest::Time::ms(P_.pulse_duration_)).get_steps());
+    V_.ou_decay_ = std::exp(-h / P_.tau_);
+    V_.ou_noise_ = P_.sigma_ * std::sqrt(1.0 - V_.ou_decay_ * V_.ou_decay_);
+
+    V_.schedule_steps_.resize(P_.schedule_times_.size());
+    for (size_t i = 0; i < P_.schedule_times_.size(); i++)
+    {
+        V_.schedule_steps_[i] = nest::Time(nest::Time::ms(P_.schedule_times_[i])).get_steps();
+    }
+
+    // the schedule may have changed since the last simulation, skip the
+    // entries that lie in the past, update() advances to the current one.
+    S_.schedule_index_ = std::lower_bound(V_.schedule_steps_.begin(), V_.schedule_steps_.end(), now) -
+                         V_.schedule_steps_.begin();
+
+    // traces and signal states are only set up once
+    if (!initialized)
+    {
+        init_traces(n_channels, P_.piecewise_constant_, P_.replicate_traces_);
+        S_.value_.assign(n_channels, std::numeric_limits<double>::quiet_NaN());
+        S_.ou_state_.assign(n_channels, P_.mean_);
+        S_.pulse_end_.assign(n_channels, 0);
+        S_.next_pulse_.resize(n_channels);
+    }
+
+    // the pulse process is memoryless, so pulses are drawn anew from the
+    // current time step if the rate changed, e.g. from a rate of 0.
+    if (!initialized || pulse_interval != V_.pulse_interval_)
+    {
+        for (size_t i = 0; i < n_channels; i++)
+        {
+            S_.next_pulse_[i] = now + pulse_interval * V_.exp_dev_(V_.rng_);
+        }
+    }
+    V_.pulse_interval_ = pulse_interval;
+}
+
+void TraceGeneratorNode::get_status(DictionaryDatum& d) const
+{
+    TracingNode::get_trace_status(d);
+
+    P_.get(d);
+
+    (*d)[nest::names::element_type] = LiteralDatum(nest::names::other);
+}
+
+void TraceGeneratorNode::set_status(const DictionaryDatum& d)
+{
+    Parameters_ ptmp = P_; // temporary copy in case of errors
+    ptmp.set(d); // throws if BadProperty
+
+    if (!S_.value_.empty() &&
+        (ptmp.n_channels_ != P_.n_channels_ ||
+         ptmp.piecewise_constant_ != P_.piecewise_constant_ ||
+         ptmp.replicate_traces_ != P_.replicate_traces_))
+    {
+        throw nest::BadProperty("trace_generator_node: n_channels, piecewise_constant and replicate_traces can "
+                                "not be changed after simulation startup.");
+    }
+
+    P_ = ptmp;
+}
+
+/**
+ * Advance the signal of the given channel to time step \a step.
+ *
+ * @param step the current time step.
+ * @param channel the channel.
+ * @param schedule_value the value of the schedule at the current time step.
+ * @return the value of the signal.
+ */
+inline
+double TraceGeneratorNode::next_value(long step, size_t channel, double schedule_value)
+{
+    switch (P_.signal_)
+    {
+    case SIGNAL_POISSON:
+    {
+        // pulses that start within the same time step merge
+        while (S_.next_pulse_[channel] <= step)
+        {
+            S_.pulse_end_[channel] = std::max(S_.pulse_end_[channel], step + V_.pulse_steps_);
+            S_.next_pulse_[channel] += V_.pulse_interval_ * V_.exp_dev_(V_.rng_);
+        }
+        return (step < S_.pulse_end_[channel]) ? P_.mean_ + P_.amplitude_ : P_.mean_;
+    }
+    case SIGNAL_ORNSTEIN_UHLENBECK:
+    {
+        double& x = S_.ou_state_[channel];
+        x = P_.mean_ + V_.ou_decay_ * (x - P_.mean_) + V_.ou_noise_ * V_.normal_dev_(V_.rng_);
+        return x;
+    }
+    case SIGNAL_SCHEDULE:
+        return schedule_value;
+    default:
+        return P_.mean_;
+    }
+}
+
+void TraceGeneratorNode::update(const nest::Time& origin, const long from, const long to)
+{
+    for (long lag = from; lag < to; ++lag)
+    {
+        const long step = origin.get_steps() + lag;
+
+        while (S_.schedule_index_ < V_.schedule_steps_.size() && V_.schedule_steps_[S_.schedule_index_] <= step)
+        {
+            S_.schedule_index_++;
+        }
+        const double schedule_value = (S_.schedule_index_ > 0) ? P_.schedule_values_[S_.schedule_index_ - 1]
+                                                               : P_.mean_;
+
+        for (size_t channel = 0; channel < S_.value_.size(); channel++)
+        {
+            const double value = next_value(step, channel, schedule_value);
+
+            // piecewise constant traces are only written when the value changes
+            if (!P_.piecewise_constant_ || value != S_.value_[channel])
+            {
+                set_trace(step, value, channel);
+                S_.value_[channel] = value;
+            }
+        }
+    }
+}
+
+}
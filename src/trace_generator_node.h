@@ -0,0 +1,202 @@
+/*
+ * This file is part of SPORE.
+ *
+ * Copyright (C) 2016, the SPORE team (see AUTHORS).
+ *
+ * SPORE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * SPORE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SPORE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * For more information see: https://github.com/IGITUGraz/spore-nest-module
+ *
+ * File:   trace_generator_node.h
+ * Author: Kappel
+ *
+ * Created on October 18, 2026
+ */
+
+#ifndef TRACE_GENERATOR_NODE_H
+#define TRACE_GENERATOR_NODE_H
+
+#include <vector>
+
+#include "nest.h"
+#include "event.h"
+#include "normal_randomdev.h"
+#include "exp_randomdev.h"
+
+#include "tracing_node.h"
+
+namespace spore
+{
+
+/**
+ * @brief A node that generates synthetic traces.
+ *
+ * This node provides traces without external processes, e.g. as reward
+ * signal for benchmarks and load tests of synapse models (using the
+ * \a reward_transmitter parameter of the synapse model). Like the reward
+ * proxies, the node exists once per process. Every channel records one
+ * trace. The cost of every time step is constant. The \a signal parameter
+ * selects one of the following signals \f$x(t)\f$:
+ *
+ * - "constant": \f$x(t) = \mu\f$, where \f$\mu\f$ is given by \a mean.
+ * - "poisson": rectangular pulses of height \a amplitude on top of
+ *   \f$\mu\f$. Pulses start at the events of a Poisson process with the
+ *   given \a rate and last for \a pulse_duration. Overlapping pulses merge.
+ * - "ornstein_uhlenbeck": an Ornstein-Uhlenbeck process with mean
+ *   \f$\mu\f$, time constant \a tau and stationary standard deviation
+ *   \a sigma, which is updated exactly on the time grid and starts at
+ *   \f$\mu\f$.
+ * - "schedule": the piecewise constant signal that takes the value
+ *   \a schedule_values[i] from time \a schedule_times[i] on, and \f$\mu\f$
+ *   before the first time.
+ *
+ * The random signals of different channels are independent. Random numbers
+ * are drawn from the random number generator of the thread of the node.
+ * If \a piecewise_constant is set, traces are stored as piecewise constant
+ * traces (see TracingNode::get_piecewise_trace()) and only written when the
+ * signal changes, which is recommended for all signals except
+ * "ornstein_uhlenbeck". If \a replicate_traces is set, connections on other
+ * threads read from thread-local replicas of the traces (see TracingNode).
+ *
+ * <b>Parameters</b>
+ *
+ * <table>
+ * <tr><th>name</th>                 <th>type</th>     <th>comment</th></tr>
+ * <tr><td>\a signal</td>            <td>string</td>   <td>"constant", "poisson", "ornstein_uhlenbeck" or
+ *                                                        "schedule" ("constant")</td></tr>
+ * <tr><td>\a n_channels</td>        <td>int</td>      <td>number of traces (1, &gt; 0)</td></tr>
+ * <tr><td>\a mean</td>              <td>double</td>   <td>constant value, baseline or mean {\f$\mu\f$}
+ *                                                        (0.0)</td></tr>
+ * <tr><td>\a amplitude</td>         <td>double</td>   <td>height of pulses (1.0)</td></tr>
+ * <tr><td>\a rate</td>              <td>double</td>   <td>rate of pulses (10.0, &ge;0.0) [Hz]</td></tr>
+ * <tr><td>\a pulse_duration</td>    <td>double</td>   <td>duration of pulses (1.0, &gt;0.0) [ms]</td></tr>
+ * <tr><td>\a tau</td>               <td>double</td>   <td>time constant of the Ornstein-Uhlenbeck process
+ *                                                        (100.0, &gt;0.0) [ms]</td></tr>
+ * <tr><td>\a sigma</td>             <td>double</td>   <td>stationary standard deviation of the
+ *                                                        Ornstein-Uhlenbeck process (1.0, &ge;0.0)</td></tr>
+ * <tr><td>\a schedule_times</td>    <td>[double]</td> <td>ascending times of the schedule ([]) [ms]</td></tr>
+ * <tr><td>\a schedule_values</td>   <td>[double]</td> <td>values of the schedule, one per time ([])</td></tr>
+ * <tr><td>\a piecewise_constant</td> <td>bool</td>    <td>store traces as runs of constant values
+ *                                                        (false)</td></tr>
+ * <tr><td>\a replicate_traces</td>  <td>bool</td>     <td>keep a thread-local replica of the traces
+ *                                                        for every thread (false)</td></tr>
+ * </table>
+ *
+ * The number of channels, \a piecewise_constant and \a replicate_traces can
+ * not be changed after simulation startup.
+ *
+ * @see RewardShmProxy, RewardFilterNode, SynapticSamplingRewardGradientConnection
+ */
+class TraceGeneratorNode : public TracingNode
+{
+public:
+
+    TraceGeneratorNode();
+    TraceGeneratorNode(const TraceGeneratorNode& n);
+
+    bool has_proxies() const
+    {
+        return false;
+    }
+
+    bool one_node_per_process() const
+    {
+        return true;
+    }
+
+    virtual void get_status(DictionaryDatum& d) const;
+    virtual void set_status(const DictionaryDatum& d);
+
+protected:
+
+    virtual void init_buffers_();
+    virtual void init_state_(const Node&);
+
+    virtual void calibrate();
+
+    virtual void update(nest::Time const&, const long, const long);
+
+    // ------------------------------------------------------------
+
+    enum Signal
+    {
+        SIGNAL_CONSTANT = 0,
+        SIGNAL_POISSON,
+        SIGNAL_ORNSTEIN_UHLENBECK,
+        SIGNAL_SCHEDULE
+    };
+
+    /**
+     * @brief Class holding parameter variables of the node.
+     */
+    struct Parameters_
+    {
+        Parameters_(); //!< Sets default parameter values
+
+        void get(DictionaryDatum&) const; //!< Store current values in dictionary
+        void set(const DictionaryDatum&); //!< Set values from dicitonary
+
+        Signal signal_; //!< the type of the generated signal
+        long n_channels_; //!< the number of traces
+        double mean_; //!< constant value, baseline or mean of the signal
+        double amplitude_; //!< height of pulses
+        double rate_; //!< rate of pulses in Hz
+        double pulse_duration_; //!< duration of pulses in ms
+        double tau_; //!< time constant of the Ornstein-Uhlenbeck process in ms
+        double sigma_; //!< stationary standard deviation of the Ornstein-Uhlenbeck process
+        std::vector< double > schedule_times_; //!< times of the schedule in ms
+        std::vector< double > schedule_values_; //!< values of the schedule
+        bool piecewise_constant_; //!< store traces as runs of constant values
+        bool replicate_traces_; //!< keep a replica of the traces for every thread
+    };
+
+    /**
+     * @brief Class holding state variables of the node.
+     */
+    struct State_
+    {
+        State_(); //!< Sets default state value
+
+        std::vector< double > value_; //!< last value written to the trace of each channel
+        std::vector< double > ou_state_; //!< state of the Ornstein-Uhlenbeck process of each channel
+        std::vector< double > next_pulse_; //!< time step of the next pulse of each channel
+        std::vector< long > pulse_end_; //!< time step at which the current pulse of each channel ends
+        size_t schedule_index_; //!< index of the next entry of the schedule
+    };
+
+    /**
+     * @brief Class holding internal variables of the node.
+     */
+    struct Variables_
+    {
+        librandom::RngPtr rng_; //!< random number generator of my own thread
+        librandom::NormalRandomDev normal_dev_; //!< random deviate generator
+        librandom::ExpRandomDev exp_dev_; //!< random deviate generator
+        double pulse_interval_; //!< mean interval between pulses in steps
+        long pulse_steps_; //!< duration of pulses in steps
+        double ou_decay_; //!< decay factor of the Ornstein-Uhlenbeck process per time step
+        double ou_noise_; //!< standard deviation of the noise per time step
+        std::vector< long > schedule_steps_; //!< times of the schedule in steps
+    };
+
+    double next_value(long step, size_t channel, double schedule_value);
+
+    Parameters_ P_;
+    State_ S_;
+    Variables_ V_;
+};
+
+}
+
+#endif
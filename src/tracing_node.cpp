@@ -31,6 +31,9 @@
 #include "kernel_manager.h"
 #include "arraydatum.h"
 
+#include <algorithm>
+#include <limits>
+
 
 namespace spore
 {
@@ -39,7 +42,19 @@ namespace spore
  * Constructor.
  */
 TracingNode::TracingNode()
-: nest::Node()
+: nest::Node(),
+piecewise_constant_(false)
+{
+}
+
+/**
+ * Copy constructor. Replicas are not copied.
+ */
+TracingNode::TracingNode(const TracingNode& n)
+: nest::Node(n),
+traces_(n.traces_),
+piecewise_traces_(n.piecewise_traces_),
+piecewise_constant_(n.piecewise_constant_)
 {
 }
 
@@ -48,20 +63,126 @@ TracingNode::TracingNode()
  */
 TracingNode::~TracingNode()
 {
+    clear_replicas();
 }
 
 /**
- * Constructor.
+ * Constructor of the trace replica.
  */
-void TracingNode::init_traces(size_t num_traces)
+TracingNode::TraceReplica::TraceReplica()
+: synced_step_(std::numeric_limits<long>::min())
+{
+}
+
+/**
+ * Initialize the traces of the node.
+ *
+ * @param num_traces the number of traces.
+ * @param piecewise_constant store traces as runs of constant values.
+ * @param replicate keep a replica of the traces for every thread.
+ */
+void TracingNode::init_traces(size_t num_traces, bool piecewise_constant, bool replicate)
 {
-    traces_.resize(num_traces);
     const size_t trace_length = ConnectionUpdateManager::instance()->get_max_latency();
+    piecewise_constant_ = piecewise_constant;
+
+    clear_replicas();
+    if (replicate)
+    {
+        // replicas are allocated by the reading threads on first access
+        replicas_.resize(nest::kernel().vp_manager.get_num_threads(), 0);
+    }
+
+    if (piecewise_constant)
+    {
+        // every run covers at least one step, so trace_length runs are
+        // enough to cover the whole trace window.
+        traces_.clear();
+        piecewise_traces_.resize(num_traces);
+        for (size_t i = 0; i < num_traces; i++)
+        {
+            piecewise_traces_[i].resize(trace_length, 0.0);
+        }
+    }
+    else
+    {
+        piecewise_traces_.clear();
+        traces_.resize(num_traces);
+        for (size_t i = 0; i < num_traces; i++)
+        {
+            traces_[i].resize(trace_length, 0.0);
+        }
+    }
+}
+
+/**
+ * Delete all replicas.
+ */
+void TracingNode::clear_replicas()
+{
+    for (size_t i = 0; i < replicas_.size(); i++)
+    {
+        delete replicas_[i];
+    }
+    replicas_.clear();
+}
+
+/**
+ * Pull all values of the traces that are older than the current slice
+ * origin into the replica of the given thread. Values in this range are not
+ * written anymore, so it is safe to read them while the owner of the node
+ * updates the current slice. The replica is allocated on first access, such
+ * that its memory is local to the reading thread.
+ *
+ * @param thread the thread of the replica.
+ * @return the synchronized replica.
+ */
+TracingNode::TraceReplica* TracingNode::sync_replica(nest::thread thread) const
+{
+    const long trace_length = ConnectionUpdateManager::instance()->get_max_latency();
+    const long origin = ConnectionUpdateManager::instance()->get_origin().get_steps();
+
+    TraceReplica* replica = replicas_[thread];
+    if (replica == 0)
+    {
+        replica = new TraceReplica();
+        replica->traces_.resize(traces_.size());
+        for (size_t i = 0; i < traces_.size(); i++)
+        {
+            replica->traces_[i].resize(trace_length, 0.0);
+        }
+        replica->piecewise_traces_.resize(piecewise_traces_.size());
+        for (size_t i = 0; i < piecewise_traces_.size(); i++)
+        {
+            replica->piecewise_traces_[i].resize(trace_length, 0.0);
+        }
+        replicas_[thread] = replica;
+    }
 
-    for (size_t i = 0; i < num_traces; i++)
+    const long from = std::max(replica->synced_step_, origin - trace_length);
+
+    for (size_t i = 0; i < traces_.size(); i++)
+    {
+        for (long step = std::max(from, 0L); step < origin; step++)
+        {
+            replica->traces_[i][step] = *traces_[i].get(step);
+        }
+    }
+
+    for (size_t i = 0; i < piecewise_traces_.size(); i++)
     {
-        traces_[i].resize(trace_length, 0.0);
+        piecewise_const_iterator it = piecewise_traces_[i].get(from);
+        for (long step = from; step < origin;)
+        {
+            replica->piecewise_traces_[i].set(step, *it);
+            const long run = std::min(it.get_run_length(), origin - step);
+            it.advance(run);
+            step += run;
+        }
     }
+
+    replica->synced_step_ = origin;
+    return replica;
 }
 
 /**
@@ -78,6 +199,138 @@ void TracingNode::get_status(DictionaryDatum& d) const
 {
 }
 
+/**
+ * Copy \a length values of a trace starting at the position of iterator
+ * \a it into \a trace.
+ */
+template < typename IteratorT >
+static void read_trace(IteratorT it, size_t length, double* trace)
+{
+    for (size_t i = 0; i < length; i++)
+    {
+        trace[i] = *it;
+        ++it; // back to the future
+    }
+}
+
+/**
+ * Copy \a length values of trace \a id, starting at time step \a steps,
+ * into the buffer \a trace. The same limits as for get_trace() apply.
+ *
+ * @param id the index of the trace.
+ * @param steps the first time point to be read.
+ * @param length number of values to copy.
+ * @param trace buffer of at least \a length values.
+ */
+void TracingNode::copy_trace(trace_id id, nest::delay steps, size_t length, double* trace) const
+{
+    if (piecewise_constant_)
+    {
+        read_trace(get_piecewise_trace(steps, id), length, trace);
+    }
+    else
+    {
+        read_trace(get_trace(steps, id), length, trace);
+    }
+}
+
+/**
+ * Overwrite \a length values of trace \a id, starting at time step
+ * \a steps, with the values of \a trace. Only traces that are not
+ * piecewise constant can be overwritten. Replicas are synchronized again
+ * on their next access.
+ *
+ * @param id the index of the trace.
+ * @param steps the first time point to be written.
+ * @param length number of values to copy.
+ * @param trace buffer of at least \a length values.
+ */
+void TracingNode::restore_trace(trace_id id, nest::delay steps, size_t length, const double* trace)
+{
+    assert(!piecewise_constant_);
+    assert(id < traces_.size());
+
+    for (size_t i = 0; i < length; i++)
+    {
+        traces_[id][steps + i] = trace[i];
+    }
+
+    for (size_t i = 0; i < replicas_.size(); i++)
+    {
+        if (replicas_[i])
+        {
+            replicas_[i]->synced_step_ = std::numeric_limits<long>::min();
+        }
+    }
+}
+
+/**
+ * @return the memory of all traces of the node in bytes, including the
+ * replicas of all threads.
+ */
+size_t TracingNode::get_trace_bytes() const
+{
+    size_t bytes = 0;
+    for (size_t i = 0; i < traces_.size(); i++)
+    {
+        bytes += traces_[i].size() * sizeof (double);
+    }
+    for (size_t i = 0; i < piecewise_traces_.size(); i++)
+    {
+        bytes += piecewise_traces_[i].capacity() * (sizeof (long) + sizeof (double));
+    }
+
+    for (size_t r = 0; r < replicas_.size(); r++)
+    {
+        if (replicas_[r])
+        {
+            for (size_t i = 0; i < replicas_[r]->traces_.size(); i++)
+            {
+                bytes += replicas_[r]->traces_[i].size() * sizeof (double);
+            }
+            for (size_t i = 0; i < replicas_[r]->piecewise_traces_.size(); i++)
+            {
+                bytes += replicas_[r]->piecewise_traces_[i].capacity() * (sizeof (long) + sizeof (double));
+            }
+        }
+    }
+    return bytes;
+}
+
+/**
+ * Store the dynamic state of the node in \a state. The default
+ * implementation stores nothing.
+ */
+void TracingNode::get_checkpoint_state(std::vector<double>& state) const
+{
+    state.clear();
+}
+
+/**
+ * Restore the dynamic state of the node from values that were stored
+ * with get_checkpoint_state(). The default implementation does nothing.
+ */
+void TracingNode::set_checkpoint_state(const std::vector<double>& state)
+{
+}
+
+/**
+ * Stop or resume writing traces of all tracing nodes. Traces keep their
+ * last values while frozen. This is invoked by the ConnectionUpdateManager
+ * when learning is frozen.
+ *
+ * @param frozen true to stop writing traces.
+ */
+void TracingNode::freeze_traces(bool frozen)
+{
+    traces_frozen_ = frozen;
+}
+
+/**
+ * true while writing traces is suspended.
+ */
+bool TracingNode::traces_frozen_ = false;
+
 /**
  * Read traces into dictionary.
  */
@@ -85,16 +338,13 @@ void TracingNode::get_trace_status(DictionaryDatum& d) const
 {
     nest::Time time = ConnectionUpdateManager::instance()->get_horizon();
     ArrayDatum traces;
-    for (size_t trace_id = 0; trace_id < traces_.size(); trace_id++)
+    const size_t trace_length = ConnectionUpdateManager::instance()->get_max_latency();
+    for (size_t trace_id = 0; trace_id < get_num_traces(); trace_id++)
     {
-        TracingNode::const_iterator it = get_trace(time, trace_id);
-        std::vector<double> trace;
-        const size_t trace_length = ConnectionUpdateManager::instance()->get_max_latency();
-        trace.resize(trace_length);
-        for (size_t i = 0; i < trace_length; i++)
+        std::vector<double> trace(trace_length);
+        if (trace_length > 0)
         {
-            trace[i] = *it;
-            ++it; // back to the future
+            copy_trace(trace_id, time.get_steps(), trace_length, &trace[0]);
         }
         traces.push_back(trace);
     }
@@ -35,6 +35,7 @@
 #include "node.h"
 
 #include "circular_buffer.h"
+#include "change_point_buffer.h"
 #include "connection_updater.h"
 
 
@@ -48,20 +49,54 @@ namespace spore
  * stores the most recent values of a real-valued time-dependent variable,
  * e.g., the neuron's membrane potential. Traces can be read by other nodes
  * or connections. Traces can be accessed using the get_trace() method.
+ *
+ * Nodes that provide piecewise constant signals, e.g. reward proxies, can
+ * store their traces as runs of constant values instead (see
+ * ChangePointBuffer). This is requested by passing \c true as second argument
+ * to init_traces(). Writing such traces only costs work when the value
+ * changes. Piecewise constant traces must be read using
+ * get_piecewise_trace(). Use has_piecewise_constant_traces() to check which
+ * accessor applies.
+ *
+ * Nodes that exist only once per process, e.g. reward proxies, are read by
+ * connections on all threads. Such nodes can replicate their traces for
+ * every thread by passing \c true as third argument to init_traces().
+ * Connections then pass their thread to get_trace() or
+ * get_piecewise_trace() and read from a thread-local replica. Replicas are
+ * allocated by the reading thread and pulled from the node's traces once
+ * per time slice, such that readers never touch cache lines that are
+ * written in the current slice.
+ *
+ * Nodes that should keep their dynamic state in checkpoints (see
+ * SporeCheckpoint) override get_checkpoint_state() and
+ * set_checkpoint_state().
+ *
+ * While learning is frozen (see ConnectionUpdateManager::set_learning_frozen())
+ * no connection reads traces and set_trace() does not write them.
  */
 class TracingNode : public nest::Node
 {
 public:
     typedef CircularBuffer<double>::const_iterator const_iterator;
+    typedef ChangePointBuffer<double>::const_iterator piecewise_const_iterator;
     typedef size_t trace_id;
 
     TracingNode();
+    TracingNode(const TracingNode& n);
     virtual ~TracingNode();
 
     virtual void get_status(DictionaryDatum& d) const;
     virtual void set_status(const DictionaryDatum& d);
 
     void get_trace_status(DictionaryDatum& d) const;
+    void copy_trace(trace_id id, nest::delay steps, size_t length, double* trace) const;
+    void restore_trace(trace_id id, nest::delay steps, size_t length, const double* trace);
+    size_t get_trace_bytes() const;
+
+    virtual void get_checkpoint_state(std::vector<double>& state) const;
+    virtual void set_checkpoint_state(const std::vector<double>& state);
+
+    static void freeze_traces(bool frozen);
 
     /**
      * @brief Access the trace of \a id at time step \a step.
@@ -81,6 +116,7 @@ public:
     inline
     const_iterator get_trace(nest::delay steps, trace_id id) const
     {
+        assert(!piecewise_constant_);
         assert(id < traces_.size());
         return traces_[id].get(steps);
     };
@@ -99,21 +135,116 @@ public:
         return get_trace(time.get_steps(), id);
     };
 
+    /**
+     * @brief Hint the processor to load the trace of \a id at time step \a steps.
+     *
+     * Used to fetch the trace of the next target ahead while synapses are
+     * updated (see ConnectionUpdateManager::set_target_ordered()). Does
+     * nothing for piecewise constant traces.
+     *
+     * @param steps the time point that will be read.
+     * @param id the index of the trace.
+     */
+    inline
+    void prefetch_trace(nest::delay steps, trace_id id) const
+    {
+        if (!piecewise_constant_ && id < traces_.size())
+        {
+            SPORE_PREFETCH(&*traces_[id].get(steps));
+        }
+    };
+
+    /**
+     * @brief Access the trace of \a id at time step \a step from the given thread.
+     *
+     * Same as get_trace() but reads from the replica of \a thread if this
+     * node replicates its traces. The same limits as for get_trace() apply.
+     *
+     * @param steps the time point to be read.
+     * @param id the index of the trace.
+     * @param thread the thread of the caller.
+     * @return an iterator to the trace at the given time point.
+     */
+    inline
+    const_iterator get_trace(nest::delay steps, trace_id id, nest::thread thread) const
+    {
+        if (replicas_.empty() || thread == get_thread())
+        {
+            return get_trace(steps, id);
+        }
+        assert(id < traces_.size());
+        return get_replica(thread).traces_[id].get(steps);
+    };
+
+    /**
+     * @brief Access the piecewise constant trace of \a id at time step \a step.
+     *
+     * Same as get_trace() but for nodes that record piecewise constant
+     * traces. The returned iterator additionally allows to query the number
+     * of time steps for which the trace stays constant. The same limits as
+     * for get_trace() apply.
+     *
+     * @param steps the time point to be read.
+     * @param id the index of the trace.
+     * @return an iterator to the trace at the given time point.
+     */
+    inline
+    piecewise_const_iterator get_piecewise_trace(nest::delay steps, trace_id id) const
+    {
+        assert(piecewise_constant_);
+        assert(id < piecewise_traces_.size());
+        return piecewise_traces_[id].get(steps);
+    };
+
+    /**
+     * @brief Access the piecewise constant trace of \a id at time step \a step from the given thread.
+     *
+     * Same as get_piecewise_trace() but reads from the replica of \a thread
+     * if this node replicates its traces.
+     *
+     * @param steps the time point to be read.
+     * @param id the index of the trace.
+     * @param thread the thread of the caller.
+     * @return an iterator to the trace at the given time point.
+     */
+    inline
+    piecewise_const_iterator get_piecewise_trace(nest::delay steps, trace_id id, nest::thread thread) const
+    {
+        if (replicas_.empty() || thread == get_thread())
+        {
+            return get_piecewise_trace(steps, id);
+        }
+        assert(id < piecewise_traces_.size());
+        return get_replica(thread).piecewise_traces_[id].get(steps);
+    };
+
+    /**
+     * @return true if the traces of this node are piecewise constant and
+     * must be read with get_piecewise_trace().
+     */
+    inline
+    bool has_piecewise_constant_traces() const
+    {
+        return piecewise_constant_;
+    };
+
     /**
      * @return the number of traces that are recorded by this node.
      */
     inline
     size_t get_num_traces() const
     {
-        return traces_.size();
+        return piecewise_constant_ ? piecewise_traces_.size() : traces_.size();
     };
 
 protected:
-    void init_traces(size_t num_traces);
+    void init_traces(size_t num_traces, bool piecewise_constant = false, bool replicate = false);
 
     /**
      * Set value of a trace at the given time point. Values are supposed to
-     * be written only in the interval of the current slice.
+     * be written only in the interval of the current slice. For piecewise
+     * constant traces the value holds until it is set again, and values
+     * must be written in the order of time.
      *
      * @param steps time to write values to (in steps).
      * @param v value to be written.
@@ -121,12 +252,62 @@ protected:
      */
     void set_trace(nest::delay steps, double v, trace_id id = 0)
     {
-        assert(id < traces_.size());
-        traces_[id][steps] = v;
+        if (traces_frozen_)
+        {
+            return;
+        }
+
+        if (piecewise_constant_)
+        {
+            assert(id < piecewise_traces_.size());
+            piecewise_traces_[id].set(steps, v);
+        }
+        else
+        {
+            assert(id < traces_.size());
+            traces_[id][steps] = v;
+        }
     }
 
 private:
+
+    /**
+     * @brief Thread-local copy of all traces of the node.
+     */
+    struct TraceReplica
+    {
+        TraceReplica();
+
+        long synced_step_; //!< replica holds all values before this step
+        std::vector< CircularBuffer<double> > traces_;
+        std::vector< ChangePointBuffer<double> > piecewise_traces_;
+    };
+
+    /**
+     * @return the replica of \a thread, synchronized up to the current slice origin.
+     */
+    inline
+    const TraceReplica& get_replica(nest::thread thread) const
+    {
+        assert(static_cast<size_t>(thread) < replicas_.size());
+        TraceReplica* replica = replicas_[thread];
+        if (replica == 0 || replica->synced_step_ != ConnectionUpdateManager::instance()->get_origin().get_steps())
+        {
+            replica = sync_replica(thread);
+        }
+        return *replica;
+    }
+
+    TraceReplica* sync_replica(nest::thread thread) const;
+    void clear_replicas();
+
     std::vector< CircularBuffer<double> > traces_;
+    std::vector< ChangePointBuffer<double> > piecewise_traces_;
+    bool piecewise_constant_;
+
+    mutable std::vector< TraceReplica* > replicas_; //!< per-thread replicas (empty if not replicated)
+
+    static bool traces_frozen_;
 };
 
 }
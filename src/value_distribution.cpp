@@ -0,0 +1,167 @@
+/*
+ * This file is part of SPORE.
+ *
+ * Copyright (C) 2016, the SPORE team (see AUTHORS).
+ *
+ * SPORE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * SPORE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SPORE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * For more information see: https://github.com/IGITUGraz/spore-nest-module
+ *
+ * File:   value_distribution.cpp
+ * Author: Kappel
+ *
+ * Created on October 18, 2026
+ */
+
+#include "value_distribution.h"
+#include "spore_names.h"
+
+#include "dictutils.h"
+#include "doubledatum.h"
+#include "exceptions.h"
+#include "integerdatum.h"
+#include "compose.hpp"
+
+
+namespace spore
+{
+
+//
+// ValueDistribution implementation.
+//
+
+/**
+ * Constructor. Creates the constant distribution 0.
+ */
+ValueDistribution::ValueDistribution()
+: type_(constant),
+p1_(0.0),
+p2_(0.0)
+{
+}
+
+/**
+ * Set the distribution from a number or a distribution dictionary.
+ *
+ * @param t token holding the number or dictionary.
+ * @param name name of the variable, used for error messages.
+ */
+void ValueDistribution::set(const Token& t, const Name& name)
+{
+    if (dynamic_cast<DoubleDatum*>(t.datum()) || dynamic_cast<IntegerDatum*>(t.datum()))
+    {
+        type_ = constant;
+        p1_ = dynamic_cast<DoubleDatum*>(t.datum()) ? getValue<double>(t) : getValue<long>(t);
+        p2_ = 0.0;
+        return;
+    }
+
+    DictionaryDatum* dd = dynamic_cast<DictionaryDatum*>(t.datum());
+    if (dd == 0)
+    {
+        throw nest::BadProperty(String::compose("'%1' must be a number, an array or a distribution "
+                                                "dictionary.", name));
+    }
+
+    const DictionaryDatum& d = *dd;
+    const std::string distribution = getValue<std::string>(d, names::distribution);
+
+    if (distribution == "constant")
+    {
+        type_ = constant;
+        p1_ = getValue<double>(d, names::value);
+        p2_ = 0.0;
+    }
+    else if (distribution == "uniform")
+    {
+        type_ = uniform;
+        p1_ = getValue<double>(d, names::low);
+        p2_ = getValue<double>(d, names::high);
+        if (p2_ < p1_)
+        {
+            throw nest::BadProperty(String::compose("'%1': high must not be smaller than low.", name));
+        }
+    }
+    else if (distribution == "normal" || distribution == "lognormal")
+    {
+        type_ = (distribution == "normal") ? normal : lognormal;
+        p1_ = getValue<double>(d, names::mu);
+        p2_ = getValue<double>(d, names::sigma);
+        if (p2_ < 0.0)
+        {
+            throw nest::BadProperty(String::compose("'%1': sigma must be larger or equal to 0.", name));
+        }
+    }
+    else
+    {
+        throw nest::BadProperty(String::compose("'%1': unknown distribution '%2'.", name, distribution));
+    }
+}
+
+//
+// ValueSource implementation.
+//
+
+/**
+ * Constructor.
+ */
+ValueSource::ValueSource()
+: defined_(false)
+{
+}
+
+/**
+ * Read the value source of a variable from a dictionary. The entry can be
+ * an array of \a size values, a number or a distribution dictionary.
+ *
+ * @param d dictionary that holds the entry.
+ * @param name name of the variable.
+ * @param allow_arrays if false, only numbers and distributions are accepted.
+ * @param size number of values of arrays.
+ * @return true if the dictionary holds an entry for the variable.
+ */
+bool ValueSource::set(const DictionaryDatum& d, const Name& name, bool allow_arrays, size_t size)
+{
+    values_.clear();
+    defined_ = d->known(name);
+
+    if (!defined_)
+    {
+        return false;
+    }
+
+    const Token& t = d->lookup(name);
+    if (dynamic_cast<DictionaryDatum*>(t.datum()) || dynamic_cast<DoubleDatum*>(t.datum()) ||
+        dynamic_cast<IntegerDatum*>(t.datum()))
+    {
+        distribution_.set(t, name);
+        return true;
+    }
+
+    if (!allow_arrays)
+    {
+        throw nest::BadProperty(String::compose("'%1': arrays require the connections to be given by "
+                                                "'source', 'target_thread' and 'port'.", name));
+    }
+
+    values_ = getValue< std::vector<double> >(t);
+    if (values_.size() != size)
+    {
+        throw nest::BadProperty(String::compose("'%1' must have %2 entries but has %3.",
+                                                name, size, values_.size()));
+    }
+    return true;
+}
+
+}
@@ -0,0 +1,183 @@
+/*
+ * This file is part of SPORE.
+ *
+ * Copyright (C) 2016, the SPORE team (see AUTHORS).
+ *
+ * SPORE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * SPORE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SPORE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * For more information see: https://github.com/IGITUGraz/spore-nest-module
+ *
+ * File:   value_distribution.h
+ * Author: Kappel
+ *
+ * Created on October 18, 2026
+ */
+
+#ifndef VALUE_DISTRIBUTION_H
+#define VALUE_DISTRIBUTION_H
+
+#include <cmath>
+#include <vector>
+
+#include <stdint.h>
+
+#include "nest.h"
+#include "dictdatum.h"
+#include "numerics.h"
+
+
+namespace spore
+{
+
+/**
+ * @brief Random distribution of initial values, drawn by key.
+ *
+ * A ValueDistribution is either a constant value or a dictionary of the form
+ * {"distribution": <name>, ...} with the distributions
+ *
+ * <table>
+ * <tr><th>name</th>           <th>parameters</th>           <th>distribution</th></tr>
+ * <tr><td>"constant"</td>     <td>\a value</td>             <td>constant value</td></tr>
+ * <tr><td>"uniform"</td>      <td>\a low, \a high</td>      <td>uniform in [low, high)</td></tr>
+ * <tr><td>"normal"</td>       <td>\a mu, \a sigma</td>      <td>Gaussian</td></tr>
+ * <tr><td>"lognormal"</td>    <td>\a mu, \a sigma</td>      <td>exp of a Gaussian</td></tr>
+ * </table>
+ *
+ * Values are not drawn from a random number stream but computed from a
+ * hash of a 64 bit key (counter-based random numbers). If the key is
+ * derived from the seed and the identity of a synapse, the value of each
+ * synapse is reproducible no matter how many threads draw the values and
+ * in which order the synapses are visited.
+ */
+class ValueDistribution
+{
+public:
+    enum Type
+    {
+        constant,
+        uniform,
+        normal,
+        lognormal
+    };
+
+    ValueDistribution();
+
+    void set(const Token& t, const Name& name);
+
+    /**
+     * Draw the value of the given key.
+     */
+    inline
+    double draw(uint64_t key) const
+    {
+        switch (type_)
+        {
+        case uniform:
+            return p1_ + (p2_ - p1_) * uniform01(mix(key));
+        case normal:
+            return p1_ + p2_ * gaussian(key);
+        case lognormal:
+            return std::exp(p1_ + p2_ * gaussian(key));
+        default:
+            return p1_;
+        }
+    }
+
+    /**
+     * Combine a key with another value.
+     */
+    static inline
+    uint64_t key(uint64_t key, uint64_t v)
+    {
+        return mix(key ^ mix(v));
+    }
+
+private:
+
+    /**
+     * SplitMix64 finalizer.
+     */
+    static inline
+    uint64_t mix(uint64_t z)
+    {
+        z += 0x9e3779b97f4a7c15ULL;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    /**
+     * @return a uniform number in (0, 1).
+     */
+    static inline
+    double uniform01(uint64_t z)
+    {
+        return ((z >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+    }
+
+    /**
+     * @return a standard Gaussian number (Box-Muller transform).
+     */
+    static inline
+    double gaussian(uint64_t key)
+    {
+        const double u1 = uniform01(mix(key));
+        const double u2 = uniform01(mix(~key));
+        return std::sqrt(-2.0 * std::log(u1)) * std::cos(2.0 * numerics::pi * u2);
+    }
+
+    Type type_;
+    double p1_;
+    double p2_;
+};
+
+/**
+ * @brief Source of bulk values for a synapse variable.
+ *
+ * A ValueSource holds either an array with one value per synapse or a
+ * ValueDistribution. It is undefined if the variable was not given.
+ */
+class ValueSource
+{
+public:
+    ValueSource();
+
+    bool set(const DictionaryDatum& d, const Name& name, bool allow_arrays, size_t size);
+
+    /**
+     * @return true if a value was given for the variable.
+     */
+    bool is_defined() const
+    {
+        return defined_;
+    }
+
+    /**
+     * @return value \a k of the array or the value drawn for \a key.
+     */
+    inline
+    double get(size_t k, uint64_t key) const
+    {
+        return values_.empty() ? distribution_.draw(key) : values_[k];
+    }
+
+private:
+    bool defined_;
+    std::vector<double> values_;
+    ValueDistribution distribution_;
+};
+
+}
+
+#endif /* VALUE_DISTRIBUTION_H */
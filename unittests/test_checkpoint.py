@@ -0,0 +1,163 @@
+#! /usr/bin/env python
+# -*- coding: utf-8 -*-
+
+#
+# This file is part of SPORE.
+#
+# Copyright (C) 2016, the SPORE team (see AUTHORS).
+#
+# SPORE is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# SPORE is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with SPORE.  If not, see <http://www.gnu.org/licenses/>.
+#
+# For more information see: https://github.com/IGITUGraz/spore-nest-module
+#
+
+import os
+import shutil
+import tempfile
+
+import nest
+import numpy as np
+import unittest
+
+
+class TestStringMethods(unittest.TestCase):
+
+    def create_nodes(self, num_threads):
+        nest.ResetKernel()
+        nest.SetKernelStatus({"local_num_threads": num_threads})
+        nest.sli_func('InitSynapseUpdater', 100, 100)
+        nest.CopyModel("spore_test_node", "test_tracing_node", {"test_name": "test_tracing_node"})
+        reward = nest.Create("test_tracing_node")
+        inputs = nest.Create("poisson_generator", 10, {"rate": 20.0})
+        neurons = nest.Create("poisson_dbl_exp_neuron", 10)
+        nest.CopyModel("synaptic_sampling_rewardgradient_synapse", "test_synapse")
+        nest.SetDefaults("test_synapse", {"reward_transmitter": reward[0], "learning_rate": 0.0001,
+                                          "temperature": 0.1, "max_param": 100.0, "min_param": -100.0,
+                                          "max_param_change": 100.0})
+        return inputs, neurons
+
+    def create_network(self, num_threads):
+        inputs, neurons = self.create_nodes(num_threads)
+        nest.Connect(neurons, neurons, "all_to_all", {"model": "test_synapse"})
+        nest.Connect(inputs, neurons, "all_to_all", {"model": "test_synapse"})
+        nest.Simulate(1000.0)
+        return neurons
+
+    def get_synapses(self):
+        arrays = nest.sli_func('GetSynapseArrays', "test_synapse")
+        keys = zip(arrays["source"], arrays["target"])
+        values = np.array([arrays[name] for name in ("weight", "synaptic_parameter",
+                                                      "eligibility_trace", "reward_gradient")]).T
+        return dict(zip(keys, values))
+
+    def get_neurons(self, neurons):
+        return np.array(nest.GetStatus(neurons, ["V_m", "adaptive_threshold"]))
+
+    def setUp(self):
+        self.path = tempfile.mkdtemp()
+        self.file_name = os.path.join(self.path, "checkpoint.dat")
+
+    def tearDown(self):
+        shutil.rmtree(self.path)
+
+    # restoring into an empty network creates all connections
+    def test_restore_network(self):
+        neurons = self.create_network(2)
+        synapses = self.get_synapses()
+        state = self.get_neurons(neurons)
+
+        saved = nest.sli_func('SaveSporeCheckpoint', self.file_name)
+        self.assertEqual(saved["synapses"], len(synapses))
+
+        for num_threads in (2, 3):
+            inputs, neurons = self.create_nodes(num_threads)
+            loaded = nest.sli_func('LoadSporeCheckpoint', self.file_name)
+            self.assertEqual(loaded["synapses"], len(synapses))
+            self.assertEqual(loaded["created"], len(synapses))
+            self.assertEqual(loaded["traces"], 0)
+
+            restored = self.get_synapses()
+            self.assertEqual(sorted(restored.keys()), sorted(synapses.keys()))
+            for key, v in synapses.items():
+                self.assertTrue(np.allclose(restored[key], v))
+            self.assertTrue(np.allclose(self.get_neurons(neurons), state))
+
+            # the restored network can be simulated
+            nest.Simulate(200.0)
+
+    # restoring into the same network overwrites the state in place
+    def test_restore_in_place(self):
+        neurons = self.create_network(2)
+        synapses = self.get_synapses()
+        nest.sli_func('SaveSporeCheckpoint', self.file_name)
+
+        nest.sli_func('SetSynapseArrays', "test_synapse", {"synaptic_parameter": 0.0})
+        nest.SetStatus(neurons, {"V_m": 0.0})
+
+        loaded = nest.sli_func('LoadSporeCheckpoint', self.file_name)
+        self.assertEqual(loaded["created"], 0)
+        self.assertEqual(loaded["nodes"], len(neurons) + 1)
+        self.assertGreaterEqual(loaded["traces"], len(neurons))
+
+        restored = self.get_synapses()
+        for key, v in synapses.items():
+            self.assertTrue(np.allclose(restored[key], v))
+
+    # connections are matched by target after connections were added out of order
+    def test_restore_after_connect(self):
+        neurons = self.create_network(2)
+        synapses = self.get_synapses()
+        nest.sli_func('SaveSporeCheckpoint', self.file_name)
+
+        # the new connections are inserted behind the first connection of each neuron
+        nest.Connect(neurons, [neurons[0]], "all_to_all", {"model": "test_synapse"})
+        nest.sli_func('SetSynapseArrays', "test_synapse", {"synaptic_parameter": 0.0})
+
+        loaded = nest.sli_func('LoadSporeCheckpoint', self.file_name)
+        self.assertEqual(loaded["created"], 0)
+        self.assertEqual(loaded["synapses"], len(synapses))
+
+        restored = self.get_synapses()
+        for key, v in synapses.items():
+            if key[1] != neurons[0]:
+                self.assertTrue(np.allclose(restored[key], v))
+
+    # networks with dormant synapses can not be saved, as they would be lost
+    def test_dormant_synapses(self):
+        inputs, neurons = self.create_nodes(2)
+        reward = nest.GetDefaults("test_synapse")["reward_transmitter"]
+        nest.CopyModel("synaptic_sampling_rewardgradient_synapse_hom", "test_synapse_hom")
+        nest.SetDefaults("test_synapse_hom", {"reward_transmitter": reward,
+                                              "temperature": 0.0, "gradient_noise": 0.0, "gradient_scale": 0.0,
+                                              "synaptic_parameter": 1.0, "prior_mean": -1.0,
+                                              "dormant_retracted_synapses": True})
+        nest.Connect(inputs, neurons, "all_to_all", {"model": "test_synapse_hom"})
+        nest.Simulate(3000.0)
+        self.assertGreater(nest.sli_func('GetSporeStatus')["num_dormant_synapses"], 0)
+
+        with self.assertRaises(nest.NESTError):
+            nest.sli_func('SaveSporeCheckpoint', self.file_name)
+
+    # files that are no checkpoints are rejected
+    def test_invalid_file(self):
+        self.create_nodes(1)
+        with open(self.file_name, "wb") as f:
+            f.write(b"\0" * 4096)
+        with self.assertRaises(nest.NESTError):
+            nest.sli_func('LoadSporeCheckpoint', self.file_name)
+
+
+if __name__ == '__main__':
+    nest.Install("sporemodule")
+    unittest.main()
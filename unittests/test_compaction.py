@@ -0,0 +1,96 @@
+#! /usr/bin/env python
+# -*- coding: utf-8 -*-
+
+#
+# This file is part of SPORE.
+#
+# Copyright (C) 2016, the SPORE team (see AUTHORS).
+#
+# SPORE is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# SPORE is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with SPORE.  If not, see <http://www.gnu.org/licenses/>.
+#
+# For more information see: https://github.com/IGITUGraz/spore-nest-module
+#
+
+import numpy as np
+import nest
+import unittest
+
+
+class TestStringMethods(unittest.TestCase):
+
+    # prune all but a few synapses of one connector and return the remaining synapses
+    def run_pruning(self, compaction):
+        nest.ResetKernel()
+        nest.sli_func('InitSynapseUpdater', 100, 100)
+        nest.sli_func('SetSporeStatus', compaction)
+        nest.CopyModel("spore_test_node", "test_tracing_node", {"test_name": "test_tracing_node"})
+        nodes = nest.Create("test_tracing_node", 100)
+        nest.CopyModel("synaptic_sampling_rewardgradient_synapse", "test_synapse")
+        nest.SetDefaults("test_synapse", {"weight_update_interval": 100.0, "temperature": 0.0,
+                                          "reward_transmitter": nodes[0], "learning_rate": 0.0001,
+                                          "episode_length": 100.0, "prior_mean": -1.0, "max_param": 100.0,
+                                          "min_param": -100.0, "max_param_change": 100.0, "gradient_scale": 0.0,
+                                          "delete_retracted_synapses": True, "integration_time": 10000.0})
+        nest.Connect([nodes[0]], nodes, "all_to_all", {"model": "test_synapse"})
+        conns = nest.GetConnections([nodes[0]], nodes, "test_synapse")
+        syn_param = np.concatenate((np.zeros(90), np.ones(10) * 50.0))
+        nest.SetStatus(conns, [{"recorder_interval": 100.0, "synaptic_parameter": p} for p in syn_param])
+
+        nest.Simulate(5000.0)
+
+        status = nest.GetStatus(nest.GetConnections([nodes[0]], nodes, "test_synapse"),
+                                ["target", "synaptic_parameter"])
+        recorder_times = nest.GetStatus(nest.GetConnections([nodes[0]], nodes, "test_synapse"), "recorder_times")
+        self.recorder_times = [list(times) for times in recorder_times]
+        return status, nest.sli_func('GetSporeStatus')
+
+    # compaction reports its settings and rejects invalid values
+    def test_status(self):
+        nest.ResetKernel()
+        nest.sli_func('InitSynapseUpdater', 100, 100)
+        status = nest.sli_func('GetSporeStatus')
+        self.assertEqual(status["compaction_interval"], 0)
+        self.assertEqual(status["compaction_threshold"], 0.5)
+        self.assertEqual(status["estimated_reclaimed_bytes"], 0)
+
+        with self.assertRaises(nest.NESTError):
+            nest.sli_func('SetSporeStatus', {"compaction_interval": -1})
+        with self.assertRaises(nest.NESTError):
+            nest.sli_func('SetSporeStatus', {"compaction_threshold": 0.0})
+
+    # compacted connectors keep the remaining synapses and their state
+    def test_compaction(self):
+        expected, status = self.run_pruning({})
+        self.assertEqual(len(expected), 10)
+        self.assertEqual(status["estimated_reclaimed_bytes"], 0)
+
+        result, status = self.run_pruning({"compaction_interval": 1, "compaction_threshold": 0.5})
+        self.assertEqual(result, expected)
+        self.assertGreater(status["estimated_reclaimed_bytes"], 0)
+
+    # synapses that are recorded keep recording after their connector was compacted
+    def test_compaction_recording(self):
+        self.run_pruning({})
+        expected = self.recorder_times
+
+        _, status = self.run_pruning({"compaction_interval": 1, "compaction_threshold": 0.5})
+        self.assertGreater(status["estimated_reclaimed_bytes"], 0)
+        self.assertEqual(self.recorder_times, expected)
+        for times in self.recorder_times:
+            self.assertGreaterEqual(times[-1], 4900.0)
+
+
+if __name__ == '__main__':
+    nest.Install("sporemodule")
+    unittest.main()
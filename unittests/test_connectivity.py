@@ -0,0 +1,114 @@
+#! /usr/bin/env python
+# -*- coding: utf-8 -*-
+
+#
+# This file is part of SPORE.
+#
+# Copyright (C) 2016, the SPORE team (see AUTHORS).
+#
+# SPORE is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# SPORE is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with SPORE.  If not, see <http://www.gnu.org/licenses/>.
+#
+# For more information see: https://github.com/IGITUGraz/spore-nest-module
+#
+
+import os
+import shutil
+import sys
+import tempfile
+
+import nest
+import numpy as np
+import unittest
+
+sys.path.append(os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "utils"))
+from spore_connectivity import write_connectivity, read_connectivity, load_connectivity  # noqa: E402
+
+
+class TestStringMethods(unittest.TestCase):
+
+    def create_nodes(self, num_threads, n=20):
+        nest.ResetKernel()
+        nest.SetKernelStatus({"local_num_threads": num_threads})
+        nest.sli_func('InitSynapseUpdater', 100, 100)
+        nest.CopyModel("spore_test_node", "test_tracing_node", {"test_name": "test_tracing_node"})
+        nodes = nest.Create("test_tracing_node", n)
+        nest.CopyModel("synaptic_sampling_rewardgradient_synapse", "test_synapse")
+        return nodes
+
+    def setUp(self):
+        self.path = tempfile.mkdtemp()
+        self.file_name = os.path.join(self.path, "connectivity.dat")
+
+    def tearDown(self):
+        shutil.rmtree(self.path)
+
+    # all connections of the file are created with their parameters
+    def test_load_connectivity(self):
+        rng = np.random.RandomState(1)
+        n = 20
+        sources = rng.randint(1, n + 1, 500)
+        targets = rng.randint(1, n + 1, 500)
+        parameters = rng.uniform(-1.0, 1.0, 500)
+        delays = rng.randint(1, 10, 500) * 0.5
+        write_connectivity(self.file_name, sources, targets, parameters, delays)
+        self.assertEqual(len(read_connectivity(self.file_name)), 500)
+
+        for num_threads in (1, 3):
+            self.create_nodes(num_threads, n)
+            self.assertEqual(load_connectivity(self.file_name, "test_synapse"), 500)
+
+            conns = nest.GetConnections(synapse_model="test_synapse")
+            self.assertEqual(len(conns), 500)
+            status = nest.GetStatus(conns, ["source", "target", "synaptic_parameter", "delay"])
+            self.assertEqual(sorted(status), sorted(zip(sources, targets, parameters, delays)))
+
+            # connections are registered at the update manager
+            arrays = nest.sli_func('GetSynapseArrays', "test_synapse")
+            self.assertEqual(len(arrays["source"]), 500)
+            nest.Simulate(100.0)
+
+    # default values are used for NaN entries, loading adds to existing connections
+    def test_load_connectivity_defaults(self):
+        nodes = self.create_nodes(2)
+        nest.Connect(nodes[:5], nodes[5:10], "all_to_all", {"model": "test_synapse"})
+        write_connectivity(self.file_name, nodes[:5], nodes[10:15])
+        self.assertEqual(load_connectivity(self.file_name, "test_synapse"), 5)
+
+        conns = nest.GetConnections(synapse_model="test_synapse")
+        self.assertEqual(len(conns), 30)
+        arrays = nest.sli_func('GetSynapseArrays', "test_synapse")
+        self.assertEqual(len(arrays["source"]), 30)
+
+        defaults = nest.GetDefaults("test_synapse")
+        conns = nest.GetConnections(target=nodes[10:15], synapse_model="test_synapse")
+        for delay in nest.GetStatus(conns, "delay"):
+            self.assertEqual(delay, defaults["delay"])
+
+    # invalid files and nodes are rejected
+    def test_load_connectivity_invalid(self):
+        self.create_nodes(1, 5)
+        write_connectivity(self.file_name, [1, 2], [3, 100])
+        with self.assertRaises(nest.NESTError):
+            load_connectivity(self.file_name, "test_synapse")
+        self.assertEqual(len(nest.GetConnections(synapse_model="test_synapse")), 0)
+
+        with open(self.file_name, "wb") as f:
+            f.write(b"\0" * 64)
+        with self.assertRaises(nest.NESTError):
+            load_connectivity(self.file_name, "test_synapse")
+
+
+if __name__ == '__main__':
+    nest.Install("sporemodule")
+    unittest.main()
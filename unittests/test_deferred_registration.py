@@ -0,0 +1,90 @@
+#! /usr/bin/env python
+# -*- coding: utf-8 -*-
+
+#
+# This file is part of SPORE.
+#
+# Copyright (C) 2016, the SPORE team (see AUTHORS).
+#
+# SPORE is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# SPORE is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with SPORE.  If not, see <http://www.gnu.org/licenses/>.
+#
+# For more information see: https://github.com/IGITUGraz/spore-nest-module
+#
+
+import nest
+import unittest
+
+
+class TestStringMethods(unittest.TestCase):
+
+    def create_nodes(self, num_threads, n=20):
+        nest.ResetKernel()
+        nest.SetKernelStatus({"local_num_threads": num_threads})
+        nest.sli_func('InitSynapseUpdater', 100, 100)
+        nest.CopyModel("spore_test_node", "test_tracing_node", {"test_name": "test_tracing_node"})
+        nodes = nest.Create("test_tracing_node", n)
+        nest.CopyModel("synaptic_sampling_rewardgradient_synapse", "test_synapse")
+        return nodes
+
+    def connect(self, nodes, deferred):
+        nest.sli_func('SetSporeStatus', {"deferred_registration": deferred})
+        nest.Connect(nodes[:10], nodes[10:], "all_to_all", {"model": "test_synapse"})
+        nest.Connect(nodes[10:], nodes[:10], {"rule": "fixed_indegree", "indegree": 7},
+                     {"model": "test_synapse"})
+        nest.Connect(nodes[:10], nodes[10:], "one_to_one", {"model": "test_synapse"})
+
+    # the status reports the settings of the synapse updater
+    def test_status(self):
+        self.create_nodes(1)
+        status = nest.sli_func('GetSporeStatus')
+        self.assertEqual(status["update_interval"], 100)
+        self.assertEqual(status["acceptable_latency"], 100)
+        self.assertFalse(status["deferred_registration"])
+        self.assertEqual(status["num_connectors"], 0)
+
+        nest.sli_func('SetSporeStatus', {"deferred_registration": True})
+        self.assertTrue(nest.sli_func('GetSporeStatus')["deferred_registration"])
+
+        # the kernel reset switches deferred registration off
+        self.create_nodes(1)
+        self.assertFalse(nest.sli_func('GetSporeStatus')["deferred_registration"])
+
+    # deferred registration registers the same connectors
+    def test_deferred_registration(self):
+        for num_threads in (1, 3):
+            nodes = self.create_nodes(num_threads)
+            self.connect(nodes, False)
+            expected = nest.sli_func('GetSporeStatus')["num_connectors"]
+            arrays = nest.sli_func('GetSynapseArrays', "test_synapse")
+            expected_synapses = sorted(zip(arrays["source"], arrays["target"]))
+            self.assertEqual(len(expected_synapses), 270)
+
+            nodes = self.create_nodes(num_threads)
+            self.connect(nodes, True)
+            self.assertEqual(nest.sli_func('GetSporeStatus')["num_connectors"], expected)
+            arrays = nest.sli_func('GetSynapseArrays', "test_synapse")
+            self.assertEqual(sorted(zip(arrays["source"], arrays["target"])), expected_synapses)
+
+            # connections created after the first simulation are registered as well
+            nest.Simulate(100.0)
+            nest.Connect(nodes[10:], nodes[10:], "one_to_one", {"model": "test_synapse"})
+            nest.Simulate(100.0)
+            nest.sli_func('SetSporeStatus', {"deferred_registration": False})
+            arrays = nest.sli_func('GetSynapseArrays', "test_synapse")
+            self.assertEqual(len(arrays["source"]), 280)
+
+
+if __name__ == '__main__':
+    nest.Install("sporemodule")
+    unittest.main()
@@ -0,0 +1,120 @@
+#! /usr/bin/env python
+# -*- coding: utf-8 -*-
+
+#
+# This file is part of SPORE.
+#
+# Copyright (C) 2016, the SPORE team (see AUTHORS).
+#
+# SPORE is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# SPORE is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with SPORE.  If not, see <http://www.gnu.org/licenses/>.
+#
+# For more information see: https://github.com/IGITUGraz/spore-nest-module
+#
+
+import nest
+import unittest
+
+
+MODEL = "synaptic_sampling_rewardgradient_synapse_hom"
+
+
+class TestStringMethods(unittest.TestCase):
+
+    def setup_network(self, model, params, deferred=False):
+        nest.ResetKernel()
+        nest.SetKernelStatus({"local_num_threads": 2})
+        nest.sli_func('InitSynapseUpdater', 100, 100)
+        nest.sli_func('SetSporeStatus', {"deferred_registration": deferred})
+        nest.CopyModel("spore_test_node", "test_tracing_node", {"test_name": "test_tracing_node"})
+        nodes = nest.Create("test_tracing_node", 6)
+        nest.CopyModel(model, "test_synapse")
+        defaults = {"reward_transmitter": nodes[0], "temperature": 0.0, "gradient_noise": 0.0,
+                    "gradient_scale": 0.0, "learning_rate": 0.005, "weight_update_interval": 100.0,
+                    "synaptic_parameter": 1.0, "prior_mean": -1.0, "prior_precision": 1.0}
+        defaults.update(params)
+        nest.SetDefaults("test_synapse", defaults)
+        nest.Connect(nodes[:3], nodes[3:], "all_to_all", {"model": "test_synapse"})
+        return nodes
+
+    # retracted synapses are removed from the network and connected again when their parameter grows
+    def test_dormant_synapses(self):
+        self.run_dormant_synapses(deferred=False)
+
+    # synapses are promoted while registration of connectors is still deferred
+    def test_dormant_synapses_deferred(self):
+        self.run_dormant_synapses(deferred=True)
+
+    def run_dormant_synapses(self, deferred):
+        nodes = self.setup_network(MODEL, {"dormant_retracted_synapses": True}, deferred)
+
+        nest.Simulate(3000)
+
+        self.assertEqual(nest.sli_func('GetSporeStatus')["num_dormant_synapses"], 9)
+        self.assertEqual(len(nest.GetConnections(nodes[:3], nodes[3:], "test_synapse")), 0)
+
+        nest.SetDefaults("test_synapse", {"prior_mean": 1.0})
+        nest.Simulate(3000)
+
+        self.assertEqual(nest.sli_func('GetSporeStatus')["num_dormant_synapses"], 0)
+        conns = nest.GetConnections(nodes[:3], nodes[3:], "test_synapse")
+        self.assertEqual(len(conns), 9)
+        for status in nest.GetStatus(conns):
+            self.assertGreaterEqual(status["synaptic_parameter"], 0.0)
+
+        # the promoted connections are updated further
+        nest.Simulate(1000)
+        self.assertEqual(len(nest.GetConnections(nodes[:3], nodes[3:], "test_synapse")), 9)
+
+    # converting to static synapses drops dormant synapses, which are not promoted again
+    def test_convert_to_static(self):
+        nodes = self.setup_network(MODEL, {"dormant_retracted_synapses": True})
+
+        nest.Simulate(3000)
+        self.assertEqual(nest.sli_func('GetSporeStatus')["num_dormant_synapses"], 9)
+
+        result = nest.sli_func('ConvertToStaticSynapses', "test_synapse", "static_synapse")
+        self.assertEqual(result["dropped"], 9)
+        self.assertEqual(nest.sli_func('GetSporeStatus')["num_dormant_synapses"], 0)
+
+        nest.SetDefaults("test_synapse", {"prior_mean": 1.0})
+        nest.Simulate(3000)
+
+        self.assertEqual(nest.sli_func('GetSporeStatus')["num_dormant_synapses"], 0)
+        self.assertEqual(len(nest.GetConnections(nodes[:3], nodes[3:], "test_synapse")), 0)
+
+    # without dormant synapses retracted synapses stay in the network
+    def test_no_dormant_synapses(self):
+        nodes = self.setup_network(MODEL, {})
+
+        nest.Simulate(3000)
+
+        self.assertEqual(nest.sli_func('GetSporeStatus')["num_dormant_synapses"], 0)
+        self.assertEqual(len(nest.GetConnections(nodes[:3], nodes[3:], "test_synapse")), 9)
+
+    # dormant synapses require a homogeneous prior
+    def test_per_synapse_prior(self):
+        with self.assertRaises(nest.NESTError):
+            self.setup_network("synaptic_sampling_rewardgradient_synapse", {"dormant_retracted_synapses": True})
+
+    # dormant synapses can not be combined with other treatments of retracted synapses
+    def test_simulate_retracted_synapses(self):
+        self.setup_network(MODEL, {"dormant_retracted_synapses": True, "simulate_retracted_synapses": True})
+
+        with self.assertRaises(nest.NESTError):
+            nest.Simulate(100)
+
+
+if __name__ == '__main__':
+    nest.Install("sporemodule")
+    unittest.main()
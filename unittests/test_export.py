@@ -0,0 +1,111 @@
+#! /usr/bin/env python
+# -*- coding: utf-8 -*-
+
+#
+# This file is part of SPORE.
+#
+# Copyright (C) 2016, the SPORE team (see AUTHORS).
+#
+# SPORE is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# SPORE is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with SPORE.  If not, see <http://www.gnu.org/licenses/>.
+#
+# For more information see: https://github.com/IGITUGraz/spore-nest-module
+#
+
+import os
+import sys
+
+import numpy as np
+import nest
+import unittest
+
+sys.path.append(os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "utils"))
+from spore_export import export_recorder_data, export_traces, recorder_rows, trace_rows  # noqa: E402
+from spore_shm import RewardShmWriter  # noqa: E402
+
+RECORDED = ["synaptic_parameter_values", "weight_values", "reward_gradient_values"]
+
+
+class TestStringMethods(unittest.TestCase):
+
+    def setUp(self):
+        self.shm_name = "/spore_test_export_%d" % os.getpid()
+
+    # exported recordings must match the recordings returned by GetStatus
+    def test_export_recorder_data(self):
+        nest.ResetKernel()
+        nest.SetKernelStatus({"local_num_threads": 2})
+        nest.sli_func('InitSynapseUpdater', 100, 100)
+        nest.CopyModel("spore_test_node", "test_tracing_node", {"test_name": "test_tracing_node"})
+        nodes = nest.Create("test_tracing_node", 5)
+        nest.CopyModel("synaptic_sampling_rewardgradient_synapse", "test_synapse")
+        nest.SetDefaults("test_synapse", {"reward_transmitter": nodes[0], "weight_update_interval": 100.0,
+                                          "temperature": 0.1, "learning_rate": 0.0001, "episode_length": 100.0,
+                                          "max_param": 100.0, "min_param": -100.0, "max_param_change": 100.0,
+                                          "integration_time": 10000.0})
+        nest.Connect([nodes[0]], nodes[1:], "all_to_all", {"model": "test_synapse"})
+        conns = nest.GetConnections([nodes[0]], nodes[1:], "test_synapse")
+        nest.SetStatus(conns[:2], {"recorder_interval": 200.0})
+        nest.SetStatus(conns[2:], {"recorder_interval": 100.0, "recorder_max_samples": 8,
+                                   "recorder_decimation_levels": 2})
+
+        nest.Simulate(2000)
+
+        status = nest.GetStatus(conns, ["recorder_port", "recorder_times"] + RECORDED)
+        records = recorder_rows(export_recorder_data(shm_name=self.shm_name))
+
+        for st in status:
+            rec = records[st[0]]
+            self.assertEqual(len(rec["recorder_times"]), len(st[1]))
+            self.assertTrue(np.allclose(rec["recorder_times"], st[1]))
+            for i, name in enumerate(RECORDED):
+                self.assertTrue(np.allclose(rec[name], st[2 + i]))
+
+        self.assertFalse(os.path.exists("/dev/shm" + self.shm_name))
+
+    # exported trace windows must match the traces returned by GetStatus
+    def test_export_traces(self):
+        nest.ResetKernel()
+        nest.SetKernelStatus({"resolution": 1.0})
+        nest.sli_func('InitSynapseUpdater', 100, 100)
+
+        writer = RewardShmWriter(self.shm_name + "_reward", n_channels=2, buffer_size=1000)
+        proxies = nest.Create("reward_shm_proxy")
+        nest.SetStatus(proxies, {"shm_name": self.shm_name + "_reward", "n_channels": 2, "buffer_size": 1000})
+        for step in range(500):
+            writer.write(step, (0.5 * step, -1.0 * step))
+
+        nest.Simulate(500.0)
+        writer.close(unlink=True)
+
+        reader = export_traces(proxies, shm_name=self.shm_name)
+        traces = trace_rows(reader)
+        expected = nest.GetStatus(proxies, "trace")
+
+        self.assertEqual(reader.dt, 1.0)
+        for gid, exp in zip(proxies, expected):
+            self.assertEqual(len(traces[gid]), len(exp))
+            for trace, exp_trace in zip(traces[gid], exp):
+                self.assertTrue(np.allclose(trace, exp_trace))
+
+    # only tracing nodes can be exported
+    def test_export_traces_invalid(self):
+        nest.ResetKernel()
+        neuron = nest.Create("iaf_psc_alpha")
+        with self.assertRaises(nest.NESTError):
+            export_traces(neuron, shm_name=self.shm_name)
+
+
+if __name__ == '__main__':
+    nest.Install("sporemodule")
+    unittest.main()
@@ -168,6 +168,41 @@ class TestStringMethods(unittest.TestCase):
         self.spore_connection_test(p_sim, synapse_properties, target_values)
 
 
+    # connections created in any order are sorted by target and deleted individually
+    def test_garbage_collector_order(self):
+        nest.ResetKernel()
+        nest.sli_func('InitSynapseUpdater', 100, 100)
+        nest.CopyModel("spore_test_node", "test_tracing_node", {"test_name": "test_tracing_node"})
+        nodes = nest.Create("test_tracing_node", 50)
+        nest.CopyModel("synaptic_sampling_rewardgradient_synapse", "test_synapse",
+                       {"weight_update_interval": 100.0, "temperature": 0.0, "reward_transmitter": nodes[0],
+                        "learning_rate": 0.0, "delete_retracted_synapses": True})
+
+        targets = list(nodes[1:]) * 2
+        np.random.RandomState(1).shuffle(targets)
+        nest.Connect([nodes[0]] * len(targets), targets, "one_to_one", {"model": "test_synapse"})
+
+        conns = nest.GetConnections([nodes[0]], synapse_model="test_synapse")
+        self.assertEqual(list(nest.GetStatus(conns, "target")), sorted(targets))
+
+        # retract one synapse of each target with odd GID
+        retracted = set()
+        for c, target in zip(conns, nest.GetStatus(conns, "target")):
+            parameter = 1.0
+            if target % 2 == 1 and target not in retracted:
+                retracted.add(target)
+                parameter = -1.0
+            nest.SetStatus([c], {"synaptic_parameter": parameter})
+
+        nest.Simulate(500.0)
+
+        conns = nest.GetConnections([nodes[0]], synapse_model="test_synapse")
+        expected = sorted(targets)
+        for target in retracted:
+            expected.remove(target)
+        self.assertEqual(list(nest.GetStatus(conns, "target")), expected)
+        self.assertTrue(all(p > 0.0 for p in nest.GetStatus(conns, "synaptic_parameter")))
+
 if __name__ == '__main__':
     nest.Install("sporemodule")
     unittest.main()
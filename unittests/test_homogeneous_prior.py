@@ -0,0 +1,80 @@
+#! /usr/bin/env python
+# -*- coding: utf-8 -*-
+
+#
+# This file is part of SPORE.
+#
+# Copyright (C) 2016, the SPORE team (see AUTHORS).
+#
+# SPORE is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# SPORE is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with SPORE.  If not, see <http://www.gnu.org/licenses/>.
+#
+# For more information see: https://github.com/IGITUGraz/spore-nest-module
+#
+
+import nest
+import unittest
+
+PRIOR = {"prior_mean": -1.0, "prior_precision": 0.5}
+
+
+class TestStringMethods(unittest.TestCase):
+
+    def run_network(self, model):
+        nest.ResetKernel()
+        nest.SetKernelStatus({"local_num_threads": 2})
+        nest.sli_func('InitSynapseUpdater', 100, 100)
+        nest.CopyModel("spore_test_node", "test_tracing_node", {"test_name": "test_tracing_node"})
+        nodes = nest.Create("test_tracing_node", 6)
+        nest.CopyModel(model, "test_synapse")
+        params = {"reward_transmitter": nodes[0], "temperature": 0.0,
+                  "gradient_noise": 0.0, "learning_rate": 0.0001,
+                  "weight_update_interval": 100.0}
+        params.update(PRIOR)
+        nest.SetDefaults("test_synapse", params)
+        nest.Connect(nodes[:3], nodes[3:], "all_to_all", {"model": "test_synapse"})
+
+        nest.Simulate(2000)
+
+        status = nest.GetStatus(nest.GetConnections([nodes[1]], [nodes[4]], "test_synapse"))[0]
+        arrays = nest.sli_func('GetSynapseArrays', "test_synapse")
+        return nodes, status, arrays
+
+    # a homogeneous prior in the common properties behaves like the same prior in every synapse
+    def test_homogeneous_prior(self):
+        for model, hom_model in (("synaptic_sampling_rewardgradient_synapse",
+                                  "synaptic_sampling_rewardgradient_synapse_hom"),
+                                 ("synaptic_sampling_rewardgradient_synapse_hpc",
+                                  "synaptic_sampling_rewardgradient_synapse_hom_hpc")):
+            nodes, status, arrays = self.run_network(model)
+            nodes, hom_status, hom_arrays = self.run_network(hom_model)
+
+            self.assertLess(hom_status["size_of"], status["size_of"])
+            self.assertEqual(nest.GetDefaults("test_synapse")["prior_mean"], PRIOR["prior_mean"])
+            self.assertEqual(nest.GetDefaults("test_synapse")["prior_precision"], PRIOR["prior_precision"])
+
+            for key in ("source", "target", "synaptic_parameter", "weight"):
+                self.assertEqual(list(hom_arrays[key]), list(arrays[key]))
+
+    # the prior can not be set per synapse for a homogeneous prior
+    def test_per_synapse_prior(self):
+        nodes, status, arrays = self.run_network("synaptic_sampling_rewardgradient_synapse_hom")
+
+        with self.assertRaises(nest.NESTError):
+            nest.Connect([nodes[1]], [nodes[4]], "one_to_one",
+                         {"model": "test_synapse", "prior_mean": 0.0})
+
+
+if __name__ == '__main__':
+    nest.Install("sporemodule")
+    unittest.main()
@@ -0,0 +1,69 @@
+#! /usr/bin/env python
+# -*- coding: utf-8 -*-
+
+#
+# This file is part of SPORE.
+#
+# Copyright (C) 2016, the SPORE team (see AUTHORS).
+#
+# SPORE is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# SPORE is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with SPORE.  If not, see <http://www.gnu.org/licenses/>.
+#
+# For more information see: https://github.com/IGITUGraz/spore-nest-module
+#
+
+import nest
+import unittest
+
+
+class TestStringMethods(unittest.TestCase):
+
+    def run_network(self, model):
+        nest.ResetKernel()
+        nest.SetKernelStatus({"local_num_threads": 2})
+        nest.sli_func('InitSynapseUpdater', 100, 100)
+        nest.CopyModel("spore_test_node", "test_tracing_node", {"test_name": "test_tracing_node"})
+        nodes = nest.Create("test_tracing_node", 6)
+        nest.CopyModel(model, "test_synapse")
+        nest.SetDefaults("test_synapse", {"reward_transmitter": nodes[0], "temperature": 0.0,
+                                          "gradient_noise": 0.0, "learning_rate": 0.0001,
+                                          "weight_update_interval": 100.0})
+        nest.Connect(nodes[:3], nodes[3:], "all_to_all", {"model": "test_synapse"})
+
+        conns = nest.GetConnections([nodes[1]], [nodes[4]], "test_synapse")
+        nest.SetStatus(conns, {"recorder_interval": 100.0})
+
+        nest.Simulate(2000)
+
+        status = nest.GetStatus(conns)[0]
+        arrays = nest.sli_func('GetSynapseArrays', "test_synapse")
+        return status, arrays
+
+    # the compact synapse model behaves like the default model
+    def test_hpc_synapse(self):
+        status, arrays = self.run_network("synaptic_sampling_rewardgradient_synapse")
+        hpc_status, hpc_arrays = self.run_network("synaptic_sampling_rewardgradient_synapse_hpc")
+
+        self.assertLess(hpc_status["size_of"], status["size_of"])
+
+        self.assertGreater(len(hpc_status["recorder_times"]), 0)
+        self.assertEqual(list(hpc_status["recorder_times"]), list(status["recorder_times"]))
+        self.assertEqual(list(hpc_status["synaptic_parameter_values"]), list(status["synaptic_parameter_values"]))
+
+        for key in ("source", "target", "synaptic_parameter", "weight"):
+            self.assertEqual(list(hpc_arrays[key]), list(arrays[key]))
+
+
+if __name__ == '__main__':
+    nest.Install("sporemodule")
+    unittest.main()
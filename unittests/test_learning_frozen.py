@@ -0,0 +1,80 @@
+#! /usr/bin/env python
+# -*- coding: utf-8 -*-
+
+#
+# This file is part of SPORE.
+#
+# Copyright (C) 2016, the SPORE team (see AUTHORS).
+#
+# SPORE is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# SPORE is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with SPORE.  If not, see <http://www.gnu.org/licenses/>.
+#
+# For more information see: https://github.com/IGITUGraz/spore-nest-module
+#
+
+import nest
+import unittest
+
+
+class TestStringMethods(unittest.TestCase):
+
+    def create_network(self):
+        nest.ResetKernel()
+        nest.SetKernelStatus({"local_num_threads": 2})
+        nest.sli_func('InitSynapseUpdater', 100, 100)
+        nest.CopyModel("spore_test_node", "test_tracing_node", {"test_name": "test_tracing_node"})
+        nodes = nest.Create("test_tracing_node", 6)
+        nest.CopyModel("synaptic_sampling_rewardgradient_synapse", "test_synapse")
+        nest.SetDefaults("test_synapse", {"reward_transmitter": nodes[0], "temperature": 0.1,
+                                          "learning_rate": 0.0001})
+        nest.Connect(nodes[:3], nodes[3:], "all_to_all", {"model": "test_synapse"})
+
+    def get_parameters(self):
+        return list(nest.sli_func('GetSynapseArrays', "test_synapse")["synaptic_parameter"])
+
+    # synapses keep their state while learning is frozen
+    def test_learning_frozen(self):
+        self.create_network()
+        self.assertFalse(nest.sli_func('GetSporeStatus')["learning_frozen"])
+
+        nest.Simulate(1000)
+
+        nest.sli_func('SetSporeStatus', {"learning_frozen": True})
+        self.assertTrue(nest.sli_func('GetSporeStatus')["learning_frozen"])
+
+        # connections are brought up to date when the simulation starts
+        nest.Simulate(500)
+        frozen = self.get_parameters()
+        nest.Simulate(1000)
+        self.assertEqual(self.get_parameters(), frozen)
+
+        nest.sli_func('SetSporeStatus', {"learning_frozen": False})
+        nest.Simulate(1000)
+        self.assertNotEqual(self.get_parameters(), frozen)
+
+    # learning can be frozen before the first simulation
+    def test_learning_frozen_initially(self):
+        self.create_network()
+        nest.sli_func('SetSporeStatus', {"learning_frozen": True})
+        initial = self.get_parameters()
+        nest.Simulate(1000)
+        self.assertEqual(self.get_parameters(), initial)
+
+        # the kernel reset resumes learning
+        self.create_network()
+        self.assertFalse(nest.sli_func('GetSporeStatus')["learning_frozen"])
+
+
+if __name__ == '__main__':
+    nest.Install("sporemodule")
+    unittest.main()
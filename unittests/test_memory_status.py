@@ -0,0 +1,76 @@
+#! /usr/bin/env python
+# -*- coding: utf-8 -*-
+
+#
+# This file is part of SPORE.
+#
+# Copyright (C) 2016, the SPORE team (see AUTHORS).
+#
+# SPORE is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# SPORE is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with SPORE.  If not, see <http://www.gnu.org/licenses/>.
+#
+# For more information see: https://github.com/IGITUGraz/spore-nest-module
+#
+
+import nest
+import unittest
+
+
+MODELS = ("synaptic_sampling_rewardgradient_synapse", "synaptic_sampling_rewardgradient_synapse_hpc")
+CATEGORIES = ("synapse_bytes", "trace_bytes", "schedule_bytes", "garbage_pile_bytes", "dormant_bytes")
+
+
+class TestStringMethods(unittest.TestCase):
+
+    def create_network(self, latency):
+        nest.ResetKernel()
+        nest.SetKernelStatus({"local_num_threads": 2})
+        nest.sli_func('InitSynapseUpdater', 100, latency)
+        nest.CopyModel("spore_test_node", "test_tracing_node", {"test_name": "test_tracing_node"})
+        nodes = nest.Create("test_tracing_node", 10)
+        nest.Connect(nodes[:5], nodes[5:], "all_to_all", {"model": MODELS[0]})
+        nest.Connect(nodes[5:], nodes[:5], "one_to_one", {"model": MODELS[1]})
+
+    # synapses are counted for each model and thread, and threads add up to the total
+    def test_memory_status(self):
+        self.create_network(100)
+        nest.Simulate(200.0)
+        status = nest.sli_func('GetSporeMemoryStatus')
+
+        self.assertEqual(len(status["threads"]), 2)
+        total = status["total"]
+        for model, n in zip(MODELS, (25, 5)):
+            size_of = nest.GetStatus(nest.GetConnections(synapse_model=model)[:1])[0]["size_of"]
+            self.assertEqual(total["synapses"][model]["num_synapses"], n)
+            self.assertEqual(total["synapses"][model]["synapse_bytes"], n * size_of)
+
+        for category in CATEGORIES:
+            self.assertEqual(total[category], sum(t[category] for t in status["threads"]))
+            self.assertGreaterEqual(total["total_bytes"], total[category])
+        self.assertGreater(total["trace_bytes"], 0)
+        self.assertEqual(total["total_bytes"],
+                         sum(total[category] for category in CATEGORIES) + total["recorder_bytes"])
+
+    # trace memory grows with the acceptable latency
+    def test_latency(self):
+        self.create_network(100)
+        nest.Simulate(200.0)
+        trace_bytes = nest.sli_func('GetSporeMemoryStatus')["total"]["trace_bytes"]
+        self.create_network(1000)
+        nest.Simulate(200.0)
+        self.assertGreater(nest.sli_func('GetSporeMemoryStatus')["total"]["trace_bytes"], trace_bytes)
+
+
+if __name__ == '__main__':
+    nest.Install("sporemodule")
+    unittest.main()
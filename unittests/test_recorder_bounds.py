@@ -0,0 +1,96 @@
+#! /usr/bin/env python
+# -*- coding: utf-8 -*-
+
+#
+# This file is part of SPORE.
+#
+# Copyright (C) 2016, the SPORE team (see AUTHORS).
+#
+# SPORE is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# SPORE is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with SPORE.  If not, see <http://www.gnu.org/licenses/>.
+#
+# For more information see: https://github.com/IGITUGraz/spore-nest-module
+#
+
+import numpy as np
+import nest
+import unittest
+
+
+def decimate(samples, max_samples, levels):
+    """Reference implementation of the bounded recorder."""
+    capacity = max_samples // levels
+    rings = [{"buffer": [None] * capacity, "start": 0, "size": 0, "pass_on": True} for _ in range(levels)]
+
+    def push(level, sample):
+        ring = rings[level]
+        if ring["size"] < capacity:
+            slot = (ring["start"] + ring["size"]) % capacity
+            ring["size"] += 1
+        else:
+            slot = ring["start"]
+            ring["start"] = (ring["start"] + 1) % capacity
+            if level + 1 < levels:
+                if ring["pass_on"]:
+                    push(level + 1, ring["buffer"][slot])
+                ring["pass_on"] = not ring["pass_on"]
+        ring["buffer"][slot] = sample
+
+    for sample in samples:
+        push(0, sample)
+
+    result = []
+    for ring in reversed(rings):
+        result += [ring["buffer"][(ring["start"] + k) % capacity] for k in range(ring["size"])]
+    return result
+
+
+class TestStringMethods(unittest.TestCase):
+
+    def run_synapse(self, recorder_status):
+        nest.ResetKernel()
+        nest.sli_func('InitSynapseUpdater', 100, 100)
+        nest.CopyModel("spore_test_node", "test_tracing_node", {"test_name": "test_tracing_node"})
+        nodes = nest.Create("test_tracing_node", 2)
+        nest.CopyModel("synaptic_sampling_rewardgradient_synapse", "test_synapse")
+        nest.SetDefaults("test_synapse", {"reward_transmitter": nodes[0], "weight_update_interval": 100.0,
+                                          "temperature": 0.1, "learning_rate": 0.0001, "episode_length": 100.0,
+                                          "max_param": 100.0, "min_param": -100.0, "max_param_change": 100.0,
+                                          "integration_time": 10000.0})
+        nest.Connect([nodes[0]], [nodes[1]], "one_to_one", {"model": "test_synapse"})
+        conns = nest.GetConnections([nodes[0]], [nodes[1]], "test_synapse")
+        recorder_status["recorder_interval"] = 100.0
+        nest.SetStatus(conns, recorder_status)
+
+        nest.Simulate(10000)
+
+        return nest.GetStatus(conns, ["recorder_times", "synaptic_parameter_values"])[0]
+
+    # test bounded recorders with and without decimation
+    def test_recorder_bounds(self):
+        times, values = self.run_synapse({})
+        self.assertGreater(len(times), 90)
+        samples = list(zip(times, values))
+
+        for max_samples, levels in [(20, 1), (20, 4), (30, 3)]:
+            b_times, b_values = self.run_synapse({"recorder_max_samples": max_samples,
+                                                  "recorder_decimation_levels": levels})
+            expected = decimate(samples, max_samples, levels)
+            self.assertLessEqual(len(b_times), max_samples)
+            self.assertTrue(np.allclose(b_times, [s[0] for s in expected]))
+            self.assertTrue(np.allclose(b_values, [s[1] for s in expected]))
+
+
+if __name__ == '__main__':
+    nest.Install("sporemodule")
+    unittest.main()
@@ -0,0 +1,105 @@
+#! /usr/bin/env python
+# -*- coding: utf-8 -*-
+
+#
+# This file is part of SPORE.
+#
+# Copyright (C) 2016, the SPORE team (see AUTHORS).
+#
+# SPORE is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# SPORE is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with SPORE.  If not, see <http://www.gnu.org/licenses/>.
+#
+# For more information see: https://github.com/IGITUGraz/spore-nest-module
+#
+
+import os
+import shutil
+import sys
+import tempfile
+
+import numpy as np
+import nest
+import unittest
+
+sys.path.append(os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "utils"))
+from spore_recorder import load_recorder_stream, recorder_stream_threads  # noqa: E402
+
+RECORDED = ["synaptic_parameter_values", "weight_values", "reward_gradient_values"]
+
+
+class TestStringMethods(unittest.TestCase):
+
+    def run_network(self, stream, data_path=None, overwrite=False):
+        nest.ResetKernel()
+        nest.SetKernelStatus({"local_num_threads": 2})
+        if data_path is not None:
+            nest.SetKernelStatus({"data_path": data_path, "data_prefix": "test_", "overwrite_files": overwrite})
+        nest.sli_func('InitSynapseUpdater', 100, 100)
+        nest.CopyModel("spore_test_node", "test_tracing_node", {"test_name": "test_tracing_node"})
+        nodes = nest.Create("test_tracing_node", 5)
+        nest.CopyModel("synaptic_sampling_rewardgradient_synapse", "test_synapse")
+        nest.SetDefaults("test_synapse", {"reward_transmitter": nodes[0], "weight_update_interval": 100.0,
+                                          "temperature": 0.1, "learning_rate": 0.0001, "episode_length": 100.0,
+                                          "max_param": 100.0, "min_param": -100.0, "max_param_change": 100.0,
+                                          "integration_time": 10000.0})
+        nest.Connect([nodes[0]], nodes[1:], "all_to_all", {"model": "test_synapse"})
+        conns = nest.GetConnections([nodes[0]], nodes[1:], "test_synapse")
+        nest.SetStatus(conns, {"recorder_interval": 200.0, "recorder_stream": stream})
+
+        nest.Simulate(2000)
+
+        return conns, nest.GetStatus(conns, ["recorder_port", "recorder_times"] + RECORDED)
+
+    # test streaming of synapse recordings
+    def test_recorder_stream(self):
+        data_path = tempfile.mkdtemp()
+        try:
+            conns, expected = self.run_network(False)
+            conns, status = self.run_network(True, data_path)
+
+            # streamed connections keep nothing in memory
+            for st in status:
+                self.assertEqual(len(st[1]), 0)
+
+            self.assertEqual(recorder_stream_threads(data_path, "test_"), [0, 1])
+
+            records = load_recorder_stream(data_path, "test_")
+            self.assertEqual(len(records), len(conns))
+
+            for st, exp in zip(status, expected):
+                rec = records[st[0]]
+                self.assertTrue(np.allclose(rec["recorder_times"], exp[1]))
+                for i, name in enumerate(RECORDED):
+                    self.assertTrue(np.allclose(rec[name], exp[2 + i]))
+        finally:
+            shutil.rmtree(data_path)
+
+    # streams are opened again after the kernel was reset and replace the old files
+    def test_recorder_stream_reset(self):
+        data_path = tempfile.mkdtemp()
+        try:
+            conns, expected = self.run_network(False)
+            for i in range(2):
+                conns, status = self.run_network(True, data_path, overwrite=True)
+
+            records = load_recorder_stream(data_path, "test_")
+            self.assertEqual(len(records), len(conns))
+            for st, exp in zip(status, expected):
+                self.assertTrue(np.allclose(records[st[0]]["recorder_times"], exp[1]))
+        finally:
+            shutil.rmtree(data_path)
+
+
+if __name__ == '__main__':
+    nest.Install("sporemodule")
+    unittest.main()
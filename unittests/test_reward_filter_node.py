@@ -0,0 +1,113 @@
+#! /usr/bin/env python
+# -*- coding: utf-8 -*-
+
+#
+# This file is part of SPORE.
+#
+# Copyright (C) 2016, the SPORE team (see AUTHORS).
+#
+# SPORE is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# SPORE is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with SPORE.  If not, see <http://www.gnu.org/licenses/>.
+#
+# For more information see: https://github.com/IGITUGraz/spore-nest-module
+#
+
+
+import nest
+import numpy as np
+import unittest
+
+
+N_STEPS = 500
+INTERVAL = 100
+
+
+def reference_filter(raw, mode, tau_b, offset, clip_min, clip_max, tau_lp, b_min=0.001):
+    gamma = np.exp(-1.0 / tau_b)
+    alpha = np.exp(-1.0 / tau_lp) if tau_lp > 0.0 else 0.0
+    baseline, filtered = 0.0, 0.0
+    result = np.zeros(len(raw))
+    for i, r in enumerate(raw):
+        if mode == "subtract":
+            baseline = gamma * baseline + (1 - gamma) * r
+            r = r - baseline + offset
+        elif mode == "divide":
+            baseline = max(gamma * baseline + (1 - gamma) * r, b_min)
+            r = r / baseline + offset
+        r = min(clip_max, max(clip_min, r))
+        filtered = alpha * filtered + (1 - alpha) * r
+        result[i] = filtered
+    return result
+
+
+class TestStringMethods(unittest.TestCase):
+
+    def run_filter(self, params):
+        nest.ResetKernel()
+        nest.SetKernelStatus({"resolution": 1.0})
+        nest.sli_func('InitSynapseUpdater', INTERVAL, 0)
+        nest.CopyModel("spore_test_node", "test_tracing_node", {"test_name": "test_tracing_node"})
+        source = nest.Create("test_tracing_node")
+        node = nest.Create("reward_filter_node")
+        params.update({"source": source[0], "source_trace_ids": [0, 2]})
+        nest.SetStatus(node, params)
+        nest.Simulate(float(N_STEPS))
+        return nest.GetStatus(node, "trace")[0]
+
+    def check_filter(self, mode, tau_b=50.0, offset=0.0, clip_min=-np.inf, clip_max=np.inf, tau_lp=0.0,
+                     b_min=0.001):
+        traces = self.run_filter({"baseline_mode": mode, "baseline_tau": tau_b, "reward_offset": offset,
+                                  "clip_min": clip_min, "clip_max": clip_max, "lowpass_tau": tau_lp,
+                                  "baseline_min": b_min})
+        self.assertEqual(len(traces), 2)
+        steps = np.arange(N_STEPS)
+        for channel, trace_id in enumerate((0, 2)):
+            # the test node writes step + trace_id, the filter reads one step late
+            raw = np.where(steps >= 1, steps - 1 + trace_id, 0.0)
+            expected = reference_filter(raw, mode, tau_b, offset, clip_min, clip_max, tau_lp, b_min)
+            self.assertTrue(np.allclose(traces[channel][:INTERVAL], expected[N_STEPS - INTERVAL:]))
+
+    def test_reward_filter_none(self):
+        self.check_filter("none")
+
+    def test_reward_filter_subtract(self):
+        self.check_filter("subtract", offset=0.5, clip_min=-20.0, clip_max=20.0)
+
+    def test_reward_filter_divide(self):
+        self.check_filter("divide", offset=0.1, tau_lp=20.0)
+        self.check_filter("divide", offset=0.1, b_min=5.0)
+
+    # negative rewards are divided by the bounded baseline and keep their sign
+    def test_reward_filter_divide_negative(self):
+        for clip_min, expected in ((-np.inf, -0.5 / 2.0 + 0.1), (0.0, 0.0)):
+            nest.ResetKernel()
+            nest.SetKernelStatus({"resolution": 1.0})
+            nest.sli_func('InitSynapseUpdater', INTERVAL, 0)
+            source = nest.Create("trace_generator_node", params={"mean": -0.5})
+            node = nest.Create("reward_filter_node", params={"source": source[0], "baseline_mode": "divide",
+                                                             "baseline_min": 2.0, "reward_offset": 0.1,
+                                                             "clip_min": clip_min})
+            nest.Simulate(float(N_STEPS))
+            trace = nest.GetStatus(node, "trace")[0][0]
+            self.assertTrue(np.allclose(trace[:INTERVAL], expected))
+
+    def test_reward_filter_bad_mode(self):
+        nest.ResetKernel()
+        node = nest.Create("reward_filter_node")
+        self.assertRaises(nest.NESTError, nest.SetStatus, node, {"baseline_mode": "median"})
+        self.assertRaises(nest.NESTError, nest.SetStatus, node, {"baseline_min": 0.0})
+
+
+if __name__ == '__main__':
+    nest.Install("sporemodule")
+    unittest.main()
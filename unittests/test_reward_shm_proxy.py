@@ -0,0 +1,135 @@
+#! /usr/bin/env python
+# -*- coding: utf-8 -*-
+
+#
+# This file is part of SPORE.
+#
+# Copyright (C) 2016, the SPORE team (see AUTHORS).
+#
+# SPORE is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# SPORE is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with SPORE.  If not, see <http://www.gnu.org/licenses/>.
+#
+# For more information see: https://github.com/IGITUGraz/spore-nest-module
+#
+
+import os
+import sys
+import nest
+import numpy as np
+import unittest
+
+sys.path.append(os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "utils"))
+from spore_shm import RewardShmWriter  # noqa: E402
+
+
+N_STEPS = 500
+
+
+class TestStringMethods(unittest.TestCase):
+
+    def setUp(self):
+        nest.ResetKernel()
+        nest.SetKernelStatus({"resolution": 1.0})
+        nest.sli_func('InitSynapseUpdater', N_STEPS, 0)
+        self.shm_name = "/spore_test_reward_%d" % os.getpid()
+
+    def create_proxy(self, n_channels, piecewise_constant=True, replicate_traces=False):
+        proxy = nest.Create("reward_shm_proxy")
+        nest.SetStatus(proxy, {"shm_name": self.shm_name, "n_channels": n_channels, "buffer_size": 2 * N_STEPS,
+                               "piecewise_constant": piecewise_constant, "replicate_traces": replicate_traces})
+        return proxy
+
+    # every step is written by the producer
+    def test_reward_shm_proxy_dense(self):
+        self.run_dense(piecewise_constant=True)
+
+    # same as above but traces hold one value per time step
+    def test_reward_shm_proxy_dense_traces(self):
+        self.run_dense(piecewise_constant=False)
+
+    def run_dense(self, piecewise_constant):
+        writer = RewardShmWriter(self.shm_name, n_channels=2, buffer_size=2 * N_STEPS)
+        proxy = self.create_proxy(2, piecewise_constant)
+
+        for step in range(N_STEPS):
+            writer.write(step, (0.5 * step, -1.0 * step))
+
+        nest.Simulate(float(N_STEPS))
+        traces = nest.GetStatus(proxy, "trace")[0]
+        self.assertEqual(nest.GetStatus(proxy, "consumed")[0], N_STEPS)
+
+        writer.close(unlink=True)
+
+        self.assertEqual(len(traces), 2)
+        for channel, scale in enumerate((0.5, -1.0)):
+            self.assertEqual(len(traces[channel]), N_STEPS + 1)
+            self.assertTrue(np.allclose(traces[channel][:N_STEPS], scale * np.arange(N_STEPS)))
+
+    # values are held until the next entry is due
+    def test_reward_shm_proxy_sparse(self):
+        proxy = self.create_proxy(1)
+        nest.Simulate(1.0)  # the proxy creates the segment
+
+        writer = RewardShmWriter(self.shm_name, n_channels=1)
+        writer.write(100, 1.0)
+        writer.write(300, 2.0)
+
+        nest.Simulate(float(N_STEPS - 1))
+        trace = np.array(nest.GetStatus(proxy, "trace")[0][0])
+
+        writer.close(unlink=True)
+
+        self.assertTrue(np.all(trace[:100] == 0.0))
+        self.assertTrue(np.all(trace[100:300] == 1.0))
+        self.assertTrue(np.all(trace[300:N_STEPS] == 2.0))
+
+    # synapses on all threads must see the same rewards if traces are replicated
+    def test_reward_shm_proxy_replicated(self):
+        for piecewise_constant in (True, False):
+            reference = self.run_network(piecewise_constant, replicate_traces=False)
+            replicated = self.run_network(piecewise_constant, replicate_traces=True)
+            self.assertTrue(np.any(reference != reference[0]))
+            self.assertTrue(np.allclose(reference, replicated))
+
+    def run_network(self, piecewise_constant, replicate_traces):
+        nest.ResetKernel()
+        nest.SetKernelStatus({"resolution": 1.0, "local_num_threads": 2, "grng_seed": 1, "rng_seeds": [2, 3]})
+        nest.sli_func('InitSynapseUpdater', 100, 100)
+
+        writer = RewardShmWriter(self.shm_name, n_channels=1, buffer_size=2 * N_STEPS)
+        proxy = self.create_proxy(1, piecewise_constant, replicate_traces)
+        for step in range(0, N_STEPS, 25):
+            writer.write(step, float(step % 100) / 50.0 - 1.0)
+
+        generator = nest.Create("poisson_generator", params={"rate": 50.0})
+        pre = nest.Create("parrot_neuron", 4)
+        post = nest.Create("poisson_dbl_exp_neuron", 4)
+        nest.Connect(generator, pre)
+
+        nest.CopyModel("synaptic_sampling_rewardgradient_synapse", "test_synapse")
+        nest.SetDefaults("test_synapse", {"reward_transmitter": proxy[0], "temperature": 0.0,
+                                          "synaptic_parameter": 3.0, "learning_rate": 0.001,
+                                          "episode_length": 100.0, "weight_update_interval": 100.0})
+        nest.Connect(pre, post, "all_to_all", {"model": "test_synapse"})
+
+        nest.Simulate(float(N_STEPS))
+        writer.close(unlink=True)
+
+        conns = nest.GetConnections(pre, post, "test_synapse")
+        results = nest.GetStatus(conns, ["source", "target", "synaptic_parameter"])
+        return np.array([p for (s, t, p) in sorted(results)])
+
+
+if __name__ == '__main__':
+    nest.Install("sporemodule")
+    unittest.main()
@@ -30,7 +30,8 @@ import unittest
 class TestStringMethods(unittest.TestCase):
 
     # test connection
-    def spore_connection_test(self, resolution, interval, delay, exp_len, synapse_properties, times, values):
+    def spore_connection_test(self, resolution, interval, delay, exp_len, synapse_properties, times, values,
+                              model="synaptic_sampling_rewardgradient_synapse"):
 
         nest.ResetKernel()
         nest.SetKernelStatus({"resolution": resolution})
@@ -38,7 +39,7 @@ class TestStringMethods(unittest.TestCase):
         nest.CopyModel("spore_test_node", "test_tracing_node", {"test_name": "test_tracing_node"})
         nodes = nest.Create("test_tracing_node", 2)
         synapse_properties["reward_transmitter"] = nodes[0]
-        nest.CopyModel("synaptic_sampling_rewardgradient_synapse", "test_synapse")
+        nest.CopyModel(model, "test_synapse")
         nest.SetDefaults("test_synapse", synapse_properties)
         nest.Connect([nodes[0]], [nodes[1]], "one_to_one", {"model": "test_synapse"})
         conns = nest.GetConnections([nodes[0]], [nodes[1]], "test_synapse")
@@ -89,6 +90,8 @@ class TestStringMethods(unittest.TestCase):
                   0.3734642804542696, 0.3697296376497269)
 
         self.spore_connection_test(1.0, 100, 100, 10000.0, synapse_properties, times, values)
+        self.spore_connection_test(1.0, 100, 100, 10000.0, synapse_properties, times, values,
+                                   "synaptic_sampling_rewardgradient_synapse_hpc_fixed")
 
 
 if __name__ == '__main__':
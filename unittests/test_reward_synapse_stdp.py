@@ -30,7 +30,8 @@ import unittest
 class TestStringMethods(unittest.TestCase):
 
     # test connection
-    def spore_connection_test(self, resolution, interval, delay, exp_len):
+    def spore_connection_test(self, resolution, interval, delay, exp_len,
+                              model="synaptic_sampling_rewardgradient_synapse"):
 
         spike_times_in = [10.0, 15.0, 20.0, 25.0, 50.0]
         spike_times_out = [40.0, 50.0, 60.0, 70.0]
@@ -54,7 +55,7 @@ class TestStringMethods(unittest.TestCase):
         nout = nest.Create("test_pulse_trace")
 
         nodes = nest.Create("test_pulse_trace", 1)
-        nest.CopyModel("synaptic_sampling_rewardgradient_synapse", "test_synapse")
+        nest.CopyModel(model, "test_synapse")
         synapse_properties["reward_transmitter"] = nodes[0]
         nest.SetDefaults("test_synapse", synapse_properties)
         nest.Connect([gin[0]], [nout[0]], "one_to_one", {"model": "test_synapse"})
@@ -104,6 +105,10 @@ class TestStringMethods(unittest.TestCase):
     def test_reward_synapse(self):
         self.spore_connection_test(1.0, 100, 100, 10000.0)
 
+    # fixed point storage of the synaptic parameter follows the same trajectory
+    def test_reward_synapse_fixed(self):
+        self.spore_connection_test(1.0, 100, 100, 10000.0, "synaptic_sampling_rewardgradient_synapse_hpc_fixed")
+
 
 if __name__ == '__main__':
     nest.Install("sporemodule")
@@ -0,0 +1,92 @@
+#! /usr/bin/env python
+# -*- coding: utf-8 -*-
+
+#
+# This file is part of SPORE.
+#
+# Copyright (C) 2016, the SPORE team (see AUTHORS).
+#
+# SPORE is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# SPORE is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with SPORE.  If not, see <http://www.gnu.org/licenses/>.
+#
+# For more information see: https://github.com/IGITUGraz/spore-nest-module
+#
+
+import nest
+import unittest
+
+
+class TestStringMethods(unittest.TestCase):
+
+    def create_network(self, num_threads):
+        nest.ResetKernel()
+        nest.SetKernelStatus({"local_num_threads": num_threads})
+        nest.sli_func('InitSynapseUpdater', 100, 100)
+        nest.CopyModel("spore_test_node", "test_tracing_node", {"test_name": "test_tracing_node"})
+        nodes = nest.Create("test_tracing_node", 10)
+        nest.CopyModel("synaptic_sampling_rewardgradient_synapse", "test_synapse")
+        nest.SetDefaults("test_synapse", {"reward_transmitter": nodes[0], "temperature": 0.1,
+                                          "learning_rate": 0.0001})
+        nest.Connect(nodes[:5], nodes[5:], "all_to_all", {"model": "test_synapse"})
+
+        # retract the synapses of the first source
+        conns = nest.GetConnections([nodes[0]], synapse_model="test_synapse")
+        nest.SetStatus(conns, {"synaptic_parameter": -1.0})
+        return nodes
+
+    # synapses are replaced by static synapses with their current weight
+    def test_convert_to_static(self):
+        for num_threads in (1, 3):
+            nodes = self.create_network(num_threads)
+            nest.Simulate(1000)
+
+            conns = nest.GetConnections(synapse_model="test_synapse")
+            status = nest.GetStatus(conns, ["source", "target", "weight", "delay"])
+            expected = sorted(st for st in status if st[2] > 0.0)
+
+            result = nest.sli_func('ConvertToStaticSynapses', "test_synapse", "static_synapse")
+            self.assertEqual(result["created"], len(expected))
+            self.assertEqual(result["dropped"], 25 - len(expected))
+
+            self.assertEqual(len(nest.GetConnections(synapse_model="test_synapse")), 0)
+            self.assertEqual(nest.sli_func('GetSporeStatus')["num_connectors"], 0)
+
+            conns = nest.GetConnections(synapse_model="static_synapse")
+            status = sorted(nest.GetStatus(conns, ["source", "target", "weight", "delay"]))
+            self.assertEqual(len(status), len(expected))
+            for st, ex in zip(status, expected):
+                self.assertEqual(st[:2], ex[:2])
+                self.assertAlmostEqual(st[2], ex[2])
+                self.assertAlmostEqual(st[3], ex[3])
+
+            nest.Simulate(1000)
+
+    # synapses that were never updated get the weight of their synaptic parameter
+    def test_convert_to_static_new_synapses(self):
+        self.create_network(1)
+        result = nest.sli_func('ConvertToStaticSynapses', "test_synapse", "static_synapse")
+        self.assertEqual(result["created"], 20)
+        self.assertEqual(result["dropped"], 5)
+
+    # only synaptic sampling synapse models can be converted
+    def test_convert_to_static_invalid_model(self):
+        self.create_network(1)
+        with self.assertRaises(nest.NESTError):
+            nest.sli_func('ConvertToStaticSynapses', "static_synapse", "static_synapse")
+        with self.assertRaises(nest.NESTError):
+            nest.sli_func('ConvertToStaticSynapses', "test_synapse", "no_such_synapse")
+
+
+if __name__ == '__main__':
+    nest.Install("sporemodule")
+    unittest.main()
@@ -0,0 +1,99 @@
+#! /usr/bin/env python
+# -*- coding: utf-8 -*-
+
+#
+# This file is part of SPORE.
+#
+# Copyright (C) 2016, the SPORE team (see AUTHORS).
+#
+# SPORE is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# SPORE is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with SPORE.  If not, see <http://www.gnu.org/licenses/>.
+#
+# For more information see: https://github.com/IGITUGraz/spore-nest-module
+#
+
+import numpy as np
+import nest
+import unittest
+
+BINS = 8
+RANGES = {"weight": (0.0, 2.0), "synaptic_parameter": (-1.0, 3.0), "reward_gradient": (-0.5, 0.5)}
+
+
+class TestStringMethods(unittest.TestCase):
+
+    # test aggregate statistics of synapse models
+    def test_synapse_aggregates(self):
+        nest.ResetKernel()
+        nest.SetKernelStatus({"local_num_threads": 2})
+        nest.sli_func('InitSynapseUpdater', 100, 100)
+        nest.CopyModel("spore_test_node", "test_tracing_node", {"test_name": "test_tracing_node"})
+        nodes = nest.Create("test_tracing_node", 7)
+        nest.CopyModel("synaptic_sampling_rewardgradient_synapse", "test_synapse")
+        defaults = {"reward_transmitter": nodes[0], "weight_update_interval": 100.0, "temperature": 0.5,
+                    "learning_rate": 0.0001, "episode_length": 100.0, "integration_time": 10000.0,
+                    "aggregate_interval": 200.0, "aggregate_bins": BINS}
+        for name, (lower, upper) in RANGES.items():
+            defaults[name + "_histogram_min"] = lower
+            defaults[name + "_histogram_max"] = upper
+        nest.SetDefaults("test_synapse", defaults)
+        nest.Connect([nodes[0]], nodes[1:], "all_to_all", {"model": "test_synapse"})
+        conns = nest.GetConnections([nodes[0]], nodes[1:], "test_synapse")
+        nest.SetStatus(conns, [{"recorder_interval": 200.0, "synaptic_parameter": p}
+                               for p in np.linspace(-1.0, 2.0, len(conns))])
+
+        nest.Simulate(3000)
+
+        aggregates = nest.sli_func('GetSynapseAggregates', "test_synapse")
+        recorded = nest.GetStatus(conns, ["recorder_times", "weight_values",
+                                          "synaptic_parameter_values", "reward_gradient_values"])
+
+        self.assertEqual(aggregates["aggregate_times"][0], 0.0)
+
+        checked = 0
+        for k, t in enumerate(aggregates["aggregate_times"]):
+            if aggregates["aggregate_counts"][k] < len(conns):
+                continue
+
+            samples = {"weight": [], "synaptic_parameter": [], "reward_gradient": []}
+            for times, w, p, g in recorded:
+                idx = list(times).index(t)
+                samples["weight"].append(w[idx])
+                samples["synaptic_parameter"].append(p[idx])
+                samples["reward_gradient"].append(g[idx])
+
+            self.assertEqual(aggregates["retracted_counts"][k], np.sum(np.array(samples["weight"]) == 0.0))
+
+            for name, values in samples.items():
+                values = np.array(values)
+                lower, upper = RANGES[name]
+                bins = np.clip(np.floor((values - lower) / (upper - lower) * BINS).astype(int), 0, BINS - 1)
+                self.assertAlmostEqual(aggregates[name]["mean"][k], np.mean(values))
+                self.assertAlmostEqual(aggregates[name]["variance"][k], np.var(values))
+                self.assertEqual(list(aggregates[name]["histogram"][k]), list(np.bincount(bins, minlength=BINS)))
+                self.assertEqual(list(aggregates[name]["histogram_range"]), [lower, upper])
+            checked += 1
+
+        self.assertGreater(checked, 10)
+
+        # time points are returned once, later calls return the following ones
+        nest.Simulate(1000)
+        later = nest.sli_func('GetSynapseAggregates', "test_synapse")
+        self.assertGreater(len(later["aggregate_times"]), 0)
+        self.assertGreater(min(later["aggregate_times"]), max(aggregates["aggregate_times"]))
+        self.assertEqual(len(later["aggregate_times"]), len(set(later["aggregate_times"])))
+
+
+if __name__ == '__main__':
+    nest.Install("sporemodule")
+    unittest.main()
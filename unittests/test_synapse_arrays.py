@@ -0,0 +1,75 @@
+#! /usr/bin/env python
+# -*- coding: utf-8 -*-
+
+#
+# This file is part of SPORE.
+#
+# Copyright (C) 2016, the SPORE team (see AUTHORS).
+#
+# SPORE is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# SPORE is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with SPORE.  If not, see <http://www.gnu.org/licenses/>.
+#
+# For more information see: https://github.com/IGITUGraz/spore-nest-module
+#
+
+import nest
+import unittest
+
+
+class TestStringMethods(unittest.TestCase):
+
+    # bulk arrays must match the status of the individual connections
+    def test_synapse_arrays(self):
+        nest.ResetKernel()
+        nest.SetKernelStatus({"local_num_threads": 2})
+        nest.sli_func('InitSynapseUpdater', 100, 100)
+        nest.CopyModel("spore_test_node", "test_tracing_node", {"test_name": "test_tracing_node"})
+        nodes = nest.Create("test_tracing_node", 6)
+        nest.CopyModel("synaptic_sampling_rewardgradient_synapse", "test_synapse")
+        nest.CopyModel("synaptic_sampling_rewardgradient_synapse", "other_synapse")
+        nest.SetDefaults("test_synapse", {"reward_transmitter": nodes[0], "temperature": 0.1,
+                                          "learning_rate": 0.0001})
+        nest.SetDefaults("other_synapse", {"reward_transmitter": nodes[0]})
+        nest.Connect(nodes[:3], nodes[3:], "all_to_all", {"model": "test_synapse"})
+        nest.Connect([nodes[0]], nodes[1:3], "all_to_all", {"model": "other_synapse"})
+
+        nest.Simulate(1000)
+
+        arrays = nest.sli_func('GetSynapseArrays', "test_synapse")
+        conns = nest.GetConnections(synapse_model="test_synapse")
+        status = nest.GetStatus(conns, ["source", "target", "weight", "synaptic_parameter",
+                                        "eligibility_trace", "reward_gradient"])
+
+        self.assertEqual(len(arrays["source"]), len(conns))
+        index = dict(((s, t), k) for k, (s, t) in enumerate(zip(arrays["source"], arrays["target"])))
+        self.assertEqual(len(index), len(conns))
+
+        for st in status:
+            k = index[(st[0], st[1])]
+            self.assertAlmostEqual(arrays["weight"][k], st[2])
+            self.assertAlmostEqual(arrays["synaptic_parameter"][k], st[3])
+            self.assertAlmostEqual(arrays["eligibility_trace"][k], st[4])
+            self.assertAlmostEqual(arrays["reward_gradient"][k], st[5])
+
+        self.assertEqual(len(nest.sli_func('GetSynapseArrays', "other_synapse")["source"]), 2)
+
+    # only synaptic sampling synapse models can be read
+    def test_synapse_arrays_invalid_model(self):
+        nest.ResetKernel()
+        with self.assertRaises(nest.NESTError):
+            nest.sli_func('GetSynapseArrays', "static_synapse")
+
+
+if __name__ == '__main__':
+    nest.Install("sporemodule")
+    unittest.main()
@@ -0,0 +1,134 @@
+#! /usr/bin/env python
+# -*- coding: utf-8 -*-
+
+#
+# This file is part of SPORE.
+#
+# Copyright (C) 2016, the SPORE team (see AUTHORS).
+#
+# SPORE is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# SPORE is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with SPORE.  If not, see <http://www.gnu.org/licenses/>.
+#
+# For more information see: https://github.com/IGITUGraz/spore-nest-module
+#
+
+import nest
+import numpy as np
+import unittest
+
+
+class TestStringMethods(unittest.TestCase):
+
+    def create_network(self, num_threads, n=20):
+        nest.ResetKernel()
+        nest.SetKernelStatus({"local_num_threads": num_threads})
+        nest.sli_func('InitSynapseUpdater', 100, 100)
+        nest.CopyModel("spore_test_node", "test_tracing_node", {"test_name": "test_tracing_node"})
+        nodes = nest.Create("test_tracing_node", 2 * n)
+        nest.CopyModel("synaptic_sampling_rewardgradient_synapse", "test_synapse")
+        nest.Connect(nodes[:n], nodes[n:], "all_to_all", {"model": "test_synapse"})
+        return nest.GetConnections(synapse_model="test_synapse")
+
+    def get_values(self, conns):
+        status = nest.GetStatus(conns, ["source", "target", "synaptic_parameter", "prior_mean", "prior_precision"])
+        return dict(((st[0], st[1]), st[2:]) for st in status)
+
+    # values given as arrays must end up at the aligned connections
+    def test_set_synapse_arrays(self):
+        conns = self.create_network(2)
+        ids = np.array(conns)
+        n = len(ids)
+
+        nest.sli_func('SetSynapseArrays', "test_synapse",
+                      {"source": ids[:, 0], "target_thread": ids[:, 2], "port": ids[:, 4],
+                       "synaptic_parameter": 0.01 * np.arange(n, dtype=float),
+                       "prior_mean": -0.5 * np.arange(n, dtype=float)})
+
+        status = nest.GetStatus(conns, ["synaptic_parameter", "prior_mean", "prior_precision"])
+        for k, st in enumerate(status):
+            self.assertAlmostEqual(st[0], 0.01 * k)
+            self.assertAlmostEqual(st[1], -0.5 * k)
+            self.assertAlmostEqual(st[2], 1.0)
+
+    # connections given by target are found after connections were added out of order
+    def test_set_synapse_arrays_by_target(self):
+        n = 10
+        conns = self.create_network(2, n)
+        ids = np.array(conns)
+        values = 0.01 * np.arange(len(ids), dtype=float)
+        expected = dict(((s, t), v) for (s, t), v in zip(ids[:, :2], values))
+
+        # the new connections precede all others in their connectors
+        nodes = sorted(set(ids[:, 0]))
+        nest.Connect(nodes, [nodes[0]], "all_to_all", {"model": "test_synapse"})
+
+        nest.sli_func('SetSynapseArrays', "test_synapse",
+                      {"source": ids[:, 0], "target": ids[:, 1], "target_thread": ids[:, 2],
+                       "synaptic_parameter": values})
+
+        status = self.get_values(nest.GetConnections(synapse_model="test_synapse"))
+        for key, v in expected.items():
+            self.assertAlmostEqual(status[key][0], v)
+
+    # random values must not depend on the number of threads
+    def test_set_synapse_distribution(self):
+        spec = {"synaptic_parameter": {"distribution": "normal", "mu": 1.0, "sigma": 0.5},
+                "prior_mean": {"distribution": "uniform", "low": -1.0, "high": 1.0},
+                "prior_precision": 2.0, "seed": 5}
+
+        values = []
+        for num_threads in (1, 2):
+            conns = self.create_network(num_threads, 40)
+            nest.sli_func('SetSynapseArrays', "test_synapse", spec)
+            values.append(self.get_values(conns))
+
+        self.assertEqual(sorted(values[0].keys()), sorted(values[1].keys()))
+        for key, v in values[0].items():
+            self.assertTrue(np.allclose(v, values[1][key]))
+
+        v = np.array(list(values[0].values()))
+        self.assertAlmostEqual(np.mean(v[:, 0]), 1.0, delta=0.05)
+        self.assertAlmostEqual(np.std(v[:, 0]), 0.5, delta=0.05)
+        self.assertTrue(np.all(v[:, 1] >= -1.0) and np.all(v[:, 1] < 1.0))
+        self.assertTrue(np.all(v[:, 2] == 2.0))
+
+        # a different seed gives different values
+        conns = self.create_network(1, 40)
+        spec["seed"] = 6
+        nest.sli_func('SetSynapseArrays', "test_synapse", spec)
+        other = self.get_values(conns)
+        self.assertFalse(np.allclose([v[0] for v in other.values()],
+                                     [values[0][key][0] for key in other.keys()]))
+
+    # nothing is changed if a connection does not exist
+    def test_set_synapse_arrays_invalid(self):
+        conns = self.create_network(2, 3)
+        ids = np.array(conns)
+        ports = ids[:, 4].copy()
+        ports[-1] = 100
+        before = nest.GetStatus(conns, "synaptic_parameter")
+
+        with self.assertRaises(nest.NESTError):
+            nest.sli_func('SetSynapseArrays', "test_synapse",
+                          {"source": ids[:, 0], "target_thread": ids[:, 2], "port": ports,
+                           "synaptic_parameter": np.ones(len(ids))})
+
+        with self.assertRaises(nest.NESTError):
+            nest.sli_func('SetSynapseArrays', "test_synapse", {"synaptic_parameter": np.ones(len(ids))})
+
+        self.assertEqual(nest.GetStatus(conns, "synaptic_parameter"), before)
+
+
+if __name__ == '__main__':
+    nest.Install("sporemodule")
+    unittest.main()
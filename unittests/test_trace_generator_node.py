@@ -0,0 +1,163 @@
+#! /usr/bin/env python
+# -*- coding: utf-8 -*-
+
+#
+# This file is part of SPORE.
+#
+# Copyright (C) 2016, the SPORE team (see AUTHORS).
+#
+# SPORE is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# SPORE is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with SPORE.  If not, see <http://www.gnu.org/licenses/>.
+#
+# For more information see: https://github.com/IGITUGraz/spore-nest-module
+#
+
+
+
+import nest
+import numpy as np
+import unittest
+
+
+N_STEPS = 500
+INTERVAL = 100
+
+
+class TestStringMethods(unittest.TestCase):
+
+    def run_generator(self, params):
+        nest.ResetKernel()
+        nest.SetKernelStatus({"resolution": 1.0, "grng_seed": 1, "rng_seeds": [2]})
+        nest.sli_func('InitSynapseUpdater', INTERVAL, 0)
+        self.node = nest.Create("trace_generator_node", params=params)
+        nest.Simulate(float(N_STEPS))
+        return np.array(nest.GetStatus(self.node, "trace")[0])
+
+    def test_constant(self):
+        for piecewise_constant in (False, True):
+            traces = self.run_generator({"signal": "constant", "mean": 0.25, "n_channels": 3,
+                                         "piecewise_constant": piecewise_constant})
+            self.assertEqual(traces.shape[0], 3)
+            self.assertTrue(np.all(traces[:, :INTERVAL] == 0.25))
+
+    def test_schedule(self):
+        traces = self.run_generator({"signal": "schedule", "mean": -1.0, "piecewise_constant": True,
+                                     "schedule_times": [100.0, 420.0, 450.0],
+                                     "schedule_values": [1.0, 2.0, 3.0]})
+        steps = np.arange(N_STEPS - INTERVAL, N_STEPS)
+        expected = np.where(steps >= 450, 3.0, np.where(steps >= 420, 2.0, 1.0))
+        self.assertTrue(np.all(traces[0][:INTERVAL] == expected))
+
+    # the schedule can be replaced by a shorter one between simulations
+    def test_schedule_change(self):
+        self.run_generator({"signal": "schedule", "piecewise_constant": True,
+                            "schedule_times": [100.0, 420.0, 450.0],
+                            "schedule_values": [1.0, 2.0, 3.0]})
+        nest.SetStatus(self.node, {"schedule_times": [100.0], "schedule_values": [5.0]})
+        nest.Simulate(float(N_STEPS))
+        traces = np.array(nest.GetStatus(self.node, "trace")[0])
+        self.assertTrue(np.all(traces[0][:INTERVAL] == 5.0))
+
+    def test_poisson(self):
+        traces = self.run_generator({"signal": "poisson", "mean": 0.5, "amplitude": 1.0, "rate": 50.0,
+                                     "pulse_duration": 5.0, "n_channels": 20, "piecewise_constant": True})
+        values = traces[:, :INTERVAL]
+        self.assertTrue(np.all((values == 0.5) | (values == 1.5)))
+        # expected fraction of time steps within a pulse is 1 - exp(-rate * pulse_duration)
+        fraction = np.mean(values == 1.5)
+        self.assertTrue(0.1 < fraction < 0.35)
+
+    # pulses start when the rate is raised from 0
+    def test_poisson_rate_change(self):
+        traces = self.run_generator({"signal": "poisson", "mean": 0.5, "amplitude": 1.0, "rate": 0.0,
+                                     "pulse_duration": 5.0, "n_channels": 20, "piecewise_constant": True})
+        self.assertTrue(np.all(traces[:, :INTERVAL] == 0.5))
+
+        nest.SetStatus(self.node, {"rate": 50.0})
+        nest.Simulate(float(N_STEPS))
+        traces = np.array(nest.GetStatus(self.node, "trace")[0])
+        fraction = np.mean(traces[:, :INTERVAL] == 1.5)
+        self.assertTrue(0.1 < fraction < 0.35)
+
+    def test_ornstein_uhlenbeck(self):
+        traces = self.run_generator({"signal": "ornstein_uhlenbeck", "mean": 1.0, "tau": 10.0, "sigma": 2.0,
+                                     "n_channels": 50})
+        values = traces[:, :INTERVAL]
+        self.assertTrue(abs(np.mean(values) - 1.0) < 0.5)
+        self.assertTrue(abs(np.std(values) - 2.0) < 0.4)
+
+    def test_bad_parameters(self):
+        nest.ResetKernel()
+        node = nest.Create("trace_generator_node")
+        self.assertRaises(nest.NESTError, nest.SetStatus, node, {"signal": "sawtooth"})
+        self.assertRaises(nest.NESTError, nest.SetStatus, node, {"tau": 0.0})
+        self.assertRaises(nest.NESTError, nest.SetStatus, node, {"schedule_times": [10.0, 5.0],
+                                                                 "schedule_values": [1.0, 2.0]})
+        self.assertRaises(nest.NESTError, nest.SetStatus, node, {"schedule_times": [10.0],
+                                                                 "schedule_values": []})
+
+    def test_reward_transmitter(self):
+        nest.ResetKernel()
+        nest.SetKernelStatus({"resolution": 1.0, "local_num_threads": 2, "grng_seed": 1, "rng_seeds": [2, 3]})
+        nest.sli_func('InitSynapseUpdater', 100, 100)
+
+        reward = nest.Create("trace_generator_node", params={"signal": "poisson", "rate": 20.0,
+                                                             "pulse_duration": 10.0, "piecewise_constant": True,
+                                                             "replicate_traces": True})
+        generator = nest.Create("poisson_generator", params={"rate": 50.0})
+        pre = nest.Create("parrot_neuron", 4)
+        post = nest.Create("poisson_dbl_exp_neuron", 4)
+        nest.Connect(generator, pre)
+
+        nest.CopyModel("synaptic_sampling_rewardgradient_synapse", "test_synapse")
+        nest.SetDefaults("test_synapse", {"reward_transmitter": reward[0], "temperature": 0.0,
+                                          "synaptic_parameter": 3.0, "learning_rate": 0.001,
+                                          "episode_length": 100.0, "weight_update_interval": 100.0})
+        nest.Connect(pre, post, "all_to_all", {"model": "test_synapse"})
+
+        nest.Simulate(float(N_STEPS))
+
+        conns = nest.GetConnections(pre, post, "test_synapse")
+        parameters = np.array(nest.GetStatus(conns, "synaptic_parameter"))
+        self.assertTrue(np.all(np.isfinite(parameters)))
+        self.assertTrue(np.any(parameters != 3.0))
+
+    # constant rewards are integrated in closed form, also without decay of the eligibility trace
+    def test_direct_gradient_no_decay(self):
+        nest.ResetKernel()
+        nest.SetKernelStatus({"resolution": 1.0, "grng_seed": 1, "rng_seeds": [2]})
+        nest.sli_func('InitSynapseUpdater', 100, 100)
+
+        reward = nest.Create("trace_generator_node", params={"mean": 1.0, "piecewise_constant": True})
+        generator = nest.Create("poisson_generator", params={"rate": 5.0})
+        pre = nest.Create("parrot_neuron", 4)
+        post = nest.Create("poisson_dbl_exp_neuron", 4)
+        nest.Connect(generator, pre)
+
+        nest.CopyModel("synaptic_sampling_rewardgradient_synapse", "test_synapse")
+        nest.SetDefaults("test_synapse", {"reward_transmitter": reward[0], "temperature": 0.0,
+                                          "synaptic_parameter": 3.0, "learning_rate": 0.001,
+                                          "episode_length": 1e20, "direct_gradient_rate": 1.0,
+                                          "weight_update_interval": 100.0})
+        nest.Connect(pre, post, "all_to_all", {"model": "test_synapse"})
+
+        nest.Simulate(float(N_STEPS))
+
+        conns = nest.GetConnections(pre, post, "test_synapse")
+        parameters = np.array(nest.GetStatus(conns, "synaptic_parameter"))
+        self.assertTrue(np.all(np.isfinite(parameters)))
+
+
+if __name__ == '__main__':
+    nest.Install("sporemodule")
+    unittest.main()
@@ -0,0 +1,58 @@
+#! /usr/bin/env python
+# -*- coding: utf-8 -*-
+
+#
+# This file is part of SPORE.
+#
+# Copyright (C) 2016, the SPORE team (see AUTHORS).
+#
+# SPORE is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# SPORE is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with SPORE.  If not, see <http://www.gnu.org/licenses/>.
+#
+# For more information see: https://github.com/IGITUGraz/spore-nest-module
+#
+
+import nest
+import unittest
+
+
+class TestStringMethods(unittest.TestCase):
+
+    def simulate(self, target_ordered):
+        nest.ResetKernel()
+        nest.SetKernelStatus({"local_num_threads": 2})
+        nest.sli_func('InitSynapseUpdater', 100, 100)
+        nest.sli_func('SetSporeStatus', {"target_ordered_updates": target_ordered})
+        nest.CopyModel("spore_test_node", "test_tracing_node", {"test_name": "test_tracing_node"})
+        nodes = nest.Create("test_tracing_node", 8)
+        nest.CopyModel("synaptic_sampling_rewardgradient_synapse", "test_synapse")
+        nest.SetDefaults("test_synapse", {"reward_transmitter": nodes[0], "temperature": 0.0,
+                                          "gradient_noise": 0.0, "learning_rate": 0.0001})
+        nest.Connect(nodes[:4], nodes[4:], "all_to_all", {"model": "test_synapse"})
+        nest.Connect(nodes[4:], nodes[:4], {"rule": "fixed_indegree", "indegree": 2},
+                     {"model": "test_synapse"})
+        nest.Simulate(2000)
+        self.assertEqual(nest.sli_func('GetSporeStatus')["target_ordered_updates"], target_ordered)
+        return nest.sli_func('GetSynapseArrays', "test_synapse")
+
+    # updates in the order of targets give the same result as updates by connector
+    def test_update_order(self):
+        by_connector = self.simulate(False)
+        by_target = self.simulate(True)
+        for key in ("synaptic_parameter", "weight", "eligibility_trace"):
+            self.assertEqual(list(by_target[key]), list(by_connector[key]))
+
+
+if __name__ == '__main__':
+    nest.Install("sporemodule")
+    unittest.main()
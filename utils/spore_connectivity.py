@@ -0,0 +1,77 @@
+#! /usr/bin/env python
+# -*- coding: utf-8 -*-
+
+#
+# This file is part of SPORE.
+#
+# Copyright (C) 2016, the SPORE team (see AUTHORS).
+#
+# SPORE is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# SPORE is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with SPORE.  If not, see <http://www.gnu.org/licenses/>.
+#
+# For more information see: https://github.com/IGITUGraz/spore-nest-module
+#
+
+"""
+Python helpers to write connectivity files for the SLI function LoadConnectivity.
+
+A connectivity file holds a 64 byte header followed by one record per
+connection with the GIDs of source and target, the initial synaptic
+parameter and the delay (see connectivity_file.h). NaN values select the
+defaults of the synapse model. write_connectivity writes such a file and
+load_connectivity creates the connections in NEST.
+"""
+
+import struct
+
+import numpy as np
+
+CONNECTIVITY_MAGIC = b"SPORECON"
+CONNECTIVITY_VERSION = 1
+
+EDGE_DTYPE = np.dtype([("source", "<u8"), ("target", "<u8"), ("synaptic_parameter", "<f8"), ("delay", "<f8")])
+
+
+def write_connectivity(file_name, sources, targets, synaptic_parameters=np.nan, delays=np.nan):
+    """Write a connectivity file. Scalar values are used for all connections."""
+    sources = np.asarray(sources)
+    edges = np.empty(len(sources), dtype=EDGE_DTYPE)
+    edges["source"] = sources
+    edges["target"] = targets
+    edges["synaptic_parameter"] = synaptic_parameters
+    edges["delay"] = delays
+
+    header = CONNECTIVITY_MAGIC + struct.pack("<IIQ", CONNECTIVITY_VERSION, EDGE_DTYPE.itemsize, len(edges))
+    with open(file_name, "wb") as f:
+        f.write(header.ljust(64, b"\0"))
+        edges.tofile(f)
+
+
+def read_connectivity(file_name):
+    """Return the records of a connectivity file as a numpy structured array."""
+    with open(file_name, "rb") as f:
+        header = f.read(64)
+    if header[0:8] != CONNECTIVITY_MAGIC:
+        raise RuntimeError("'%s' is not a SPORE connectivity file" % file_name)
+    version, record_size, count = struct.unpack_from("<IIQ", header, 8)
+    if version != CONNECTIVITY_VERSION or record_size != EDGE_DTYPE.itemsize:
+        raise RuntimeError("'%s' has an unsupported format version %d" % (file_name, version))
+    if count == 0:
+        return np.zeros(0, dtype=EDGE_DTYPE)
+    return np.memmap(file_name, dtype=EDGE_DTYPE, mode="r", offset=64, shape=(count,))
+
+
+def load_connectivity(file_name, model="synaptic_sampling_rewardgradient_synapse"):
+    """Create all connections of a connectivity file. Returns the number of created connections."""
+    import nest
+    return nest.sli_func('LoadConnectivity', file_name, model)["created"]
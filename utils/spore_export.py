@@ -0,0 +1,172 @@
+#! /usr/bin/env python
+# -*- coding: utf-8 -*-
+
+#
+# This file is part of SPORE.
+#
+# Copyright (C) 2016, the SPORE team (see AUTHORS).
+#
+# SPORE is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# SPORE is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with SPORE.  If not, see <http://www.gnu.org/licenses/>.
+#
+# For more information see: https://github.com/IGITUGraz/spore-nest-module
+#
+
+
+"""
+Python helpers to read data exported by SPORE to shared memory.
+
+The SLI functions ExportRecorderData and ExportTraces write recorded
+synapse data and trace windows to a POSIX shared memory segment in a
+columnar layout (see shm_export.h). ShmExportReader maps such a segment
+and exposes its arrays as numpy arrays that share memory with the segment,
+so no per-element conversion takes place.
+
+export_recorder_data and export_traces run the export and return a reader
+for the new segment. The segment is unlinked right away; its memory is
+released when the last array that views it is deleted.
+"""
+
+import mmap
+import os
+import struct
+
+import numpy as np
+
+from spore_shm import _shm_path
+
+SHM_EXPORT_MAGIC = b"SPOREEXP"
+SHM_EXPORT_VERSION = 1
+SHM_EXPORT_HEADER_SIZE = 4096
+SHM_EXPORT_NAME_SIZE = 64
+
+SHM_EXPORT_RECORDER = 1
+SHM_EXPORT_TRACES = 2
+
+_HEADER = struct.Struct("<8sIIQQQddQ")
+
+
+class ShmExportReader(object):
+    """
+    Read-only view of a segment written by ExportRecorderData or ExportTraces.
+
+    Attributes:
+        kind: content of the segment (SHM_EXPORT_RECORDER or SHM_EXPORT_TRACES).
+        t0, dt: time of the first sample and sampling interval of traces [ms].
+        offsets: first sample of every row; row i spans offsets[i]:offsets[i+1].
+        row_ids: recorder port or GID of every row.
+        row_sub: trace id of every row (0 for recordings).
+        columns: dictionary of all columns, each of length offsets[-1].
+    """
+
+    def __init__(self, name):
+        self.name = name
+
+        fd = os.open(_shm_path(name), os.O_RDONLY)
+        try:
+            size = os.fstat(fd).st_size
+            self._mem = mmap.mmap(fd, size, mmap.MAP_SHARED, mmap.PROT_READ)
+        finally:
+            os.close(fd)
+
+        magic, version, self.kind, n_rows, n_samples, n_columns, self.t0, self.dt, _ = \
+            _HEADER.unpack_from(self._mem, 0)
+        if magic != SHM_EXPORT_MAGIC:
+            raise RuntimeError("shared memory segment '%s' is not a complete SPORE export" % name)
+        if version != SHM_EXPORT_VERSION:
+            raise RuntimeError("shared memory segment '%s' has an unsupported format version %d" % (name, version))
+
+        names = []
+        for i in range(n_columns):
+            offset = _HEADER.size + i * SHM_EXPORT_NAME_SIZE
+            names.append(self._mem[offset:offset + SHM_EXPORT_NAME_SIZE].rstrip(b"\0").decode("ascii"))
+
+        offset = SHM_EXPORT_HEADER_SIZE
+        self.offsets = np.frombuffer(self._mem, dtype="<u8", count=n_rows + 1, offset=offset)
+        offset += 8 * (n_rows + 1)
+        self.row_ids = np.frombuffer(self._mem, dtype="<u8", count=n_rows, offset=offset)
+        offset += 8 * n_rows
+        self.row_sub = np.frombuffer(self._mem, dtype="<u8", count=n_rows, offset=offset)
+        offset += 8 * n_rows
+
+        self.columns = {}
+        for column in names:
+            self.columns[column] = np.frombuffer(self._mem, dtype="<f8", count=n_samples, offset=offset)
+            offset += 8 * n_samples
+
+    def __len__(self):
+        return len(self.row_ids)
+
+    def row(self, i):
+        """Return a dictionary of views of all columns of row `i`."""
+        begin, end = int(self.offsets[i]), int(self.offsets[i + 1])
+        return dict((column, values[begin:end]) for column, values in self.columns.items())
+
+    def unlink(self):
+        """Remove the segment from the system. Mapped arrays stay valid."""
+        os.unlink(_shm_path(self.name))
+
+
+def recorder_rows(reader):
+    """
+    Collect the rows of a recorder export by recorder port.
+
+    Returns a dictionary that maps every recorder port to a dictionary with
+    the entries "recorder_times" and "<variable>" for every recorded
+    variable, in the format returned by nest.GetStatus. All entries are
+    views of the segment.
+    """
+    records = {}
+    for i in range(len(reader)):
+        entry = reader.row(i)
+        entry["recorder_times"] = entry.pop("time")
+        records[int(reader.row_ids[i])] = entry
+    return records
+
+
+def trace_rows(reader):
+    """
+    Collect the rows of a trace export by GID.
+
+    Returns a dictionary that maps every GID to a list of its traces, in
+    the format of the "trace" entry returned by nest.GetStatus. All traces
+    are views of the segment.
+    """
+    traces = {}
+    for i in range(len(reader)):
+        traces.setdefault(int(reader.row_ids[i]), []).append(reader.row(i)["trace"])
+    return traces
+
+
+def _shm_name(shm_name):
+    return shm_name if shm_name is not None else "/spore_export_%d" % os.getpid()
+
+
+def export_recorder_data(label="synaptic_sampling_rewardgradient", shm_name=None):
+    """Export all in-memory synapse recordings of `label` and return a ShmExportReader."""
+    import nest
+    shm_name = _shm_name(shm_name)
+    nest.sli_func("ExportRecorderData", label, shm_name)
+    reader = ShmExportReader(shm_name)
+    reader.unlink()
+    return reader
+
+
+def export_traces(gids, shm_name=None):
+    """Export the current traces of the given tracing nodes and return a ShmExportReader."""
+    import nest
+    shm_name = _shm_name(shm_name)
+    nest.sli_func("ExportTraces", [int(gid) for gid in gids], shm_name)
+    reader = ShmExportReader(shm_name)
+    reader.unlink()
+    return reader
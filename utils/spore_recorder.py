@@ -0,0 +1,133 @@
+#! /usr/bin/env python
+# -*- coding: utf-8 -*-
+
+#
+# This file is part of SPORE.
+#
+# Copyright (C) 2016, the SPORE team (see AUTHORS).
+#
+# SPORE is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# SPORE is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with SPORE.  If not, see <http://www.gnu.org/licenses/>.
+#
+# For more information see: https://github.com/IGITUGraz/spore-nest-module
+#
+
+"""
+Python helpers to read synapse recordings written with `recorder_stream`.
+
+Streamed recordings are stored in one file per thread and column, named
+"<data_prefix><label>-<thread>-<column>.dat" in the data path of the NEST
+kernel. See recorder_stream.h for a description of the file layout.
+
+open_recorder_stream maps the columns of one thread without copying them.
+load_recorder_stream collects the records of all threads by recorder port,
+in the format returned by nest.GetStatus for in-memory recordings.
+"""
+
+import glob
+import os
+import re
+import struct
+
+import numpy as np
+
+RECORDER_STREAM_MAGIC = b"SPOREREC"
+RECORDER_STREAM_VERSION = 1
+RECORDER_STREAM_HEADER_SIZE = 4096
+
+
+def _read_header(file_name):
+    with open(file_name, "rb") as f:
+        header = f.read(128)
+    if header[0:8] != RECORDER_STREAM_MAGIC:
+        raise RuntimeError("'%s' is not a SPORE recorder stream" % file_name)
+    version, item_size = struct.unpack_from("<II", header, 8)
+    if version != RECORDER_STREAM_VERSION:
+        raise RuntimeError("'%s' has an unsupported format version %d" % (file_name, version))
+    dtype = np.dtype(header[16:24].rstrip(b"\0").decode("ascii"))
+    count = struct.unpack_from("<Q", header, 24)[0]
+    name = header[32:128].rstrip(b"\0").decode("ascii")
+    assert dtype.itemsize == item_size
+    return name, dtype, count
+
+
+def _stream_prefix(data_path, data_prefix, label):
+    return os.path.join(data_path or ".", data_prefix + label)
+
+
+def recorder_stream_threads(data_path="", data_prefix="", label="synaptic_sampling_rewardgradient"):
+    """Return the ids of all threads that have written a stream."""
+    prefix = _stream_prefix(data_path, data_prefix, label)
+    pattern = re.compile(re.escape(prefix) + r"-(\d+)-port\.dat$")
+    threads = []
+    for file_name in glob.glob(prefix + "-*-port.dat"):
+        match = pattern.match(file_name)
+        if match:
+            threads.append(int(match.group(1)))
+    return sorted(threads)
+
+
+def open_recorder_stream(thread, data_path="", data_prefix="", label="synaptic_sampling_rewardgradient"):
+    """
+    Map all columns written by the given thread.
+
+    Returns a dictionary of read-only numpy arrays that share memory with
+    the files. All arrays have the length of the number of complete
+    records at the time of the call.
+    """
+    prefix = "%s-%d-" % (_stream_prefix(data_path, data_prefix, label), thread)
+    columns = {}
+    count = None
+    for file_name in glob.glob(prefix + "*.dat"):
+        name, dtype, n = _read_header(file_name)
+        columns[name] = (file_name, dtype)
+        count = n if count is None else min(count, n)
+
+    if "port" not in columns:
+        raise RuntimeError("no recorder stream found for thread %d at '%s'" % (thread, prefix))
+
+    arrays = {}
+    for name, (file_name, dtype) in columns.items():
+        if count == 0:
+            arrays[name] = np.zeros(0, dtype=dtype)
+        else:
+            arrays[name] = np.memmap(file_name, dtype=dtype, mode="r",
+                                     offset=RECORDER_STREAM_HEADER_SIZE, shape=(count,))
+    return arrays
+
+
+def load_recorder_stream(data_path="", data_prefix="", label="synaptic_sampling_rewardgradient"):
+    """
+    Collect the records of all threads by recorder port.
+
+    Returns a dictionary that maps every recorder port to a dictionary with
+    the entries "recorder_times" and "<variable>" for every recorded
+    variable, sorted by time.
+    """
+    records = {}
+    for thread in recorder_stream_threads(data_path, data_prefix, label):
+        arrays = open_recorder_stream(thread, data_path, data_prefix, label)
+        ports = arrays.pop("port")
+        times = arrays.pop("time")
+        order = np.lexsort((times, ports))
+        sorted_ports = np.asarray(ports[order])
+        bounds = np.flatnonzero(np.diff(sorted_ports)) + 1
+        for segment in np.split(np.arange(len(order)), bounds):
+            if len(segment) == 0:
+                continue
+            index = order[segment]
+            entry = {"recorder_times": np.asarray(times[index])}
+            for name, values in arrays.items():
+                entry[name] = np.asarray(values[index])
+            records[int(sorted_ports[segment[0]])] = entry
+    return records
@@ -0,0 +1,168 @@
+#! /usr/bin/env python
+# -*- coding: utf-8 -*-
+
+#
+# This file is part of SPORE.
+#
+# Copyright (C) 2016, the SPORE team (see AUTHORS).
+#
+# SPORE is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# SPORE is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with SPORE.  If not, see <http://www.gnu.org/licenses/>.
+#
+# For more information see: https://github.com/IGITUGraz/spore-nest-module
+#
+
+"""
+Python helpers for the shared memory interfaces of SPORE.
+
+RewardShmWriter is the reference producer for the reward_shm_proxy node. It
+appends (step, values) entries to the lock-free ring buffer that is read by
+the proxy. See reward_shm_proxy.h for a description of the memory layout.
+"""
+
+import errno
+import mmap
+import os
+import struct
+import time
+
+SHM_DIR = "/dev/shm"
+
+REWARD_SHM_MAGIC = b"SPORESHM"
+REWARD_SHM_VERSION = 1
+REWARD_SHM_HEADER_SIZE = 192
+REWARD_SHM_WRITE_INDEX = 64
+REWARD_SHM_READ_INDEX = 128
+ATTACH_ATTEMPTS = 1000  # attempts to attach to a segment that is being created, one per ms
+
+
+def _shm_path(name):
+    if not name.startswith("/"):
+        raise ValueError("shared memory names must start with '/'")
+    return os.path.join(SHM_DIR, name[1:])
+
+
+class RewardShmWriter(object):
+    """
+    Single producer for the ring buffer of a reward_shm_proxy.
+
+    The segment is created if it does not exist yet, otherwise the existing
+    segment (e.g. created by NEST) is attached. Entries become active in the
+    simulation at the given step and must be written in non-decreasing order
+    of steps.
+    """
+
+    def __init__(self, name="/spore_reward", n_channels=1, buffer_size=1024):
+        self.name = name
+        self.n_channels = n_channels
+        self.entry_size = 8 * (1 + n_channels)
+        self._entry = struct.Struct("<q%dd" % n_channels)
+
+        fd, created = self._open(_shm_path(name))
+        try:
+            size = os.fstat(fd).st_size
+            if created:
+                size = REWARD_SHM_HEADER_SIZE + buffer_size * self.entry_size
+                os.ftruncate(fd, size)
+            else:
+                # wait until the creator has sized the segment
+                for _ in range(ATTACH_ATTEMPTS):
+                    if size > 0:
+                        break
+                    time.sleep(0.001)
+                    size = os.fstat(fd).st_size
+                if size == 0:
+                    raise RuntimeError("shared memory segment '%s' was not initialized by its creator" % name)
+            self._mem = mmap.mmap(fd, size, mmap.MAP_SHARED, mmap.PROT_READ | mmap.PROT_WRITE)
+        finally:
+            os.close(fd)
+
+        if not created:
+            # the creator publishes the header by writing the magic number last
+            for _ in range(ATTACH_ATTEMPTS):
+                if self._mem[0:8] == REWARD_SHM_MAGIC:
+                    break
+                time.sleep(0.001)
+
+        if created:
+            struct.pack_into("<IIQQ", self._mem, 8, REWARD_SHM_VERSION, n_channels,
+                             buffer_size, self.entry_size)
+            struct.pack_into("<Q", self._mem, REWARD_SHM_WRITE_INDEX, 0)
+            struct.pack_into("<Q", self._mem, REWARD_SHM_READ_INDEX, 0)
+            self._mem[0:8] = REWARD_SHM_MAGIC
+        elif self._mem[0:8] != REWARD_SHM_MAGIC:
+            raise RuntimeError("shared memory segment '%s' is not a SPORE reward buffer" % name)
+
+        version, channels, self.capacity, entry_size = struct.unpack_from("<IIQQ", self._mem, 8)
+        if version != REWARD_SHM_VERSION or channels != n_channels or entry_size != self.entry_size:
+            raise RuntimeError("shared memory segment '%s' has an incompatible layout" % name)
+
+    @staticmethod
+    def _open(path):
+        """
+        Create the segment exclusively, such that only its creator sizes and
+        initializes it, or open it if it exists. Return the file descriptor
+        and whether the segment was created.
+        """
+        for _ in range(ATTACH_ATTEMPTS):
+            try:
+                return os.open(path, os.O_RDWR | os.O_CREAT | os.O_EXCL, 0o600), True
+            except OSError as e:
+                if e.errno != errno.EEXIST:
+                    raise
+            try:
+                return os.open(path, os.O_RDWR), False
+            except OSError as e:
+                # the segment was removed in between
+                if e.errno != errno.ENOENT:
+                    raise
+        raise RuntimeError("can not open shared memory segment '%s'" % path)
+
+    def _read_index(self):
+        return struct.unpack_from("<Q", self._mem, REWARD_SHM_READ_INDEX)[0]
+
+    def _write_index(self):
+        return struct.unpack_from("<Q", self._mem, REWARD_SHM_WRITE_INDEX)[0]
+
+    def free_slots(self):
+        """Return the number of entries that can be written without blocking."""
+        return self.capacity - (self._write_index() - self._read_index())
+
+    def write(self, step, values, timeout=None):
+        """
+        Append an entry that becomes active at simulation step `step`.
+
+        Blocks while the ring buffer is full. Raises RuntimeError if the
+        consumer did not free a slot within `timeout` seconds.
+        """
+        if self.n_channels == 1 and not hasattr(values, "__len__"):
+            values = (values,)
+
+        start = time.time()
+        while self.free_slots() == 0:
+            if timeout is not None and time.time() - start > timeout:
+                raise RuntimeError("reward ring buffer '%s' is full" % self.name)
+            time.sleep(1e-5)
+
+        write_index = self._write_index()
+        offset = REWARD_SHM_HEADER_SIZE + (write_index % self.capacity) * self.entry_size
+        self._entry.pack_into(self._mem, offset, int(step), *values)
+        # publish the entry; stores are not reordered on x86, other platforms
+        # may require the entry to be flushed first.
+        struct.pack_into("<Q", self._mem, REWARD_SHM_WRITE_INDEX, write_index + 1)
+
+    def close(self, unlink=False):
+        """Unmap the segment and optionally remove it from the system."""
+        self._mem.close()
+        if unlink:
+            os.unlink(_shm_path(self.name))